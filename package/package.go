@@ -37,8 +37,27 @@ func GetPackage() *denv.Package {
 	maintest.AddDependencies(cunittestpkg.GetMainLib())
 	maintest.AddDependency(testlib)
 
+	// unittest project with CKALMAN_TELEMETRY, library and tests are compiled with the define since it
+	// changes the layout of rd03d_t
+	telemetrytestlib := denv.SetupCppTestLibProject(mainpkg, name+"_telemetry")
+	telemetrytestlib.AddDefine("CKALMAN_TELEMETRY")
+	telemetrytestlib.AddDependencies(ccorepkg.GetTestLib())
+	telemetrytestlib.AddDependencies(cunittestpkg.GetTestLib())
+
+	telemetrytest := denv.SetupCppTestProject(mainpkg, name+"_telemetry")
+	telemetrytest.AddDefine("CKALMAN_TELEMETRY")
+	telemetrytest.AddDependencies(cunittestpkg.GetMainLib())
+	telemetrytest.AddDependency(telemetrytestlib)
+
+	// benchmark application
+	benchapp := denv.SetupCppAppProject(mainpkg, name+"_bench", "bench")
+	benchapp.AddDependencies(ccorepkg.GetMainLib())
+	benchapp.AddDependency(mainlib)
+
 	mainpkg.AddMainLib(mainlib)
 	mainpkg.AddTestLib(testlib)
 	mainpkg.AddUnittest(maintest)
+	mainpkg.AddUnittest(telemetrytest)
+	mainpkg.AddMainApp(benchapp)
 	return mainpkg
 }
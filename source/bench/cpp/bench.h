@@ -0,0 +1,109 @@
+#ifndef __C_KALMAN_BENCH_H__
+#define __C_KALMAN_BENCH_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include <chrono>
+#include <stdio.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>
+#    define CKALMAN_BENCH_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <x86intrin.h>
+#    define CKALMAN_BENCH_RDTSC
+#endif
+
+namespace ncore
+{
+    namespace nbench
+    {
+        // Wall-clock timer in nanoseconds
+        struct timer_t
+        {
+            std::chrono::steady_clock::time_point m_start;
+
+            void start() { m_start = std::chrono::steady_clock::now(); }
+            f64  elapsed_ns() const { return (f64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count(); }
+        };
+
+        // Time stamp counter, 0 on targets without one
+        static inline u64 cycles()
+        {
+#if defined(CKALMAN_BENCH_RDTSC)
+            return (u64)__rdtsc();
+#else
+            return 0;
+#endif
+        }
+
+        // Keeps the optimizer from discarding a computed value
+        template <typename T>
+        static inline void do_not_optimize(const T& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __asm__ __volatile__("" : : "g"(&value) : "memory");
+#else
+            volatile const T* sink = &value;
+            (void)sink;
+#endif
+        }
+
+        // Machine-readable results: when a JSON file is open (ckalman_bench --json <file>) every report
+        // below also appends an entry { name, n, m, unit, ns, cycles, per_second } to it.
+        // n and m are 0 for results that are not part of a dimension sweep, cycles is null without a TSC.
+        bool json_open(const char* path);
+        void json_close();
+        void json_result(const char* name, i32 n, i32 m, const char* unit, f64 nsPerItem, f64 cyclesPerItem);
+
+        static inline void report(const char* name, f64 items, f64 ns, const char* unit)
+        {
+            const f64 perSecond = (ns > 0.0) ? (items * 1.0e9 / ns) : 0.0;
+            printf("%-48s %12.2f ns/%s %16.0f %s/s\n", name, ns / items, unit, perSecond, unit);
+            json_result(name, 0, 0, unit, ns / items, 0.0);
+        }
+
+        static inline void report_cycles(const char* name, f64 items, f64 ns, u64 cycles)
+        {
+            printf("%-48s %12.2f ns/update %10.1f cycles/update\n", name, ns / items, (f64)cycles / items);
+            json_result(name, 0, 0, "update", ns / items, (f64)cycles / items);
+        }
+
+        // Result of a dimension sweep, N = state and M = measurement dimension (0 when not applicable)
+        static inline void report_sweep(const char* name, i32 n, i32 m, f64 items, f64 ns, u64 cycles, const char* unit)
+        {
+            printf("%-28s N=%2d M=%2d %12.2f ns/%s %10.1f cycles/%s\n", name, n, m, ns / items, unit, (f64)cycles / items, unit);
+            json_result(name, n, m, unit, ns / items, (f64)cycles / items);
+        }
+
+        void bench_kalman_bank();
+        void bench_kalman_fused();
+        void bench_kalman_packed();
+        void bench_kalman_solve();
+        void bench_kalman_steady();
+        void bench_kalman_1d_array();
+        void bench_kalman_fixed();
+        void bench_kalman_predict();
+        void bench_rd03d_parser();
+        void bench_rd03d_log();
+        void bench_kalman_telemetry();
+        void bench_kalman_async();
+        void bench_kalman_smoother();
+        void bench_kalman_info();
+        void bench_kalman_sqrt();
+        void bench_kalman_model();
+        void bench_kalman_expr();
+        void bench_rd03d_pipeline();
+        void bench_kalman_tracker();
+        void bench_rd03d_fleet();
+        void bench_rd03d_polar();
+        void bench_kalman_ekf();
+        void bench_rd03d_zones();
+        void bench_sweep();
+
+    }  // namespace nbench
+}  // namespace ncore
+
+#endif  // __C_KALMAN_BENCH_H__
@@ -0,0 +1,79 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_1d_array.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            ARRAY_CHANNELS = 32768,
+            ARRAY_TICKS    = 100
+        };
+
+        static f32 s_q[ARRAY_CHANNELS];
+        static f32 s_r[ARRAY_CHANNELS];
+        static f32 s_p[ARRAY_CHANNELS];
+        static f32 s_x[ARRAY_CHANNELS];
+        static f32 s_k[ARRAY_CHANNELS];
+        static u32 s_converged[ARRAY_CHANNELS];
+        static f32 s_z[ARRAY_CHANNELS];
+
+        static nkalman::kalman_1D_t s_filters[ARRAY_CHANNELS];
+
+        static void fill_measurements(i32 tick)
+        {
+            for (i32 i = 0; i < ARRAY_CHANNELS; ++i)
+                s_z[i] = (f32)((i + tick) & 31) * 0.1f;
+        }
+
+        void bench_kalman_1d_array()
+        {
+            for (i32 i = 0; i < ARRAY_CHANNELS; ++i)
+                nkalman::initialize(s_filters[i]);
+
+            nkalman::kalman_1d_array_t arr;
+            nkalman::setup(arr, s_q, s_r, s_p, s_x, s_k, s_converged, ARRAY_CHANNELS);
+
+            timer_t timer;
+            f64     ns = 0.0;
+            for (i32 t = 0; t < ARRAY_TICKS; ++t)
+            {
+                fill_measurements(t);
+                timer.start();
+                for (i32 i = 0; i < ARRAY_CHANNELS; ++i)
+                    nkalman::update(s_filters[i], s_z[i]);
+                ns += timer.elapsed_ns();
+            }
+            do_not_optimize(s_filters);
+            report("kalman_1D_t update loop", (f64)ARRAY_CHANNELS * ARRAY_TICKS, ns, "channel");
+
+            nkalman::initialize(arr);
+            ns = 0.0;
+            for (i32 t = 0; t < ARRAY_TICKS; ++t)
+            {
+                fill_measurements(t);
+                timer.start();
+                nkalman::update(arr, s_z);
+                ns += timer.elapsed_ns();
+            }
+            do_not_optimize(s_x);
+            report("kalman_1d_array_t update", (f64)ARRAY_CHANNELS * ARRAY_TICKS, ns, "channel");
+
+            nkalman::initialize(arr);
+            ns = 0.0;
+            for (i32 t = 0; t < ARRAY_TICKS; ++t)
+            {
+                fill_measurements(t);
+                timer.start();
+                nkalman::update_converging(arr, s_z, 1e-6f);
+                ns += timer.elapsed_ns();
+            }
+            do_not_optimize(s_x);
+            report("kalman_1d_array_t update_converging", (f64)ARRAY_CHANNELS * ARRAY_TICKS, ns, "channel");
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,87 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_async.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            ASYNC_ITERATIONS = 100000
+        };
+
+        typedef nkalman::kalman_async_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, 16> bench_async_t;
+
+        static void setup_async(bench_async_t& af)
+        {
+            nkalman::initialize(af, 0.05f);
+            nkalman::model_constant_velocity_t::set_dt(af.m_filter.F, 0.05f);
+            af.m_filter.H.clear();
+            af.m_filter.H.data[0][0] = 1.0f;
+            af.m_filter.H.data[1][1] = 1.0f;
+            af.m_filter.R.data[0][0] = 0.25f;
+            af.m_filter.R.data[1][1] = 0.15f;
+            const f32 initial[4]     = {0.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(af, 0, initial, 5.0f);
+        }
+
+        // Cost of a timestamped measurement in sequence (jittered intervals) and of a measurement that
+        // arrives 1, 4 or 15 measurements late (re-applies that many history entries)
+        void bench_kalman_async()
+        {
+            bench_async_t af;
+            setup_async(af);
+
+            timer_t timer;
+            timer.start();
+            u64 c0   = cycles();
+            u64 time = 0;
+            for (i32 i = 0; i < ASYNC_ITERATIONS; ++i)
+            {
+                time += 40000 + (u64)((i * 7919) % 20000);
+                const f32 z[2] = {(f32)(i & 15) * 0.01f, 2.0f};
+                nkalman::update(af, time, z);
+            }
+            u64 c1 = cycles();
+            do_not_optimize(af);
+            report_cycles("async update in sequence (jittered)", (f64)ASYNC_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+
+            const i32 lags[3] = {1, 4, 15};
+            for (i32 l = 0; l < 3; ++l)
+            {
+                const i32 lag = lags[l];
+                setup_async(af);
+
+                // Every measurement is delivered after the next 'lag' ones have been applied
+                const i32 iterations = ASYNC_ITERATIONS / (lag + 1);
+                timer.start();
+                c0   = cycles();
+                time = 0;
+                for (i32 i = 0; i < iterations; ++i)
+                {
+                    time += 50000 * (u64)(lag + 1);
+                    for (i32 k = 1; k <= lag; ++k)
+                    {
+                        const f32 z[2] = {(f32)k * 0.01f, 2.0f};
+                        nkalman::update(af, time + (u64)k * 50000, z);
+                    }
+                    const f32 z[2] = {0.0f, 2.0f};
+                    nkalman::update(af, time, z);
+                    time += (u64)lag * 50000;
+                }
+                c1 = cycles();
+                do_not_optimize(af);
+
+                char name[64];
+                snprintf(name, sizeof(name), "async update, 1 in %d out of sequence (lag %d)", lag + 1, lag);
+                report_cycles(name, (f64)(iterations * (lag + 1)), timer.elapsed_ns(), c1 - c0);
+            }
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,111 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_bank.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            BANK_FILTERS = 1024,
+            BANK_LANES   = 64,
+            BANK_COUNT   = BANK_FILTERS / BANK_LANES,
+            BANK_FRAMES  = 200
+        };
+
+        static void setup_cv_filter(nkalman::kalman_nd_t<4, 2>& kf, f32 dt)
+        {
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.F.data[0][2] = dt;
+            kf.F.data[1][3] = dt;
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.H.data[1][1] = 1.0f;
+            kf.Q.data[0][0] = 0.01f;
+            kf.Q.data[1][1] = 0.01f;
+            kf.Q.data[2][2] = 0.10f;
+            kf.Q.data[3][3] = 0.10f;
+            kf.R.data[0][0] = 0.25f;
+            kf.R.data[1][1] = 0.15f;
+        }
+
+        static f32 measurement(i32 filter, i32 frame, i32 axis) { return (f32)((filter * 7 + frame * 3 + axis * 5) % 17) * 0.1f; }
+
+        void bench_kalman_bank()
+        {
+            static nkalman::kalman_nd_t<4, 2>              filters[BANK_FILTERS];
+            static nkalman::kalman_bank_t<4, 2, BANK_LANES> banks[BANK_COUNT];
+
+            const f32 initial[4] = {1.0f, 1.0f, 0.0f, 0.0f};
+            for (i32 i = 0; i < BANK_FILTERS; ++i)
+            {
+                setup_cv_filter(filters[i], 0.05f);
+                nkalman::begin(filters[i], initial, 5.0f);
+            }
+            for (i32 b = 0; b < BANK_COUNT; ++b)
+            {
+                nkalman::initialize(banks[b]);
+                for (i32 l = 0; l < BANK_LANES; ++l)
+                {
+                    nkalman::set_filter(banks[b], l, filters[b * BANK_LANES + l]);
+                    nkalman::set_active(banks[b], l, true);
+                }
+            }
+
+            timer_t timer;
+
+            // Baseline: one kalman_nd_t at a time
+            timer.start();
+            for (i32 f = 0; f < BANK_FRAMES; ++f)
+            {
+                for (i32 i = 0; i < BANK_FILTERS; ++i)
+                {
+                    const f32 z[2] = {measurement(i, f, 0), measurement(i, f, 1)};
+                    nkalman::update(filters[i], z);
+                }
+            }
+            do_not_optimize(filters);
+            report("kalman_nd_t<4,2> update (AoS)", (f64)BANK_FILTERS * BANK_FRAMES, timer.elapsed_ns(), "filter");
+
+            static f32 z[BANK_COUNT][2][BANK_LANES];
+
+            // Bank, scalar lane loop
+            timer.start();
+            for (i32 f = 0; f < BANK_FRAMES; ++f)
+            {
+                for (i32 b = 0; b < BANK_COUNT; ++b)
+                {
+                    for (i32 l = 0; l < BANK_LANES; ++l)
+                    {
+                        z[b][0][l] = measurement(b * BANK_LANES + l, f, 0);
+                        z[b][1][l] = measurement(b * BANK_LANES + l, f, 1);
+                    }
+                    nkalman::update_scalar(banks[b], z[b]);
+                }
+            }
+            do_not_optimize(banks);
+            report("kalman_bank_t<4,2,64> update (scalar)", (f64)BANK_FILTERS * BANK_FRAMES, timer.elapsed_ns(), "filter");
+
+            // Bank, widest SIMD path available
+            timer.start();
+            for (i32 f = 0; f < BANK_FRAMES; ++f)
+            {
+                for (i32 b = 0; b < BANK_COUNT; ++b)
+                {
+                    for (i32 l = 0; l < BANK_LANES; ++l)
+                    {
+                        z[b][0][l] = measurement(b * BANK_LANES + l, f, 0);
+                        z[b][1][l] = measurement(b * BANK_LANES + l, f, 1);
+                    }
+                    nkalman::update(banks[b], z[b]);
+                }
+            }
+            do_not_optimize(banks);
+            report("kalman_bank_t<4,2,64> update (simd)", (f64)BANK_FILTERS * BANK_FRAMES, timer.elapsed_ns(), "filter");
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
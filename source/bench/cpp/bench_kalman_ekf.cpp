@@ -0,0 +1,80 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_ekf.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            EKF_UPDATES = 200000
+        };
+
+        // The polar measurement as a user supplied function with a dense Jacobian
+        struct ekf_polar_dense_t : nkalman::model_dense_t
+        {
+            static inline void linearize(const nkalman::matrix_t<4, 1>& x, nkalman::matrix_t<2, 1>& h, nkalman::matrix_t<2, 4>& H)
+            {
+                const f32 px = x.data[0][0];
+                const f32 py = x.data[1][0];
+                const f32 r2 = px * px + py * py;
+                const f32 r  = sqrtf(r2);
+                h.data[0][0] = r;
+                h.data[1][0] = atan2f(px, py) * 57.2957795f;
+                H.clear();
+                H.data[0][0] = px / r;
+                H.data[0][1] = py / r;
+                H.data[1][0] = 57.2957795f * py / r2;
+                H.data[1][1] = -57.2957795f * px / r2;
+            }
+
+            static inline void residual(nkalman::matrix_t<2, 1>&) {}
+        };
+
+        template <typename UPDATE>
+        static void run_ekf_updates(const char* name, nkalman::rd03d_measurement_t measurement, UPDATE fn)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd, 0.05f, 10, measurement);
+            nkalman::rd03d_filter_t& kf = rd.m_roomFilters[0];
+
+            const f32 initial[nkalman::STATE_DIM] = {1.0f, 4.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+
+            // A target at (1, 4) m, as positions or as distance and angle
+            const bool polar = measurement == nkalman::RD03D_MEASURE_POLAR;
+            timer_t    timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < EKF_UPDATES; ++i)
+            {
+                const f32 a                       = (f32)(i & 15) * 0.01f;
+                const f32 b                       = (f32)(i & 7) * 0.01f;
+                const f32 z[nkalman::MEASURE_DIM] = {polar ? 4.12f + a : 1.0f + a, polar ? 14.0f - 10.0f * b : 4.0f - b};
+                fn(kf, z);
+            }
+            const u64 c1 = cycles();
+            const f64 ns = timer.elapsed_ns();
+            do_not_optimize(kf);
+            report_cycles(name, (f64)EKF_UPDATES, ns, c1 - c0);
+        }
+
+        static void linear_update(nkalman::rd03d_filter_t& kf, const f32* z) { nkalman::update(kf, z); }
+        static void polar_update(nkalman::rd03d_filter_t& kf, const f32* z) { nkalman::update_ekf<nkalman::rd03d_polar_t>(kf, z); }
+        static void dense_update(nkalman::rd03d_filter_t& kf, const f32* z) { nkalman::update_ekf<ekf_polar_dense_t>(kf, z); }
+
+        // Extended (range/angle) against linear (x/y) update of the rd03d track filter
+        void bench_kalman_ekf()
+        {
+            run_ekf_updates("rd03d 4x2 update (linear, select H)", nkalman::RD03D_MEASURE_CARTESIAN, linear_update);
+            run_ekf_updates("rd03d 4x2 update_ekf (polar)", nkalman::RD03D_MEASURE_POLAR, polar_update);
+            run_ekf_updates("rd03d 4x2 update_ekf (polar, dense H)", nkalman::RD03D_MEASURE_POLAR, dense_update);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,92 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_expr.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            EXPR_ITERATIONS = 200000
+        };
+
+        struct expr_model_t
+        {
+            nkalman::matrix_t<6, 6> F;  // constant acceleration in 2D: [x, y, vx, vy, ax, ay]
+            nkalman::matrix_t<6, 6> P;
+            nkalman::matrix_t<6, 2> G;  // noise gain of the jerk
+            nkalman::matrix_t<2, 2> q;  // jerk covariance
+        };
+
+        static void setup_model(expr_model_t& m, f32 dt)
+        {
+            m.F.setIdentity();
+            m.G.clear();
+            for (i32 a = 0; a < 2; ++a)
+            {
+                m.F.data[a][a + 2]     = dt;
+                m.F.data[a][a + 4]     = 0.5f * dt * dt;
+                m.F.data[a + 2][a + 4] = dt;
+                m.G.data[a][a]         = dt * dt * dt / 6.0f;
+                m.G.data[a + 2][a]     = 0.5f * dt * dt;
+                m.G.data[a + 4][a]     = dt;
+            }
+            m.q.setIdentity();
+            m.q.data[0][1] = m.q.data[1][0] = 0.2f;
+            m.P.setIdentity();
+        }
+
+        // User-written time update P = F P F^T + G q G^T in the method API, a named temporary per step
+        static void predict_methods(expr_model_t& m)
+        {
+            nkalman::matrix_t<6, 6> FP, Ft, FPFt, GqGt;
+            nkalman::matrix_t<6, 2> Gq;
+            nkalman::matrix_t<2, 6> Gt;
+            m.F.multiply(m.P, FP);
+            m.F.transpose(Ft);
+            FP.multiply(Ft, FPFt);
+            m.G.multiply(m.q, Gq);
+            m.G.transpose(Gt);
+            Gq.multiply(Gt, GqGt);
+            FPFt.add(GqGt, m.P);
+        }
+
+        // The same with expressions: only F P and G q are evaluated, the rest in one loop into P
+        static void predict_expressions(expr_model_t& m) { m.P = m.F * nkalman::symmetric(m.P) * nkalman::transposed(m.F) + m.G * nkalman::symmetric(m.q) * nkalman::transposed(m.G); }
+
+        template <typename FN>
+        static void run_predict(const char* name, FN fn)
+        {
+            expr_model_t m;
+            setup_model(m, 0.05f);
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < EXPR_ITERATIONS; ++i)
+            {
+                fn(m);
+                m.P.data[0][0] *= 0.5f;  // keep P bounded
+                do_not_optimize(m.P);
+            }
+            const u64 c1 = cycles();
+            report_cycles(name, (f64)EXPR_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+        }
+
+        void bench_kalman_expr()
+        {
+            run_predict("6x6 P = F P F^T + G q G^T (methods)", predict_methods);
+            run_predict("6x6 P = F P F^T + G q G^T (expressions)", predict_expressions);
+
+            // Stack held by the intermediate values of one time update
+            expr_model_t m;
+            setup_model(m, 0.05f);
+            const i32 methodBytes = (i32)(4 * sizeof(nkalman::matrix_t<6, 6>) + sizeof(nkalman::matrix_t<6, 2>) + sizeof(nkalman::matrix_t<2, 6>));
+            const i32 exprBytes   = (i32)sizeof(m.F * nkalman::symmetric(m.P) * nkalman::transposed(m.F) + m.G * nkalman::symmetric(m.q) * nkalman::transposed(m.G));
+            printf("%-48s %12d bytes (methods) %10d bytes (expressions)\n", "6x6 time update temporaries", methodBytes, exprBytes);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
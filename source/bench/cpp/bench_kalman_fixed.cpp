@@ -0,0 +1,86 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_fixed.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            FIXED_UPDATES = 200000
+        };
+
+        template <typename T>
+        static void bench_1d(const char* name)
+        {
+            nkalman::kalman_1D_of_t<T> kf;
+            nkalman::initialize(kf);
+            nkalman::begin(kf, T(20.0f));
+
+            T z[16];
+            for (i32 i = 0; i < 16; ++i)
+                z[i] = T(20.0f + (f32)i * 0.05f);
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < FIXED_UPDATES; ++i)
+                nkalman::update(kf, z[i & 15]);
+            const u64 c1 = cycles();
+            do_not_optimize(kf);
+            report_cycles(name, (f64)FIXED_UPDATES, timer.elapsed_ns(), c1 - c0);
+        }
+
+        template <typename FILTER>
+        static void load_filter(const nkalman::rd03d_filter_t& kf, FILTER& out)
+        {
+            nkalman::toFixed(kf, out);
+        }
+
+        static void load_filter(const nkalman::rd03d_filter_t& kf, nkalman::rd03d_filter_t& out) { out = kf; }
+
+        template <typename T>
+        static void bench_rd03d(const char* name)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            nkalman::rd03d_filter_t& kf         = rd.m_roomFilters[0];
+            const f32                initial[4] = {1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+
+            nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, T> kfx;
+            load_filter(kf, kfx);
+
+            T z[16][2];
+            for (i32 i = 0; i < 16; ++i)
+            {
+                z[i][0] = T(1.0f + (f32)i * 0.01f);
+                z[i][1] = T(2.0f - (f32)(i & 7) * 0.01f);
+            }
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < FIXED_UPDATES; ++i)
+                nkalman::update(kfx, z[i & 15]);
+            const u64 c1 = cycles();
+            do_not_optimize(kfx);
+            report_cycles(name, (f64)FIXED_UPDATES, timer.elapsed_ns(), c1 - c0);
+        }
+
+        void bench_kalman_fixed()
+        {
+            bench_1d<f32>("kalman_1D update (f32)");
+            bench_1d<nkalman::q16_16_t>("kalman_1D update (Q16.16)");
+            bench_1d<nkalman::q8_24_t>("kalman_1D update (Q8.24)");
+
+            bench_rd03d<f32>("rd03d 4x2 update (f32)");
+            bench_rd03d<nkalman::q16_16_t>("rd03d 4x2 update (Q16.16)");
+            bench_rd03d<nkalman::q8_24_t>("rd03d 4x2 update (Q8.24)");
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,59 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            FUSED_UPDATES = 200000
+        };
+
+        template <typename FILTER, typename UPDATE>
+        static void run_rd03d_updates(const char* name, UPDATE fn)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+
+            // Same model as the rd03d filter, with the F/H structure policy of FILTER
+            FILTER kf;
+            kf.F = rd.m_roomFilters[0].F;
+            kf.H = rd.m_roomFilters[0].H;
+            kf.Q = rd.m_roomFilters[0].Q;
+            kf.R = rd.m_roomFilters[0].R;
+
+            const f32 initial[nkalman::STATE_DIM] = {1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < FUSED_UPDATES; ++i)
+            {
+                const f32 z[nkalman::MEASURE_DIM] = {1.0f + (f32)(i & 15) * 0.01f, 2.0f - (f32)(i & 7) * 0.01f};
+                fn(kf, z);
+            }
+            const u64 c1 = cycles();
+            const f64 ns = timer.elapsed_ns();
+            do_not_optimize(kf);
+            report_cycles(name, (f64)FUSED_UPDATES, ns, c1 - c0);
+        }
+
+        typedef nkalman::kalman_nd_t<nkalman::STATE_DIM, nkalman::MEASURE_DIM> dense_filter_t;
+
+        static void generic_update(dense_filter_t& kf, const f32* z) { nkalman::update(kf, z); }
+        static void fused_update(dense_filter_t& kf, const f32* z) { nkalman::update_fused(kf, z); }
+        static void structured_update(nkalman::rd03d_filter_t& kf, const f32* z) { nkalman::update(kf, z); }
+
+        void bench_kalman_fused()
+        {
+            run_rd03d_updates<dense_filter_t>("rd03d 4x2 update (dense)", generic_update);
+            run_rd03d_updates<dense_filter_t>("rd03d 4x2 update_fused (dense)", fused_update);
+            run_rd03d_updates<nkalman::rd03d_filter_t>("rd03d 4x2 update (cv F, select H)", structured_update);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,99 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_info.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            INFO_TICKS       = 50000,
+            INFO_MAX_SENSORS = 16
+        };
+
+        // One tick of S sensors observing the same X/Y position: sequential covariance-form corrections
+        // (one gain per sensor) against information-form contributions folded in once
+        void bench_kalman_info()
+        {
+            typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > cov_filter_t;
+            typedef nkalman::kalman_info_t<4, nkalman::model_constant_velocity_t>                                  info_filter_t;
+
+            const f32 initial[4] = {0.0f, 2.0f, 0.0f, 0.0f};
+
+            nkalman::matrix_t<2, 2>      R[INFO_MAX_SENSORS];
+            nkalman::info_sensor_t<4, 2> sensors[INFO_MAX_SENSORS];
+
+            cov_filter_t base;
+            nkalman::initialize(base);
+            nkalman::model_constant_velocity_t::set_dt(base.F, 0.05f);
+            base.H.clear();
+            base.H.data[0][0] = 1.0f;
+            base.H.data[1][1] = 1.0f;
+            base.Q.data[2][2] = 0.1f;
+            base.Q.data[3][3] = 0.1f;
+            for (i32 s = 0; s < INFO_MAX_SENSORS; ++s)
+            {
+                R[s].clear();
+                R[s].data[0][0] = 0.25f + 0.01f * (f32)s;
+                R[s].data[1][1] = 0.15f + 0.01f * (f32)s;
+                nkalman::setup(sensors[s], base.H, R[s]);
+            }
+
+            const i32 counts[4] = {2, 4, 8, 16};
+            for (i32 c = 0; c < 4; ++c)
+            {
+                const i32 S = counts[c];
+                char      name[64];
+
+                cov_filter_t cov = base;
+                nkalman::begin(cov, initial, 5.0f);
+                timer_t timer;
+                timer.start();
+                u64 c0 = cycles();
+                for (i32 t = 0; t < INFO_TICKS; ++t)
+                {
+                    nkalman::predict(cov);
+                    for (i32 s = 0; s < S; ++s)
+                    {
+                        const f32 z[2] = {(f32)((t + s) & 15) * 0.01f, 2.0f};
+                        cov.R          = R[s];
+                        nkalman::correct(cov, z);
+                    }
+                }
+                u64 c1 = cycles();
+                do_not_optimize(cov);
+                snprintf(name, sizeof(name), "%2d sensors, covariance form (sequential)", S);
+                report_cycles(name, (f64)INFO_TICKS, timer.elapsed_ns(), c1 - c0);
+
+                info_filter_t info;
+                nkalman::initialize(info);
+                info.F = base.F;
+                info.Q = base.Q;
+                nkalman::begin(info, initial, 5.0f);
+                timer.start();
+                c0 = cycles();
+                for (i32 t = 0; t < INFO_TICKS; ++t)
+                {
+                    nkalman::predict(info);
+                    nkalman::info_contribution_t<4> sum;
+                    nkalman::clear(sum);
+                    for (i32 s = 0; s < S; ++s)
+                    {
+                        const f32 z[2] = {(f32)((t + s) & 15) * 0.01f, 2.0f};
+                        nkalman::contribute(sum, sensors[s], z);
+                    }
+                    nkalman::correct(info, sum);
+                }
+                c1 = cycles();
+                do_not_optimize(info);
+                snprintf(name, sizeof(name), "%2d sensors, information form", S);
+                report_cycles(name, (f64)INFO_TICKS, timer.elapsed_ns(), c1 - c0);
+            }
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,65 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_model.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            MODEL_TRACKS     = 64,
+            MODEL_ITERATIONS = 4000
+        };
+
+        static constexpr nkalman::rd03d_model_t s_rd03dModel = nkalman::rd03d_model(0.05f);
+
+        // 64 rd03d tracks: full filters with their own copy of the model against tracks (x, P, K)
+        // sharing one compile-time constant model
+        void bench_kalman_model()
+        {
+            static nkalman::rd03d_filter_t filters[MODEL_TRACKS];
+            static nkalman::rd03d_track_t  tracks[MODEL_TRACKS];
+            for (i32 t = 0; t < MODEL_TRACKS; ++t)
+            {
+                const f32 initial[nkalman::STATE_DIM] = {(f32)t * 0.1f, 2.0f, 0.0f, 0.0f};
+                nkalman::initialize(filters[t], s_rd03dModel);
+                nkalman::begin(filters[t], initial, 5.0f);
+                nkalman::initialize(tracks[t]);
+                nkalman::begin(tracks[t], initial, 5.0f);
+            }
+
+            timer_t timer;
+            timer.start();
+            u64 c0 = cycles();
+            for (i32 i = 0; i < MODEL_ITERATIONS; ++i)
+            {
+                for (i32 t = 0; t < MODEL_TRACKS; ++t)
+                {
+                    const f32 z[nkalman::MEASURE_DIM] = {(f32)t * 0.1f + (f32)(i & 15) * 0.01f, 2.0f};
+                    nkalman::update(filters[t], z);
+                }
+            }
+            u64 c1 = cycles();
+            do_not_optimize(filters);
+            report_cycles("rd03d x64, model per filter (288 B)", (f64)MODEL_ITERATIONS * MODEL_TRACKS, timer.elapsed_ns(), c1 - c0);
+
+            timer.start();
+            c0 = cycles();
+            for (i32 i = 0; i < MODEL_ITERATIONS; ++i)
+            {
+                for (i32 t = 0; t < MODEL_TRACKS; ++t)
+                {
+                    const f32 z[nkalman::MEASURE_DIM] = {(f32)t * 0.1f + (f32)(i & 15) * 0.01f, 2.0f};
+                    nkalman::update(s_rd03dModel, tracks[t], z);
+                }
+            }
+            c1 = cycles();
+            do_not_optimize(tracks);
+            report_cycles("rd03d x64, constexpr shared model (112 B)", (f64)MODEL_ITERATIONS * MODEL_TRACKS, timer.elapsed_ns(), c1 - c0);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
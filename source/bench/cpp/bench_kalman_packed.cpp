@@ -0,0 +1,63 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_packed.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            PACKED_TRACKS = 4096,
+            PACKED_FRAMES = 50
+        };
+
+        template <typename FILTER>
+        static void setup_cv(FILTER& kf)
+        {
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.F.data[0][2] = 0.05f;
+            kf.F.data[1][3] = 0.05f;
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.H.data[1][1] = 1.0f;
+            const f32 initial[4] = {1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+        }
+
+        template <typename FILTER>
+        static void run_tracks(const char* name, FILTER* tracks)
+        {
+            for (i32 i = 0; i < PACKED_TRACKS; ++i)
+                setup_cv(tracks[i]);
+
+            timer_t timer;
+            timer.start();
+            for (i32 f = 0; f < PACKED_FRAMES; ++f)
+            {
+                for (i32 i = 0; i < PACKED_TRACKS; ++i)
+                {
+                    const f32 z[2] = {1.0f + (f32)((i + f) & 15) * 0.01f, 2.0f - (f32)(f & 7) * 0.01f};
+                    nkalman::update(tracks[i], z);
+                }
+            }
+            const f64 ns = timer.elapsed_ns();
+            do_not_optimize(tracks[0]);
+
+            char label[96];
+            snprintf(label, sizeof(label), "%s (%d bytes/track)", name, (i32)sizeof(FILTER));
+            report(label, (f64)PACKED_TRACKS * PACKED_FRAMES, ns, "update");
+        }
+
+        void bench_kalman_packed()
+        {
+            static nkalman::kalman_nd_t<4, 2>     full[PACKED_TRACKS];
+            static nkalman::kalman_packed_t<4, 2> packed[PACKED_TRACKS];
+            run_tracks("kalman_nd_t<4,2> x4096", full);
+            run_tracks("kalman_packed_t<4,2> x4096", packed);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
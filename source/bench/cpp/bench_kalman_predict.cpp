@@ -0,0 +1,62 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            PREDICT_ITERATIONS = 100000
+        };
+
+        void bench_kalman_predict()
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            const f32 initial[4] = {1.0f, 2.0f, 0.5f, -0.5f};
+
+            const i32 steps[] = {2, 5, 10};
+            for (i32 s = 0; s < 3; ++s)
+            {
+                const i32 k = steps[s];
+                char      name[64];
+
+                nkalman::rd03d_filter_t kf = rd.m_roomFilters[0];
+                nkalman::begin(kf, initial, 5.0f);
+
+                timer_t timer;
+                timer.start();
+                u64 c0 = cycles();
+                for (i32 i = 0; i < PREDICT_ITERATIONS; ++i)
+                {
+                    kf.P.setIdentity();
+                    for (i32 j = 0; j < k; ++j)
+                        nkalman::predict(kf, 0.05f);
+                }
+                u64 c1 = cycles();
+                do_not_optimize(kf);
+                snprintf(name, sizeof(name), "rd03d coast %2d frames (%d x predict)", k, k);
+                report_cycles(name, (f64)PREDICT_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+
+                nkalman::begin(kf, initial, 5.0f);
+                timer.start();
+                c0 = cycles();
+                for (i32 i = 0; i < PREDICT_ITERATIONS; ++i)
+                {
+                    kf.P.setIdentity();
+                    nkalman::predict(kf, 0.05f, k);
+                }
+                c1 = cycles();
+                do_not_optimize(kf);
+                snprintf(name, sizeof(name), "rd03d coast %2d frames (closed form)", k);
+                report_cycles(name, (f64)PREDICT_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+            }
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
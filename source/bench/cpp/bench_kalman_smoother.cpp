@@ -0,0 +1,89 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_smoother.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            SMOOTHER_ITERATIONS = 100000,
+            SMOOTHER_BATCH      = 1000
+        };
+
+        template <typename FILTER>
+        static void setup_smoother_filter(FILTER& kf)
+        {
+            nkalman::initialize(kf);
+            nkalman::model_constant_velocity_t::set_dt(kf.F, 0.05f);
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.H.data[1][1] = 1.0f;
+            kf.Q.data[2][2] = 0.1f;
+            kf.Q.data[3][3] = 0.1f;
+            kf.R.data[0][0] = 0.25f;
+            kf.R.data[1][1] = 0.15f;
+            const f32 initial[4] = {0.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+        }
+
+        template <i32 LAG>
+        static void bench_fixed_lag()
+        {
+            nkalman::kalman_smoother_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, LAG> sm;
+            nkalman::initialize(sm);
+            setup_smoother_filter(sm.m_filter);
+
+            nkalman::matrix_t<4, 1> xs;
+            timer_t                 timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < SMOOTHER_ITERATIONS; ++i)
+            {
+                const f32 z[2] = {(f32)(i & 15) * 0.01f, 2.0f};
+                nkalman::update(sm, z, xs);
+            }
+            const u64 c1 = cycles();
+            do_not_optimize(xs);
+
+            char name[64];
+            snprintf(name, sizeof(name), "rd03d filter + fixed-lag smoother (lag %d)", LAG);
+            report_cycles(name, (f64)SMOOTHER_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+        }
+
+        void bench_kalman_smoother()
+        {
+            bench_fixed_lag<4>();
+            bench_fixed_lag<8>();
+            bench_fixed_lag<16>();
+
+            typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > filter_t;
+            filter_t kf;
+            setup_smoother_filter(kf);
+
+            static f32                     z[SMOOTHER_BATCH][2];
+            static nkalman::matrix_t<4, 1> xs[SMOOTHER_BATCH];
+            static nkalman::matrix_t<4, 4> Ps[SMOOTHER_BATCH];
+            for (i32 i = 0; i < SMOOTHER_BATCH; ++i)
+            {
+                z[i][0] = (f32)(i & 15) * 0.01f;
+                z[i][1] = 2.0f;
+            }
+
+            const i32 runs = SMOOTHER_ITERATIONS / SMOOTHER_BATCH;
+            timer_t   timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 r = 0; r < runs; ++r)
+                nkalman::smooth(kf, z, SMOOTHER_BATCH, xs, Ps);
+            const u64 c1 = cycles();
+            do_not_optimize(xs);
+            report_cycles("rd03d batch RTS smoother (x and P, per frame)", (f64)(runs * SMOOTHER_BATCH), timer.elapsed_ns(), c1 - c0);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
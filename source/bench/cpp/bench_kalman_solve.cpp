@@ -0,0 +1,140 @@
+#include "ckalman/c_kalman.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            SOLVE_N       = 8,
+            SOLVE_UPDATES = 20000
+        };
+
+        template <i32 M>
+        static void setup_solve_filter(nkalman::kalman_nd_t<SOLVE_N, M>& kf)
+        {
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            for (i32 i = 0; i < SOLVE_N / 2; ++i)
+                kf.F.data[i][i + SOLVE_N / 2] = 0.05f;
+            kf.H.clear();
+            for (i32 m = 0; m < M; ++m)
+                kf.H.data[m][m] = 1.0f;
+            for (i32 i = 0; i < SOLVE_N; ++i)
+                kf.Q.data[i][i] = 0.01f;
+            for (i32 m = 0; m < M; ++m)
+                kf.R.data[m][m] = 0.1f + 0.01f * (f32)m;
+
+            f32 initial[SOLVE_N];
+            for (i32 i = 0; i < SOLVE_N; ++i)
+                initial[i] = 0.0f;
+            nkalman::begin(kf, initial, 5.0f);
+        }
+
+        template <i32 M, typename UPDATE>
+        static f64 time_solve(UPDATE fn)
+        {
+            nkalman::kalman_nd_t<SOLVE_N, M> kf;
+            setup_solve_filter(kf);
+
+            f32 z[M];
+            timer_t timer;
+            timer.start();
+            for (i32 i = 0; i < SOLVE_UPDATES; ++i)
+            {
+                for (i32 m = 0; m < M; ++m)
+                    z[m] = (f32)((i + m) & 15) * 0.1f;
+                fn(kf, z);
+            }
+            const f64 ns = timer.elapsed_ns();
+            do_not_optimize(kf);
+            return ns / SOLVE_UPDATES;
+        }
+
+        template <i32 M>
+        static void update_inverse(nkalman::kalman_nd_t<SOLVE_N, M>& kf, const f32* z)
+        {
+            nkalman::update(kf, z);
+        }
+        template <i32 M>
+        static void update_fused_solve(nkalman::kalman_nd_t<SOLVE_N, M>& kf, const f32* z)
+        {
+            nkalman::update_fused(kf, z);
+        }
+        template <i32 M>
+        static void update_scalar(nkalman::kalman_nd_t<SOLVE_N, M>& kf, const f32* z)
+        {
+            nkalman::update_sequential(kf, z);
+        }
+
+        // K^T = S^-1 (H P_pred) alone, through LDL^T and through the pivoting inverse that update() falls
+        // back to when S is not positive definite
+        template <i32 M>
+        static void bench_gain_solve()
+        {
+            nkalman::kalman_nd_t<SOLVE_N, M> kf;
+            setup_solve_filter(kf);
+            nkalman::matrix_t<M, SOLVE_N> HP;
+            nkalman::matrix_t<SOLVE_N, M> Ht;
+            nkalman::matrix_t<M, M>       S;
+            kf.H.multiply(kf.P, HP);
+            kf.H.transpose(Ht);
+            HP.multiply(Ht, S);
+            S.add(kf.R, S);
+
+            nkalman::matrix_t<M, SOLVE_N> K_trans;
+            timer_t                       timer;
+            timer.start();
+            for (i32 i = 0; i < SOLVE_UPDATES; ++i)
+            {
+                S.data[0][0] += 1e-6f;
+                nkalman::matrix_t<M, M> LD;
+                S.decomposeLDLT(LD);
+                LD.solveLDLT(HP, K_trans);
+                do_not_optimize(K_trans);
+            }
+            const f64 ldlt = timer.elapsed_ns() / SOLVE_UPDATES;
+
+            timer.start();
+            for (i32 i = 0; i < SOLVE_UPDATES; ++i)
+            {
+                S.data[0][0] += 1e-6f;
+                nkalman::matrix_t<M, M> S_inv;
+                S.invert(S_inv);
+                S_inv.multiply(HP, K_trans);
+                do_not_optimize(K_trans);
+            }
+            const f64 inverse = timer.elapsed_ns() / SOLVE_UPDATES;
+            printf("N=%d M=%d %-22s %10.1f ns/solve\n", SOLVE_N, M, "gain (LDL^T)", ldlt);
+            printf("N=%d M=%d %-22s %10.1f ns/solve\n", SOLVE_N, M, "gain (invert fallback)", inverse);
+        }
+
+        template <i32 M>
+        static void bench_solve_m()
+        {
+            const f64 generic    = time_solve<M>(update_inverse<M>);
+            const f64 fused      = time_solve<M>(update_fused_solve<M>);
+            const f64 sequential = time_solve<M>(update_scalar<M>);
+            printf("N=%d M=%d %-22s %10.1f ns/update\n", SOLVE_N, M, (M <= 3) ? "update (invert)" : "update (LDL^T)", generic);
+            printf("N=%d M=%d %-22s %10.1f ns/update\n", SOLVE_N, M, "update_fused", fused);
+            printf("N=%d M=%d %-22s %10.1f ns/update\n", SOLVE_N, M, "update_sequential", sequential);
+            if (M > 3)
+                bench_gain_solve<M>();
+        }
+
+        void bench_kalman_solve()
+        {
+            bench_solve_m<1>();
+            bench_solve_m<2>();
+            bench_solve_m<3>();
+            bench_solve_m<4>();
+            bench_solve_m<5>();
+            bench_solve_m<6>();
+            bench_solve_m<7>();
+            bench_solve_m<8>();
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
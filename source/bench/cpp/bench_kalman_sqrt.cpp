@@ -0,0 +1,81 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_sqrt.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            SQRT_ITERATIONS = 200000
+        };
+
+        typedef nkalman::model_select_t<0, 1> sqrt_h_t;
+
+        // rd03d model in covariance form with scalar type T
+        template <typename T>
+        static void setup_filter(nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, sqrt_h_t, T>& kf)
+        {
+            nkalman::initialize(kf);
+            nkalman::model_constant_velocity_t::set_dt(kf.F, T(0.05f));
+            kf.H.clear();
+            kf.H.data[0][0] = T(1.0f);
+            kf.H.data[1][1] = T(1.0f);
+            kf.Q.data[0][0] = T(0.01f);
+            kf.Q.data[1][1] = T(0.01f);
+            kf.Q.data[2][2] = T(0.1f);
+            kf.Q.data[3][3] = T(0.1f);
+            kf.R.data[0][0] = T(0.25f);
+            kf.R.data[1][1] = T(0.15f);
+            const T initial[4] = {T(0.0f), T(2.0f), T(0.0f), T(0.0f)};
+            nkalman::begin(kf, initial, 5.0f);
+        }
+
+        template <typename T>
+        static void bench_covariance(const char* name)
+        {
+            nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, sqrt_h_t, T> kf;
+            setup_filter(kf);
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < SQRT_ITERATIONS; ++i)
+            {
+                const T z[2] = {T((f32)(i & 15) * 0.01f), T(2.0f)};
+                nkalman::update(kf, z);
+            }
+            const u64 c1 = cycles();
+            do_not_optimize(kf);
+            report_cycles(name, (f64)SQRT_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+        }
+
+        // rd03d model in covariance form (f32 and f64, the alternative to the square-root form) against the
+        // square-root form
+        void bench_kalman_sqrt()
+        {
+            bench_covariance<f32>("rd03d filter, covariance form");
+            bench_covariance<f64>("rd03d filter, covariance form (f64)");
+
+            nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, sqrt_h_t> kf;
+            setup_filter(kf);
+            nkalman::kalman_sqrt_t<4, 2, nkalman::model_constant_velocity_t, sqrt_h_t> sf;
+            nkalman::initialize(sf, kf);
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 i = 0; i < SQRT_ITERATIONS; ++i)
+            {
+                const f32 z[2] = {(f32)(i & 15) * 0.01f, 2.0f};
+                nkalman::update(sf, z);
+            }
+            const u64 c1 = cycles();
+            do_not_optimize(sf);
+            report_cycles("rd03d filter, square-root form", (f64)SQRT_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,57 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_steady.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            STEADY_UPDATES = 200000
+        };
+
+        void bench_kalman_steady()
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+
+            nkalman::rd03d_filter_t full       = rd.m_roomFilters[0];
+            const f32               initial[4] = {1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(full, initial, 5.0f);
+
+            nkalman::kalman_steady_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > ss;
+
+            timer_t timer;
+            timer.start();
+            nkalman::initialize(ss, full);
+            report("rd03d solve_steady_state", 1.0, timer.elapsed_ns(), "solve");
+            nkalman::begin(ss, initial);
+
+            timer.start();
+            u64 c0 = cycles();
+            for (i32 i = 0; i < STEADY_UPDATES; ++i)
+            {
+                const f32 z[2] = {1.0f + (f32)(i & 15) * 0.01f, 2.0f - (f32)(i & 7) * 0.01f};
+                nkalman::update(full, z);
+            }
+            u64 c1 = cycles();
+            do_not_optimize(full);
+            report_cycles("rd03d 4x2 update (full)", (f64)STEADY_UPDATES, timer.elapsed_ns(), c1 - c0);
+
+            timer.start();
+            c0 = cycles();
+            for (i32 i = 0; i < STEADY_UPDATES; ++i)
+            {
+                const f32 z[2] = {1.0f + (f32)(i & 15) * 0.01f, 2.0f - (f32)(i & 7) * 0.01f};
+                nkalman::update(ss, z);
+            }
+            c1 = cycles();
+            do_not_optimize(ss);
+            report_cycles("rd03d 4x2 update (steady-state gain)", (f64)STEADY_UPDATES, timer.elapsed_ns(), c1 - c0);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
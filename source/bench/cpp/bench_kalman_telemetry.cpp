@@ -0,0 +1,69 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_telemetry.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            TELEMETRY_ITERATIONS = 200000
+        };
+
+        // Build once with and once without CKALMAN_TELEMETRY to see the cost of the instrumentation,
+        // without it both rows must be the same.
+        void bench_kalman_telemetry()
+        {
+#if defined(CKALMAN_TELEMETRY)
+            const char* mode = "on";
+#else
+            const char* mode = "off";
+#endif
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            const f32 initial[4] = {1.0f, 2.0f, 0.0f, 0.0f};
+
+            nkalman::rd03d_filter_t kf = rd.m_roomFilters[0];
+            nkalman::begin(kf, initial, 5.0f);
+
+            char    name[64];
+            timer_t timer;
+            timer.start();
+            u64 c0 = cycles();
+            for (i32 i = 0; i < TELEMETRY_ITERATIONS; ++i)
+            {
+                const f32 z[2] = {1.0f + (f32)(i & 7) * 0.01f, 2.0f};
+                nkalman::update(kf, z);
+            }
+            u64 c1 = cycles();
+            do_not_optimize(kf);
+            report_cycles("rd03d filter update", (f64)TELEMETRY_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+
+            nkalman::telemetry_t telemetry;
+            nkalman::initialize(telemetry);
+            nkalman::begin(kf, initial, 5.0f);
+            timer.start();
+            c0 = cycles();
+            for (i32 i = 0; i < TELEMETRY_ITERATIONS; ++i)
+            {
+                const f32 z[2] = {1.0f + (f32)(i & 7) * 0.01f, 2.0f};
+                nkalman::update(kf, z, telemetry);
+            }
+            c1 = cycles();
+            do_not_optimize(kf);
+            snprintf(name, sizeof(name), "rd03d filter update (telemetry %s)", mode);
+            report_cycles(name, (f64)TELEMETRY_ITERATIONS, timer.elapsed_ns(), c1 - c0);
+
+#if defined(CKALMAN_TELEMETRY)
+            printf("    NIS mean %.3f variance %.3f, gain norm mean %.3f, latency p50 <= %llu ns p99 <= %llu ns\n", nkalman::getNisMean(telemetry), nkalman::getNisVariance(telemetry), nkalman::getGainNormMean(telemetry),
+                   (unsigned long long)nkalman::getLatencyPercentile(telemetry, 0.5), (unsigned long long)nkalman::getLatencyPercentile(telemetry, 0.99));
+#endif
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,89 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_tracker.h"
+
+#include "bench.h"
+
+#include <cmath>
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            TRACKER_CAPACITY = 1024,
+            TRACKER_FRAMES   = 40
+        };
+
+        typedef nkalman::tracker_t<TRACKER_CAPACITY> bench_tracker_t;
+
+        struct tracker_scene_t
+        {
+            f32 m_position[TRACKER_CAPACITY][2];
+            f32 m_velocity[TRACKER_CAPACITY][2];
+            f32 m_z[TRACKER_CAPACITY][2];
+            u32 m_ids[TRACKER_CAPACITY];
+            u32 m_rnd;
+        };
+
+        static f32 tracker_random(tracker_scene_t& scene)  // uniform in [-0.5, 0.5)
+        {
+            scene.m_rnd = scene.m_rnd * 1664525u + 1013904223u;
+            return (f32)(scene.m_rnd >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        }
+
+        // Walking targets at a constant density (one per 6.25 m^2), frames of 'targets' measurements
+        static void tracker_run(bench_tracker_t& tr, tracker_scene_t& scene, i32 targets, nkalman::tracker_solver_t solver, f32 cellSize, const char* name)
+        {
+            const f32 side = 2.5f * sqrtf((f32)targets);
+            scene.m_rnd    = 7;
+            for (i32 i = 0; i < targets; ++i)
+            {
+                scene.m_position[i][0] = side * tracker_random(scene);
+                scene.m_position[i][1] = side * tracker_random(scene);
+                scene.m_velocity[i][0] = 2.0f * tracker_random(scene);
+                scene.m_velocity[i][1] = 2.0f * tracker_random(scene);
+            }
+            nkalman::setup(tr, nkalman::rd03d_model(0.05f), solver, 9.21f, cellSize, 10, 0.5f);
+
+            f64 ns = 0.0;
+            for (i32 frame = 0; frame < TRACKER_FRAMES; ++frame)
+            {
+                for (i32 i = 0; i < targets; ++i)
+                {
+                    scene.m_position[i][0] += 0.05f * scene.m_velocity[i][0];
+                    scene.m_position[i][1] += 0.05f * scene.m_velocity[i][1];
+                    scene.m_z[i][0] = scene.m_position[i][0] + 0.1f * tracker_random(scene);
+                    scene.m_z[i][1] = scene.m_position[i][1] + 0.1f * tracker_random(scene);
+                }
+                timer_t timer;
+                timer.start();
+                nkalman::update(tr, scene.m_z, targets, scene.m_ids);
+                ns += timer.elapsed_ns();
+                do_not_optimize(scene.m_ids);
+            }
+
+            char label[64];
+            snprintf(label, sizeof(label), "tracker %s x%d", name, targets);
+            report(label, (f64)TRACKER_FRAMES * targets, ns, "target");
+        }
+
+        // Cost per target and frame of the multi-target tracker for growing scenes: the grid keeps it
+        // flat, brute force association (one cell for everything) grows with the number of targets
+        void bench_kalman_tracker()
+        {
+            static bench_tracker_t tr;
+            static tracker_scene_t scene;
+
+            const i32 targets[] = {16, 64, 256, 1024};
+            for (i32 t = 0; t < 4; ++t)
+            {
+                tracker_run(tr, scene, targets[t], nkalman::TRACKER_GREEDY, 1.0f, "greedy, grid");
+                tracker_run(tr, scene, targets[t], nkalman::TRACKER_AUCTION, 1.0f, "auction, grid");
+                tracker_run(tr, scene, targets[t], nkalman::TRACKER_GREEDY, 1.0e6f, "greedy, brute force");
+            }
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
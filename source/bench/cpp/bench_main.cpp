@@ -0,0 +1,107 @@
+#include "bench.h"
+
+#include <string.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        static FILE* s_json      = nullptr;
+        static bool  s_jsonFirst = true;
+
+        bool json_open(const char* path)
+        {
+            s_json = fopen(path, "w");
+            if (s_json == nullptr)
+                return false;
+            s_jsonFirst = true;
+            fprintf(s_json, "{\n  \"version\": 1,\n  \"results\": [");
+            return true;
+        }
+
+        void json_close()
+        {
+            if (s_json == nullptr)
+                return;
+            fprintf(s_json, "\n  ]\n}\n");
+            fclose(s_json);
+            s_json = nullptr;
+        }
+
+        void json_result(const char* name, i32 n, i32 m, const char* unit, f64 nsPerItem, f64 cyclesPerItem)
+        {
+            if (s_json == nullptr)
+                return;
+
+            fprintf(s_json, "%s\n    {\"name\": \"", s_jsonFirst ? "" : ",");
+            for (const char* c = name; *c != 0; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    fputc('\\', s_json);
+                fputc(*c, s_json);
+            }
+            fprintf(s_json, "\", \"n\": %d, \"m\": %d, \"unit\": \"%s\", \"ns\": %.3f, ", n, m, unit, nsPerItem);
+            if (cyclesPerItem > 0.0)
+                fprintf(s_json, "\"cycles\": %.2f, ", cyclesPerItem);
+            else
+                fprintf(s_json, "\"cycles\": null, ");
+            fprintf(s_json, "\"per_second\": %.1f}", (nsPerItem > 0.0) ? (1.0e9 / nsPerItem) : 0.0);
+            s_jsonFirst = false;
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
+
+// usage: ckalman_bench [--json <file>] [--sweep]
+//   --json <file>   also write every result to <file> as JSON
+//   --sweep         only run the N/M dimension sweep
+int main(int argc, char** argv)
+{
+    bool sweepOnly = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--json") == 0 && (i + 1) < argc)
+        {
+            if (!ncore::nbench::json_open(argv[++i]))
+            {
+                printf("can not write %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--sweep") == 0)
+        {
+            sweepOnly = true;
+        }
+    }
+
+    if (!sweepOnly)
+    {
+        ncore::nbench::bench_kalman_bank();
+        ncore::nbench::bench_kalman_fused();
+        ncore::nbench::bench_kalman_packed();
+        ncore::nbench::bench_kalman_solve();
+        ncore::nbench::bench_kalman_steady();
+        ncore::nbench::bench_kalman_1d_array();
+        ncore::nbench::bench_kalman_fixed();
+        ncore::nbench::bench_kalman_predict();
+        ncore::nbench::bench_rd03d_parser();
+        ncore::nbench::bench_rd03d_log();
+        ncore::nbench::bench_kalman_telemetry();
+        ncore::nbench::bench_kalman_async();
+        ncore::nbench::bench_kalman_smoother();
+        ncore::nbench::bench_kalman_info();
+        ncore::nbench::bench_kalman_sqrt();
+        ncore::nbench::bench_kalman_model();
+        ncore::nbench::bench_kalman_expr();
+        ncore::nbench::bench_rd03d_pipeline();
+        ncore::nbench::bench_kalman_tracker();
+        ncore::nbench::bench_rd03d_fleet();
+        ncore::nbench::bench_rd03d_polar();
+        ncore::nbench::bench_kalman_ekf();
+        ncore::nbench::bench_rd03d_zones();
+    }
+    ncore::nbench::bench_sweep();
+
+    ncore::nbench::json_close();
+    return 0;
+}
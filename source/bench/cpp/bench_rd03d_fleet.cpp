@@ -0,0 +1,80 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_fleet.h"
+
+#include "bench.h"
+
+#include <cmath>
+#include <stdio.h>
+#include <thread>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            FLEET_SENSORS = 4096,
+            FLEET_TICKS   = 40
+        };
+
+        static u8                     s_fleetMemory[nkalman::rd03d_fleet_memory(FLEET_SENSORS)];
+        static nkalman::rd03d_fleet_t s_fleet;
+
+        // Synthetic sensor: 1 to 3 targets circling at a sensor specific radius and phase
+        static i32 fleet_frame(i32 sensor, i32 frame, nkalman::target_t targets[nkalman::MAX_TARGETS])
+        {
+            const i32 count = 1 + (sensor % 3);
+            for (i32 t = 0; t < count; ++t)
+            {
+                const f32 phase       = (f32)sensor * 0.61f + (f32)t * 2.0f + (f32)frame * 0.05f;
+                targets[t].m_id       = (u8)(t + 1);
+                targets[t].m_detected = ((frame + sensor + t) % 11) != 0;
+                targets[t].m_distance = 1.5f + (f32)t + 0.4f * sinf(phase);
+                targets[t].m_angle    = 35.0f * cosf(phase);
+                targets[t].m_speed    = 0.0f;
+            }
+            return count;
+        }
+
+        // One frame per sensor and tick for 4096 sensors, 1 to N worker threads (N = hardware threads).
+        // Only tick() is timed, the frames are generated and pushed beforehand.
+        void bench_rd03d_fleet()
+        {
+            i32 cores = (i32)std::thread::hardware_concurrency();
+            cores     = (cores < 1) ? 1 : ((cores > nkalman::RD03D_FLEET_MAX_WORKERS) ? (i32)nkalman::RD03D_FLEET_MAX_WORKERS : cores);
+
+            f64 single = 0.0;
+            for (i32 workers = 1;; workers = (workers * 2 < cores) ? workers * 2 : cores)  // 1, 2, 4, ..., cores
+            {
+                nkalman::setup(s_fleet, s_fleetMemory, FLEET_SENSORS, workers);
+
+                f64 ns     = 0.0;
+                i32 frames = 0;
+                for (i32 tick = 0; tick < FLEET_TICKS; ++tick)
+                {
+                    for (i32 s = 0; s < FLEET_SENSORS; ++s)
+                    {
+                        nkalman::target_t targets[nkalman::MAX_TARGETS];
+                        const i32         count = fleet_frame(s, tick, targets);
+                        nkalman::push(s_fleet, s, targets, count);
+                    }
+                    timer_t timer;
+                    timer.start();
+                    frames += nkalman::tick(s_fleet);
+                    ns += timer.elapsed_ns();
+                }
+                nkalman::teardown(s_fleet);
+
+                const f64 perFrame = ns / (f64)frames;
+                single             = (workers == 1) ? perFrame : single;
+                char name[64];
+                snprintf(name, sizeof(name), "fleet x%d sensors, %2d workers", (i32)FLEET_SENSORS, workers);
+                printf("%-48s %12.2f ns/frame %16.0f frame/s  speedup %5.2f\n", name, perFrame, 1.0e9 / perFrame, single / perFrame);
+                json_result(name, workers, 0, "frame", perFrame, 0.0);
+                if (workers == cores)
+                    break;
+            }
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,80 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_log.h"
+
+#include "bench.h"
+
+#include <cmath>
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            LOG_SENSORS = 8,
+            LOG_FRAMES  = 50000  // per sensor
+        };
+
+        void bench_rd03d_log()
+        {
+            const char* path = "bench_rd03d_log.rdlog";
+
+            static nkalman::log_recorder_t rec;
+            if (!nkalman::open(rec, path))
+            {
+                printf("rd03d log: can not create %s\n", path);
+                return;
+            }
+
+            timer_t timer;
+            timer.start();
+            for (i32 f = 0; f < LOG_FRAMES; ++f)
+            {
+                for (i32 s = 0; s < LOG_SENSORS; ++s)
+                {
+                    const f32         x          = -1.0f + 0.05f * (f32)(f % 60);
+                    const f32         y          = 2.0f + 0.1f * (f32)s;
+                    nkalman::target_t targets[1] = {};
+                    targets[0].m_id              = 1;
+                    targets[0].m_detected        = true;
+                    targets[0].m_distance        = sqrtf(x * x + y * y);
+                    targets[0].m_angle           = atan2f(x, y) * 57.29578f;
+                    nkalman::record(rec, (u64)f * 50000, (u16)s, targets, 1);
+                }
+            }
+            nkalman::close(rec);
+            report("rd03d log record", (f64)LOG_FRAMES * LOG_SENSORS, timer.elapsed_ns(), "frame");
+
+            nkalman::log_file_t file;
+            nkalman::log_view_t view;
+            if (!nkalman::map(file, path) || !nkalman::open(view, file.m_data, file.m_size))
+            {
+                printf("rd03d log: can not map %s\n", path);
+                remove(path);
+                return;
+            }
+
+            static nkalman::rd03d_t trackers[LOG_SENSORS];
+            nkalman::setup(trackers[0]);
+            nkalman::replay_stats_t stats = nkalman::replay(view, trackers[0], 0);
+            printf("%-48s %12.0f frames/s (%llu frames)\n", "rd03d log replay, 1 sensor", stats.m_framesPerSecond, (unsigned long long)stats.m_frames);
+
+            const i32 threads[] = {1, 2, 4, 8};
+            for (i32 t = 0; t < 4; ++t)
+            {
+                for (i32 s = 0; s < LOG_SENSORS; ++s)
+                    nkalman::setup(trackers[s]);
+                stats = nkalman::replay(view, trackers, LOG_SENSORS, threads[t]);
+
+                char name[64];
+                snprintf(name, sizeof(name), "rd03d log replay, %d sensors, %d threads", (i32)LOG_SENSORS, threads[t]);
+                printf("%-48s %12.0f frames/s (%llu frames)\n", name, stats.m_framesPerSecond, (unsigned long long)stats.m_frames);
+            }
+
+            nkalman::unmap(file);
+            remove(path);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,81 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_parser.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            PARSER_RING   = 4096,
+            PARSER_FRAMES = 200000
+        };
+
+        static void write_field(u8* out, i32 v)
+        {
+            const u32 raw = (v >= 0) ? (0x8000u | (u32)v) : (u32)(-v);
+            out[0]        = (u8)(raw & 0xFF);
+            out[1]        = (u8)(raw >> 8);
+        }
+
+        // Fills the ring with back-to-back frames of one target walking along x
+        static u32 write_frames(u8* ring, u32 write, i32 first, i32 count)
+        {
+            for (i32 f = 0; f < count; ++f)
+            {
+                u8 frame[nkalman::RD03D_FRAME_SIZE] = {0xAA, 0xFF, 0x03, 0x00};
+                write_field(frame + 4, -1000 + ((first + f) % 400) * 5);
+                write_field(frame + 6, 2000);
+                write_field(frame + 8, 25);
+                write_field(frame + 10, 360);
+                frame[28] = 0x55;
+                frame[29] = 0xCC;
+                for (i32 b = 0; b < nkalman::RD03D_FRAME_SIZE; ++b)
+                    ring[(write + b) & (PARSER_RING - 1)] = frame[b];
+                write += nkalman::RD03D_FRAME_SIZE;
+            }
+            return write;
+        }
+
+        void bench_rd03d_parser()
+        {
+            static u8 ring[PARSER_RING];
+            const i32 batch = PARSER_RING / nkalman::RD03D_FRAME_SIZE;
+
+            nkalman::rd03d_parser_t p;
+            nkalman::target_t       targets[nkalman::MAX_TARGETS];
+            f64                     decodeNs = 0.0;
+            u32                     w        = 0;
+            nkalman::setup(p, ring, PARSER_RING);
+            timer_t timer;
+            for (i32 f = 0; f < PARSER_FRAMES; f += batch)
+            {
+                w = write_frames(ring, w, f, batch);
+                timer.start();
+                while (nkalman::next(p, w, targets))
+                    do_not_optimize(targets);
+                decodeNs += timer.elapsed_ns();
+            }
+            const f64 frames = (f64)p.m_frames;
+            report("rd03d parser next (decode only)", frames, decodeNs, "frame");
+            report("rd03d parser next (decode only)", frames * nkalman::RD03D_FRAME_SIZE, decodeNs, "byte");
+
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            nkalman::setup(p, ring, PARSER_RING, w);
+            f64 parseNs = 0.0;
+            for (i32 f = 0; f < PARSER_FRAMES; f += batch)
+            {
+                w = write_frames(ring, w, f, batch);
+                timer.start();
+                nkalman::parse(p, w, rd);
+                parseNs += timer.elapsed_ns();
+            }
+            do_not_optimize(rd);
+            report("rd03d parser parse (decode + processFrame)", (f64)p.m_frames, parseNs, "frame");
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
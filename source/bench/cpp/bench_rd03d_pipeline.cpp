@@ -0,0 +1,194 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_pipeline.h"
+
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            PIPELINE_FRAMES  = 20000,
+            PIPELINE_READERS = 3,
+            PIPELINE_SPACING = 20000  // ns between ingested frames
+        };
+
+        static inline u64 now_ns() { return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+        static void make_frame(i32 frame, nkalman::target_t targets[nkalman::MAX_TARGETS])
+        {
+            const f32 x           = -1.0f + 0.05f * (f32)(frame % 60);
+            targets[0].m_id       = 1;
+            targets[0].m_detected = true;
+            targets[0].m_distance = sqrtf(x * x + 4.0f);
+            targets[0].m_angle    = atan2f(x, 2.0f) * (180.0f / 3.14159265f);
+            targets[0].m_speed    = 0.5f;
+            targets[1].m_id       = 2;
+            targets[1].m_detected = ((frame / 20) & 1) != 0;
+            targets[1].m_distance = 3.0f;
+            targets[1].m_angle    = 10.0f;
+            targets[1].m_speed    = 0.0f;
+        }
+
+        static nkalman::rd03d_pipeline_t s_pipeline;
+        static u64                       s_ingested[PIPELINE_FRAMES];  // ingest time of frame i
+        static u64                       s_latency[PIPELINE_FRAMES];   // ingest -> visible to reader 0
+
+        // Mutex baseline: the filter thread holds the lock while it processes, readers while they copy
+        struct locked_t
+        {
+            std::mutex             m_mutex;
+            nkalman::rd03d_t       m_rd;
+            nkalman::target_t      m_targets[nkalman::MAX_TARGETS];
+            u64                    m_pending;  // frames handed over, guarded by m_mutex
+            nkalman::rd03d_state_t m_state;
+        };
+        static locked_t s_locked;
+
+        static void report_latency(const char* name, i32 count, u64 readerNs, u64 reads)
+        {
+            std::sort(s_latency, s_latency + count);
+            const f64 p50  = (f64)s_latency[count / 2];
+            const f64 p99  = (f64)s_latency[(count * 99) / 100];
+            const f64 p999 = (f64)s_latency[(count * 999) / 1000];
+            const f64 max  = (f64)s_latency[count - 1];
+            const f64 read = (reads > 0) ? (f64)readerNs / (f64)reads : 0.0;
+            printf("%-40s p50 %7.0f p99 %7.0f p99.9 %8.0f max %9.0f ns, read %6.1f ns\n", name, p50, p99, p999, max, read);
+            json_result(name, 50, 0, "latency_p50", p50, 0.0);
+            json_result(name, 99, 0, "latency_p99", p99, 0.0);
+            json_result(name, 999, 0, "latency_p999", p999, 0.0);
+            json_result(name, 0, 0, "read", read, 0.0);
+        }
+
+        // Ingest thread pacing frames, filter thread, readers polling; reader 0 records when each frame becomes visible
+        template <typename INGEST, typename FILTER, typename READ>
+        static void run_threads(const char* name, INGEST ingest, FILTER filter, READ read)
+        {
+            for (i32 i = 0; i < PIPELINE_FRAMES; ++i)
+                s_latency[i] = 0;
+
+            std::atomic<bool> done(false);
+            std::atomic<u64>  readerNs(0);
+            std::atomic<u64>  reads(0);
+            std::thread       readers[PIPELINE_READERS];
+            for (i32 r = 0; r < PIPELINE_READERS; ++r)
+            {
+                readers[r] = std::thread([&, r]() {
+                    u64 seen = 0;
+                    u64 n    = 0;
+                    u64 ns   = 0;
+                    while (!done.load(std::memory_order_acquire))
+                    {
+                        nkalman::rd03d_state_t state;
+                        const u64              t0 = now_ns();
+                        read(state);
+                        const u64 t1 = now_ns();
+                        ns += t1 - t0;
+                        ++n;
+                        if (r == 0 && state.m_frame > seen)
+                        {
+                            for (u64 f = seen; f < state.m_frame && f < PIPELINE_FRAMES; ++f)
+                                s_latency[f] = t1 - s_ingested[f];
+                            seen = state.m_frame;
+                        }
+                        std::this_thread::yield();
+                    }
+                    readerNs.fetch_add(ns);
+                    reads.fetch_add(n);
+                });
+            }
+
+            // Idle threads yield, so the numbers stay meaningful with fewer cores than threads
+            std::thread filterThread([&]() {
+                while (!filter())
+                    std::this_thread::yield();
+            });
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            u64               next = now_ns();
+            for (i32 i = 0; i < PIPELINE_FRAMES; ++i)
+            {
+                while (now_ns() < next)
+                    std::this_thread::yield();
+                make_frame(i, targets);
+                s_ingested[i] = now_ns();
+                ingest(targets);
+                next += PIPELINE_SPACING;
+            }
+            filterThread.join();
+            // Let reader 0 observe the last publish
+            const u64 deadline = now_ns() + 10000000;
+            while (s_latency[PIPELINE_FRAMES - 1] == 0 && now_ns() < deadline)
+                std::this_thread::yield();
+            done.store(true, std::memory_order_release);
+            for (i32 r = 0; r < PIPELINE_READERS; ++r)
+                readers[r].join();
+
+            report_latency(name, PIPELINE_FRAMES, readerNs.load(), reads.load());
+        }
+
+        void bench_rd03d_pipeline()
+        {
+            // Lock-free: SPSC queue and seqlock snapshot
+            nkalman::setup(s_pipeline);
+            u64 processed = 0;
+            run_threads(
+              "pipeline ingest->read (lock-free)", [](const nkalman::target_t* targets) {
+                  while (!nkalman::push(s_pipeline, targets, 2))
+                      std::this_thread::yield();
+              },
+              [&processed]() {
+                  processed += (u64)nkalman::process(s_pipeline);
+                  return processed >= PIPELINE_FRAMES;
+              },
+              [](nkalman::rd03d_state_t& state) { nkalman::read(s_pipeline, state); });
+
+            // One mutex around the frame hand-over, the filter and the state
+            nkalman::setup(s_locked.m_rd);
+            s_locked.m_pending = 0;
+            memset(&s_locked.m_state, 0, sizeof(s_locked.m_state));
+            u64 handled = 0;
+            run_threads(
+              "pipeline ingest->read (mutex)",
+              [](const nkalman::target_t* targets) {
+                  for (;;)
+                  {
+                      {
+                          std::lock_guard<std::mutex> lock(s_locked.m_mutex);
+                          if (s_locked.m_pending == 0)
+                          {
+                              for (i32 t = 0; t < 2; ++t)
+                                  s_locked.m_targets[t] = targets[t];
+                              s_locked.m_pending = 1;
+                              return;
+                          }
+                      }
+                      std::this_thread::yield();
+                  }
+              },
+              [&handled]() {
+                  std::lock_guard<std::mutex> lock(s_locked.m_mutex);
+                  if (s_locked.m_pending != 0)
+                  {
+                      nkalman::processFrame(s_locked.m_rd, s_locked.m_targets, 2);
+                      s_locked.m_pending = 0;
+                      ++handled;
+                      nkalman::getState(s_locked.m_rd, handled, 0, s_locked.m_state);
+                  }
+                  return handled >= PIPELINE_FRAMES;
+              },
+              [](nkalman::rd03d_state_t& state) {
+                  std::lock_guard<std::mutex> lock(s_locked.m_mutex);
+                  state = s_locked.m_state;
+              });
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,80 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_sincos.h"
+
+#include "bench.h"
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            POLAR_TARGETS = 4096,
+            POLAR_ROUNDS  = 500
+        };
+
+        static f32 s_polarDistance[POLAR_TARGETS];
+        static f32 s_polarAngle[POLAR_TARGETS];
+        static f32 s_polarX[POLAR_TARGETS];
+        static f32 s_polarY[POLAR_TARGETS];
+
+        // Polar -> Cartesian of 4096 targets (RD-03D field of view, -60..60 degrees, 0.2..8 m):
+        // the double precision libm conversion processFrame() used per target, f32 sinf/cosf,
+        // the batched polynomial sincos and the lookup table.
+        void bench_rd03d_polar()
+        {
+            for (i32 i = 0; i < POLAR_TARGETS; ++i)
+            {
+                s_polarDistance[i] = 0.2f + 7.8f * (f32)((i * 37) % POLAR_TARGETS) / (f32)POLAR_TARGETS;
+                s_polarAngle[i]    = -60.0f + 120.0f * (f32)((i * 101) % POLAR_TARGETS) / (f32)POLAR_TARGETS;
+            }
+            const f64 items = (f64)POLAR_TARGETS * POLAR_ROUNDS;
+            timer_t   timer;
+
+            timer.start();
+            for (i32 r = 0; r < POLAR_ROUNDS; ++r)
+            {
+                for (i32 i = 0; i < POLAR_TARGETS; ++i)
+                {
+                    const f32 rad = s_polarAngle[i] * 0.0174532925f;
+                    s_polarX[i]   = (f32)(s_polarDistance[i] * sin(rad));
+                    s_polarY[i]   = (f32)(s_polarDistance[i] * cos(rad));
+                }
+                do_not_optimize(s_polarX);
+            }
+            report("polar -> cartesian libm sin/cos (double)", items, timer.elapsed_ns(), "target");
+
+            timer.start();
+            for (i32 r = 0; r < POLAR_ROUNDS; ++r)
+            {
+                for (i32 i = 0; i < POLAR_TARGETS; ++i)
+                {
+                    const f32 rad = s_polarAngle[i] * 0.0174532925f;
+                    s_polarX[i]   = s_polarDistance[i] * sinf(rad);
+                    s_polarY[i]   = s_polarDistance[i] * cosf(rad);
+                }
+                do_not_optimize(s_polarX);
+            }
+            report("polar -> cartesian libm sinf/cosf", items, timer.elapsed_ns(), "target");
+
+            timer.start();
+            for (i32 r = 0; r < POLAR_ROUNDS; ++r)
+            {
+                nkalman::polarToCartesianPoly(s_polarDistance, s_polarAngle, POLAR_TARGETS, s_polarX, s_polarY);
+                do_not_optimize(s_polarX);
+            }
+            report("polar -> cartesian batched polynomial", items, timer.elapsed_ns(), "target");
+
+            timer.start();
+            for (i32 r = 0; r < POLAR_ROUNDS; ++r)
+            {
+                nkalman::polarToCartesianLut(s_polarDistance, s_polarAngle, POLAR_TARGETS, s_polarX, s_polarY);
+                do_not_optimize(s_polarX);
+            }
+            report("polar -> cartesian lookup table", items, timer.elapsed_ns(), "target");
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
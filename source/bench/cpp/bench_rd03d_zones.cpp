@@ -0,0 +1,125 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_zones.h"
+
+#include "bench.h"
+
+#include <cmath>
+#include <stdio.h>
+
+namespace ncore
+{
+    namespace nbench
+    {
+        enum
+        {
+            ZONE_FRAMES = 20000
+        };
+
+        // 'count' zones tiled over 16 x 8 m in front of the sensor, alternating rectangles and hexagons
+        template <typename MAP>
+        static void build_zones(MAP& map, i32 count)
+        {
+            nkalman::initialize(map);
+            i32 columns = 1;
+            while (columns * columns < 2 * count)
+                columns += 1;
+            const i32 rows = (count + columns - 1) / columns;
+            const f32 w    = 16.0f / (f32)columns;
+            const f32 h    = 8.0f / (f32)rows;
+            for (i32 z = 0; z < count; ++z)
+            {
+                const f32 cx = -8.0f + ((f32)(z % columns) + 0.5f) * w;
+                const f32 cy = ((f32)(z / columns) + 0.5f) * h;
+                if ((z & 1) == 0)
+                {
+                    nkalman::addRectangle(map, (u32)z, cx - 0.4f * w, cy - 0.4f * h, cx + 0.4f * w, cy + 0.4f * h);
+                    continue;
+                }
+                f32 x[6], y[6];
+                for (i32 v = 0; v < 6; ++v)
+                {
+                    x[v] = cx + 0.4f * w * cosf(1.04719755f * (f32)v);
+                    y[v] = cy + 0.4f * h * sinf(1.04719755f * (f32)v);
+                }
+                nkalman::addPolygon(map, (u32)z, x, y, 6);
+            }
+            nkalman::compile(map);
+        }
+
+        // Three tracks walking circles through the room, converged covariance
+        static void move_tracks(nkalman::rd03d_t& rd, i32 frame)
+        {
+            for (i32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+            {
+                const f32 a                      = 0.002f * (f32)frame + 2.0f * (f32)t;
+                rd.m_roomFilters[t].x.data[0][0] = (5.0f - (f32)t) * sinf(a);
+                rd.m_roomFilters[t].x.data[1][0] = 4.0f + (3.0f - (f32)t) * cosf(a);
+            }
+        }
+
+        template <typename MAP>
+        static void run_zone_frames(i32 count)
+        {
+            static MAP            map;
+            nkalman::zone_state_t state;
+            nkalman::rd03d_t      rd;
+            nkalman::zone_event_t events[64];
+            build_zones(map, count);
+            nkalman::setup(rd);
+            for (i32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+            {
+                const f32 initial[nkalman::STATE_DIM] = {0.0f, 4.0f, 0.0f, 0.0f};
+                nkalman::begin(rd.m_roomFilters[t], initial, 0.01f);
+                rd.m_targetActive[t] = true;
+            }
+
+            // update(): the zones near each track
+            nkalman::initialize(state);
+            i32     total = 0;
+            timer_t timer;
+            timer.start();
+            u64 c0 = cycles();
+            for (i32 frame = 0; frame < ZONE_FRAMES; ++frame)
+            {
+                move_tracks(rd, frame);
+                total += nkalman::update(map, state, rd, events, 64);
+            }
+            u64 c1 = cycles();
+            f64 ns = timer.elapsed_ns();
+            do_not_optimize(total);
+
+            char name[64];
+            snprintf(name, sizeof(name), "zones update, %d zones", count);
+            report_cycles(name, (f64)ZONE_FRAMES, ns, c1 - c0);
+
+            // Every zone classified for every track, what update() replaces
+            i32 inside = 0;
+            timer.start();
+            c0 = cycles();
+            for (i32 frame = 0; frame < ZONE_FRAMES; ++frame)
+            {
+                move_tracks(rd, frame);
+                for (i32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+                {
+                    const nkalman::rd03d_filter_t& kf = rd.m_roomFilters[t];
+                    for (i32 z = 0; z < map.m_zoneCount; ++z)
+                        inside += nkalman::nzones::classify(map, z, kf.x.data[0][0], kf.x.data[1][0], kf.P.data[0][0], kf.P.data[0][1], kf.P.data[1][1]);
+                }
+            }
+            c1 = cycles();
+            ns = timer.elapsed_ns();
+            do_not_optimize(inside);
+            snprintf(name, sizeof(name), "zones every zone, %d zones", count);
+            report_cycles(name, (f64)ZONE_FRAMES, ns, c1 - c0);
+        }
+
+        // Zone evaluation per frame (3 tracks) against the number of zones
+        void bench_rd03d_zones()
+        {
+            run_zone_frames<nkalman::zone_map_t<16> >(16);
+            run_zone_frames<nkalman::zone_map_t<256> >(256);
+            run_zone_frames<nkalman::zone_map_t<4096> >(4096);
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -0,0 +1,218 @@
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_rd03d.h"
+
+#include "bench.h"
+
+namespace ncore
+{
+    namespace nbench
+    {
+        // Dimension sweep: the same measurement repeated for N = 1..12 states and M = 1..6 measurements
+        // (M <= N) so that a change in matrix_t or the filter shows up as a shift in one row of the
+        // table. Run with --json to get the results in a file that can be diffed between builds.
+
+        enum
+        {
+            SWEEP_MAX_N       = 12,
+            SWEEP_MAX_M       = 6,
+            SWEEP_BUDGET      = 4000000,  // iterations * N^3, keeps every row at a similar run time
+            SWEEP_MIN_ITERS   = 2000,
+            SWEEP_1D_ITERS    = 2000000,
+            SWEEP_RD03D_ITERS = 200000
+        };
+
+        static inline i32 sweep_iterations(i32 n)
+        {
+            const i32 iterations = SWEEP_BUDGET / (n * n * n);
+            return (iterations < SWEEP_MIN_ITERS) ? (i32)SWEEP_MIN_ITERS : iterations;
+        }
+
+        // Diagonally dominant so that invert() never hits a zero pivot
+        template <i32 N>
+        static void sweep_fill(nkalman::matrix_t<N, N>& a)
+        {
+            for (i32 r = 0; r < N; ++r)
+                for (i32 c = 0; c < N; ++c)
+                    a.data[r][c] = (r == c) ? (f32)(N + 1) : 1.0f / (f32)(1 + r + c);
+        }
+
+        template <i32 N, i32 M>
+        static void sweep_update()
+        {
+            nkalman::kalman_nd_t<N, M> kf;
+            nkalman::initialize(kf);
+            for (i32 r = 0; r < N; ++r)
+                for (i32 c = 0; c < N; ++c)
+                    kf.F.data[r][c] = (r == c) ? 1.0f : ((c == r + 1) ? 0.05f : 0.0f);
+            kf.H.clear();
+            for (i32 r = 0; r < M; ++r)
+                kf.H.data[r][r] = 1.0f;
+            kf.Q.setIdentity();
+            for (i32 i = 0; i < N; ++i)
+                kf.Q.data[i][i] = 0.01f;
+
+            f32 initial[N];
+            for (i32 i = 0; i < N; ++i)
+                initial[i] = 0.0f;
+            nkalman::begin(kf, initial, 1.0f);
+
+            f32 z[M];
+            for (i32 i = 0; i < M; ++i)
+                z[i] = (f32)i;
+
+            const i32 iterations = sweep_iterations(N);
+            timer_t   timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 it = 0; it < iterations; ++it)
+            {
+                z[0] = (f32)(it & 15) * 0.1f;
+                nkalman::update(kf, z);
+            }
+            const u64 c1 = cycles();
+            do_not_optimize(kf);
+            report_sweep("kalman_nd_t update", N, M, (f64)iterations, timer.elapsed_ns(), c1 - c0, "update");
+        }
+
+        template <i32 N>
+        static void sweep_matrix()
+        {
+            nkalman::matrix_t<N, N> a, b, out;
+            sweep_fill(a);
+            sweep_fill(b);
+
+            const i32 iterations = sweep_iterations(N);
+            timer_t   timer;
+            timer.start();
+            u64 c0 = cycles();
+            for (i32 it = 0; it < iterations; ++it)
+            {
+                a.multiply(b, out);
+                b.data[0][0] = out.data[N - 1][N - 1] * 1.0e-6f + (f32)(N + 1);  // chain the iterations
+            }
+            u64 c1 = cycles();
+            do_not_optimize(out);
+            report_sweep("matrix_t multiply", N, N, (f64)iterations, timer.elapsed_ns(), c1 - c0, "op");
+
+            timer.start();
+            c0 = cycles();
+            for (i32 it = 0; it < iterations; ++it)
+            {
+                a.invert(out);
+                a.data[0][0] = out.data[0][0] * 1.0e-6f + (f32)(N + 1);
+            }
+            c1 = cycles();
+            do_not_optimize(out);
+            report_sweep("matrix_t invert", N, N, (f64)iterations, timer.elapsed_ns(), c1 - c0, "op");
+        }
+
+        // ----------------------------------------------------------------------------
+        // Compile-time loops over N and M
+        // ----------------------------------------------------------------------------
+
+        template <i32 N, i32 M>
+        struct sweep_m_t
+        {
+            static void run()
+            {
+                sweep_m_t<N, M - 1>::run();
+                if (M <= N)
+                    sweep_update<N, (M <= N) ? M : N>();
+            }
+        };
+
+        template <i32 N>
+        struct sweep_m_t<N, 0>
+        {
+            static void run() {}
+        };
+
+        template <i32 N>
+        struct sweep_n_t
+        {
+            static void run()
+            {
+                sweep_n_t<N - 1>::run();
+                sweep_m_t<N, SWEEP_MAX_M>::run();
+            }
+        };
+
+        template <>
+        struct sweep_n_t<0>
+        {
+            static void run() {}
+        };
+
+        template <i32 N>
+        struct sweep_matrix_t
+        {
+            static void run()
+            {
+                sweep_matrix_t<N - 1>::run();
+                sweep_matrix<N>();
+            }
+        };
+
+        template <>
+        struct sweep_matrix_t<0>
+        {
+            static void run() {}
+        };
+
+        // ----------------------------------------------------------------------------
+
+        static void sweep_1d()
+        {
+            nkalman::kalman_1D_t kf;
+            nkalman::initialize(kf);
+            nkalman::begin(kf, 0.0f, 1.0f);
+
+            timer_t timer;
+            timer.start();
+            const u64 c0  = cycles();
+            f32       sum = 0.0f;
+            for (i32 it = 0; it < SWEEP_1D_ITERS; ++it)
+                sum += nkalman::update(kf, (f32)(it & 15) * 0.1f);
+            const u64 c1 = cycles();
+            do_not_optimize(sum);
+            report_sweep("kalman_1D_t update", 1, 1, (f64)SWEEP_1D_ITERS, timer.elapsed_ns(), c1 - c0, "update");
+        }
+
+        static void sweep_rd03d()
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            for (i32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+            {
+                targets[t].m_id       = (u8)(t + 1);
+                targets[t].m_detected = true;
+                targets[t].m_distance = 1.5f + (f32)t;
+                targets[t].m_angle    = -30.0f + 30.0f * (f32)t;
+                targets[t].m_speed    = 0.0f;
+            }
+
+            timer_t timer;
+            timer.start();
+            const u64 c0 = cycles();
+            for (i32 it = 0; it < SWEEP_RD03D_ITERS; ++it)
+            {
+                targets[0].m_angle = -30.0f + (f32)(it & 31) * 0.1f;
+                nkalman::processFrame(rd, targets, nkalman::MAX_TARGETS);
+            }
+            const u64 c1 = cycles();
+            do_not_optimize(rd);
+            report_sweep("rd03d processFrame 3 targets", nkalman::STATE_DIM, nkalman::MEASURE_DIM, (f64)SWEEP_RD03D_ITERS, timer.elapsed_ns(), c1 - c0, "frame");
+        }
+
+        void bench_sweep()
+        {
+            sweep_n_t<SWEEP_MAX_N>::run();
+            sweep_matrix_t<SWEEP_MAX_N>::run();
+            sweep_1d();
+            sweep_rd03d();
+        }
+
+    }  // namespace nbench
+}  // namespace ncore
@@ -1,4 +1,5 @@
 #include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_async.h"
 #include "ckalman/c_rd03d.h"
 
 #include "ccore/c_debug.h"
@@ -11,44 +12,104 @@ namespace ncore
 {
     namespace nkalman
     {
-        void processFrame(rd03d_t& rd, const target_t targets[], i32 count)
+#if defined(CKALMAN_TELEMETRY)
+        static inline telemetry_t& telemetryOf(rd03d_t& rd) { return rd.m_telemetry; }
+#else
+        static telemetry_t         s_noTelemetry;  // empty, every telemetry call on it is a no-op
+        static inline telemetry_t& telemetryOf(rd03d_t&) { return s_noTelemetry; }
+#endif
+
+        // 'timed' frames carry a timestamp, every track is predicted over the time since its last update
+        static void processTargets(rd03d_t& rd, const target_t targets[], i32 count, bool timed, u64 timestamp)
         {
-            bool seenThisFrame[MAX_TARGETS] = {false, false, false};
+            bool         seenThisFrame[MAX_TARGETS] = {false, false, false};
+            telemetry_t& telemetry                  = telemetryOf(rd);
 
+            f32 frameX[MAX_TARGETS], frameY[MAX_TARGETS];
             for (i32 i = 0; i < count; i++)
             {
+                // 1. Convert Polar (Distance, Angle) to Cartesian (X, Y), the targets of a frame in one batch
+                if ((i % MAX_TARGETS) == 0)
+                    polarToCartesian(targets + i, (count - i < MAX_TARGETS) ? count - i : (i32)MAX_TARGETS, frameX, frameY);
+
                 const i32 idx = targets[i].m_id - 1;
                 if (idx < 0 || idx >= MAX_TARGETS)
                     continue;
 
                 if (targets[i].m_detected)
                 {
+                    // A timestamped frame older than the state of the track is ignored, it is no detection
+                    if (timed && rd.m_targetActive[idx] && timestamp < rd.m_time[idx])
+                        continue;
                     seenThisFrame[idx] = true;
 
-                    // 1. Convert Polar (Distance, Angle) to Cartesian (X, Y)
-                    const f32 rad  = targets[i].m_angle * (math::PI / 180.0f);  // Convert degrees to radians
-                    const f32 posX = targets[i].m_distance * sin(rad);
-                    const f32 posY = targets[i].m_distance * cos(rad);
+                    const f32 posX = frameX[i % MAX_TARGETS];
+                    const f32 posY = frameY[i % MAX_TARGETS];
 
                     // 2. Gating: New Target Arrival
                     if (!rd.m_targetActive[idx])
                     {
                         rd.m_targetActive[idx] = true;
+                        rd.m_missedFrames[idx] = 0;
 
                         // Initial State: Position X, Position Y, Velocity X (0), Velocity Y (0)
                         f32 initialStates[STATE_DIM] = {posX, posY, 0.0f, 0.0f};
                         begin(rd.m_roomFilters[idx], initialStates, 5.0f);  // Higher initial uncertainty for new targets
+                        reset(rd.m_convergence[idx]);                        // P restarted, the gain has to converge again
+                        rd.m_time[idx] = timestamp;
+                        onSpawn(telemetry);
 
                         // Serial.print("🎯 Target ");
                         // Serial.print(targets[i].m_id);
                         // Serial.println(" spawned in room layout.");
                     }
 
-                    // 3. Filter Execution
-                    const f32 measurement[MEASURE_DIM] = {posX, posY};
-                    update(rd.m_roomFilters[idx], measurement);
+                    const bool polar                    = rd.m_measurement == RD03D_MEASURE_POLAR;
+                    const f32  measurement[MEASURE_DIM] = {polar ? targets[i].m_distance : posX, polar ? targets[i].m_angle : posY};
+
+                    // 3a. Timestamped frame off the regular interval (jitter, a dropout, a new track): predict
+                    //     over the elapsed time with Q scaled to it, then a full correction. The gain has to
+                    //     converge again, F is put back to the regular interval for the next frames.
+                    if (timed)
+                    {
+                        const f32 dt        = (f32)(timestamp - rd.m_time[idx]) * 1e-6f;
+                        const f32 deviation = (dt > rd.m_dt) ? (dt - rd.m_dt) : (rd.m_dt - dt);
+                        rd.m_time[idx]      = timestamp;
+                        if (rd.m_missedFrames[idx] > 0 || deviation > 0.25f * rd.m_dt)
+                        {
+                            if (dt > 0.0f)
+                                nasync::predict(rd.m_roomFilters[idx], dt, rd.m_dt);
+                            model_constant_velocity_t::set_dt(rd.m_roomFilters[idx].F, rd.m_dt);
+                            if (polar)
+                                correct_ekf<rd03d_polar_t>(rd.m_roomFilters[idx], measurement, telemetry);
+                            else
+                                correct(rd.m_roomFilters[idx], measurement, telemetry);
+                            reset(rd.m_convergence[idx]);
+                            if (rd.m_missedFrames[idx] > 0)
+                                onCoast(telemetry);
+                            rd.m_missedFrames[idx] = 0;
+                            continue;
+                        }
+                    }
 
-                    // 4. Extract Filtered 2D Trajectory Metrics
+                    // 3. Coasting: catch up on the frames the target was missing in one step, the
+                    //    grown covariance means the gain has to converge again
+                    if (rd.m_missedFrames[idx] > 0)
+                    {
+                        predict(rd.m_roomFilters[idx], rd.m_dt, rd.m_missedFrames[idx]);
+                        reset(rd.m_convergence[idx]);
+                        rd.m_missedFrames[idx] = 0;
+                        onCoast(telemetry);
+                    }
+
+                    // 4. Filter Execution (full update until the gain converges, gain-only after that). The
+                    //    extended filter's gain depends on where the target is, it never turns gain-only.
+                    if (polar)
+                        update_ekf<rd03d_polar_t>(rd.m_roomFilters[idx], measurement, telemetry);
+                    else
+                        update(rd.m_roomFilters[idx], rd.m_convergence[idx], measurement, telemetry);
+
+                    // 5. Extract Filtered 2D Trajectory Metrics
                     f32 cleanX   = rd.m_roomFilters[idx].x.data[0][0];
                     f32 cleanY   = rd.m_roomFilters[idx].x.data[1][0];
                     f32 speedX   = rd.m_roomFilters[idx].x.data[2][0];
@@ -68,12 +129,14 @@ namespace ncore
                 }
             }
 
-            // 5. Gating: Target Dropout
+            // 6. Gating: Target Dropout, a missed target coasts until it has been missing for too long
             for (i32 i = 0; i < MAX_TARGETS; i++)
             {
-                if (rd.m_targetActive[i] && !seenThisFrame[i])
+                if (rd.m_targetActive[i] && !seenThisFrame[i] && ++rd.m_missedFrames[i] > rd.m_maxMissedFrames)
                 {
                     rd.m_targetActive[i] = false;
+                    rd.m_missedFrames[i] = 0;
+                    onDrop(telemetry);
                     // Serial.print("❌ Target ");
                     // Serial.print(i + 1);
                     // Serial.println(" dropped from room.");
@@ -81,5 +144,9 @@ namespace ncore
             }
         }
 
+        void processFrame(rd03d_t& rd, const target_t targets[], i32 count) { processTargets(rd, targets, count, false, 0); }
+
+        void processFrame(rd03d_t& rd, const target_t targets[], i32 count, u64 timestamp) { processTargets(rd, targets, count, true, timestamp); }
+
     }  // namespace nkalman
 }  // namespace ncore
@@ -0,0 +1,205 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_fleet.h"
+
+#include "ccore/c_debug.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        static inline u64 makeRange(u32 next, u32 end) { return (u64)next | ((u64)end << 32); }
+        static inline u32 rangeNext(u64 range) { return (u32)range; }
+        static inline u32 rangeEnd(u64 range) { return (u32)(range >> 32); }
+
+        // Owner: the chunk at the front of its own range
+        static bool popChunk(rd03d_fleet_worker_t& worker, i32& chunk)
+        {
+            u64 range = worker.m_range.load(std::memory_order_relaxed);
+            while (rangeNext(range) < rangeEnd(range))
+            {
+                if (worker.m_range.compare_exchange_weak(range, makeRange(rangeNext(range) + 1, rangeEnd(range)), std::memory_order_relaxed))
+                {
+                    chunk = (i32)rangeNext(range);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Thief: the back half of the first other worker with chunks left. The thief's own range is empty,
+        // it runs the first stolen chunk and keeps the rest as its new range (open to other thieves).
+        static bool stealChunk(rd03d_fleet_t& fleet, i32 self, i32& chunk)
+        {
+            for (i32 i = 1; i < fleet.m_workerCount; ++i)
+            {
+                i32 v = self + i;
+                v     = (v >= fleet.m_workerCount) ? v - fleet.m_workerCount : v;
+
+                rd03d_fleet_worker_t& victim = fleet.m_workers[v];
+                u64                   range  = victim.m_range.load(std::memory_order_relaxed);
+                while (rangeNext(range) < rangeEnd(range))
+                {
+                    const u32 end  = rangeEnd(range);
+                    const u32 take = (end - rangeNext(range) + 1) / 2;
+                    if (victim.m_range.compare_exchange_weak(range, makeRange(rangeNext(range), end - take), std::memory_order_relaxed))
+                    {
+                        chunk = (i32)(end - take);
+                        fleet.m_workers[self].m_range.store(makeRange(end - take + 1, end), std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // All pending frames of the sensors of one chunk, in the order they were pushed
+        static void processChunk(rd03d_fleet_t& fleet, i32 chunk)
+        {
+            const i32 begin  = chunk * RD03D_FLEET_CHUNK;
+            const i32 end    = (begin + RD03D_FLEET_CHUNK < fleet.m_batchCount) ? begin + RD03D_FLEET_CHUNK : fleet.m_batchCount;
+            i32       frames = 0;
+            for (i32 b = begin; b < end; ++b)
+            {
+                rd03d_sensor_t& s = fleet.m_sensors[fleet.m_batch[b]];
+                for (i32 f = 0; f < s.m_pendingCount; ++f)
+                {
+                    const rd03d_frame_t& frame = s.m_pending[f];
+                    if (frame.m_timestamp != 0)
+                        processFrame(s.m_rd, frame.m_targets, frame.m_count, frame.m_timestamp);
+                    else
+                        processFrame(s.m_rd, frame.m_targets, frame.m_count);
+                }
+                s.m_frames += (u64)s.m_pendingCount;
+                frames += s.m_pendingCount;
+                s.m_pendingCount = 0;
+            }
+            fleet.m_processed.fetch_add(frames, std::memory_order_relaxed);
+        }
+
+        // Runs chunks (own first, then stolen ones) until every chunk of the tick is done
+        static void work(rd03d_fleet_t& fleet, i32 self)
+        {
+            i32 chunk;
+            for (;;)
+            {
+                if (popChunk(fleet.m_workers[self], chunk) || stealChunk(fleet, self, chunk))
+                {
+                    processChunk(fleet, chunk);
+                    fleet.m_remaining.fetch_sub(1, std::memory_order_release);
+                    continue;
+                }
+                if (fleet.m_remaining.load(std::memory_order_acquire) == 0)
+                    return;
+                std::this_thread::yield();  // the last chunks are still running on other workers
+            }
+        }
+
+        static void poolThread(rd03d_fleet_t* fleet, i32 self)
+        {
+            u32 generation = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(fleet->m_mutex);
+                    while (!fleet->m_stop && fleet->m_generation == generation)
+                        fleet->m_wake.wait(lock);
+                    if (fleet->m_stop)
+                        return;
+                    generation = fleet->m_generation;
+                }
+                work(*fleet, self);
+                fleet->m_busy.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        bool setup(rd03d_fleet_t& fleet, void* memory, i32 sensors, i32 workers, f32 dt, i32 maxMissedFrames)
+        {
+            if (workers < 1 || workers > RD03D_FLEET_MAX_WORKERS)
+                return false;
+
+            // Sensors first (aligned up to a cache line), the batch list behind them
+            const u64 misalignment = (u64)memory & (RD03D_CACHE_LINE_SIZE - 1);
+            u8*       base         = (u8*)memory + ((misalignment != 0) ? RD03D_CACHE_LINE_SIZE - misalignment : 0);
+            fleet.m_sensors        = (rd03d_sensor_t*)base;
+            fleet.m_batch          = (i32*)(fleet.m_sensors + sensors);
+            fleet.m_sensorCount    = sensors;
+            fleet.m_batchCount     = 0;
+            fleet.m_chunkCount     = 0;
+            fleet.m_workerCount    = workers;
+            fleet.m_ticks          = 0;
+            for (i32 i = 0; i < sensors; ++i)
+            {
+                rd03d_sensor_t& s = fleet.m_sensors[i];
+                setup(s.m_rd, dt, maxMissedFrames);
+                s.m_pendingCount = 0;
+                s.m_rejected     = 0;
+                s.m_frames       = 0;
+            }
+            for (i32 w = 0; w < RD03D_FLEET_MAX_WORKERS; ++w)
+                fleet.m_workers[w].m_range.store(0, std::memory_order_relaxed);
+            fleet.m_remaining.store(0, std::memory_order_relaxed);
+            fleet.m_busy.store(0, std::memory_order_relaxed);
+            fleet.m_processed.store(0, std::memory_order_relaxed);
+
+            fleet.m_generation = 0;
+            fleet.m_stop       = false;
+            for (i32 w = 1; w < workers; ++w)
+                fleet.m_threads[w] = std::thread(poolThread, &fleet, w);
+            return true;
+        }
+
+        void teardown(rd03d_fleet_t& fleet)
+        {
+            {
+                std::lock_guard<std::mutex> lock(fleet.m_mutex);
+                fleet.m_stop = true;
+            }
+            fleet.m_wake.notify_all();
+            for (i32 w = 1; w < fleet.m_workerCount; ++w)
+            {
+                if (fleet.m_threads[w].joinable())
+                    fleet.m_threads[w].join();
+            }
+        }
+
+        i32 tick(rd03d_fleet_t& fleet)
+        {
+            if (fleet.m_batchCount == 0)
+                return 0;
+
+            // Even shares of the chunks, the pool threads only read them after the wake up below
+            const i32 chunks   = (fleet.m_batchCount + RD03D_FLEET_CHUNK - 1) / RD03D_FLEET_CHUNK;
+            const i32 workers  = fleet.m_workerCount;
+            fleet.m_chunkCount = chunks;
+            for (i32 w = 0; w < workers; ++w)
+            {
+                const u32 begin = (u32)((i64)chunks * w / workers);
+                const u32 end   = (u32)((i64)chunks * (w + 1) / workers);
+                fleet.m_workers[w].m_range.store(makeRange(begin, end), std::memory_order_relaxed);
+            }
+            fleet.m_remaining.store(chunks, std::memory_order_relaxed);
+            fleet.m_processed.store(0, std::memory_order_relaxed);
+
+            if (workers > 1)
+            {
+                fleet.m_busy.store(workers - 1, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> lock(fleet.m_mutex);
+                    fleet.m_generation += 1;
+                }
+                fleet.m_wake.notify_all();
+            }
+
+            work(fleet, 0);
+
+            // Every chunk is done, wait until no pool thread is still looking for work (reading the ranges)
+            while (fleet.m_busy.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+
+            fleet.m_batchCount = 0;
+            fleet.m_ticks += 1;
+            return fleet.m_processed.load(std::memory_order_relaxed);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
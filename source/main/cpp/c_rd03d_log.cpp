@@ -0,0 +1,272 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_log.h"
+
+#include "ccore/c_debug.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#if defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        bool open(log_view_t& view, const void* data, u64 size)
+        {
+            view.m_records     = nullptr;
+            view.m_recordCount = 0;
+            view.m_recordSize  = 0;
+            if (data == nullptr || size < sizeof(log_header_t))
+                return false;
+
+            log_header_t header;
+            memcpy(&header, data, sizeof(header));
+            if (header.m_magic != (u32)RD03D_LOG_MAGIC || header.m_version == 0)
+                return false;
+            if (header.m_recordSize < sizeof(log_record_t))  // a newer version only appends fields
+                return false;
+            if ((header.m_recordSize % alignof(log_record_t)) != 0)  // record() reads the records in place
+                return false;
+
+            // A log that was not closed has no record count yet, use what is complete on disk
+            const u64 available = (size - sizeof(log_header_t)) / header.m_recordSize;
+            view.m_records      = (const u8*)data + sizeof(log_header_t);
+            view.m_recordSize   = header.m_recordSize;
+            view.m_recordCount  = (header.m_recordCount == 0 || header.m_recordCount > available) ? available : header.m_recordCount;
+            return true;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Recorder
+        // ----------------------------------------------------------------------------
+
+        static bool writeHeader(FILE* f, u64 recordCount)
+        {
+            log_header_t header;
+            memset(&header, 0, sizeof(header));
+            header.m_magic       = RD03D_LOG_MAGIC;
+            header.m_version     = RD03D_LOG_VERSION;
+            header.m_recordSize  = (u16)sizeof(log_record_t);
+            header.m_recordCount = recordCount;
+            return fwrite(&header, sizeof(header), 1, f) == 1;
+        }
+
+        static bool flush(log_recorder_t& rec)
+        {
+            if (rec.m_buffered == 0)
+                return true;
+            const size_t written = fwrite(rec.m_buffer, sizeof(log_record_t), (size_t)rec.m_buffered, (FILE*)rec.m_file);
+            const bool   ok      = written == (size_t)rec.m_buffered;
+            rec.m_recordCount += (u64)written;
+            rec.m_failed   = rec.m_failed || !ok;
+            rec.m_buffered = 0;
+            return ok;
+        }
+
+        bool open(log_recorder_t& rec, const char* path)
+        {
+            rec.m_recordCount = 0;
+            rec.m_buffered    = 0;
+            rec.m_failed      = false;
+            rec.m_file        = fopen(path, "wb");
+            if (rec.m_file == nullptr)
+                return false;
+            rec.m_failed = !writeHeader((FILE*)rec.m_file, 0);
+            return !rec.m_failed;
+        }
+
+        bool record(log_recorder_t& rec, u64 timestamp, u16 sensorId, const target_t targets[], i32 count)
+        {
+            if (rec.m_file == nullptr)
+                return false;
+            encode(rec.m_buffer[rec.m_buffered++], timestamp, sensorId, targets, count);
+            return (rec.m_buffered < RD03D_LOG_BUFFER_RECORDS) ? true : flush(rec);
+        }
+
+        bool close(log_recorder_t& rec)
+        {
+            if (rec.m_file == nullptr)
+                return false;
+            flush(rec);
+
+            // Patch the number of written records into the header now that it is known
+            FILE* f    = (FILE*)rec.m_file;
+            rec.m_file = nullptr;
+            bool ok    = fseek(f, 0, SEEK_SET) == 0 && writeHeader(f, rec.m_recordCount);
+            ok         = (fclose(f) == 0) && ok;
+            return ok && !rec.m_failed;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Memory mapping
+        // ----------------------------------------------------------------------------
+
+        bool map(log_file_t& file, const char* path)
+        {
+            file.m_data    = nullptr;
+            file.m_size    = 0;
+            file.m_handle  = nullptr;
+            file.m_handle2 = nullptr;
+#if defined(_WIN32)
+            HANDLE h = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (h == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(h, &size) || size.QuadPart == 0)
+            {
+                CloseHandle(h);
+                return false;
+            }
+            HANDLE m = CreateFileMappingA(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m == nullptr)
+            {
+                CloseHandle(h);
+                return false;
+            }
+            file.m_data = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+            if (file.m_data == nullptr)
+            {
+                CloseHandle(m);
+                CloseHandle(h);
+                return false;
+            }
+            file.m_size    = (u64)size.QuadPart;
+            file.m_handle  = m;
+            file.m_handle2 = h;
+            return true;
+#else
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+            void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // the mapping keeps the file referenced
+            if (data == MAP_FAILED)
+                return false;
+            madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+            file.m_data = data;
+            file.m_size = (u64)st.st_size;
+            return true;
+#endif
+        }
+
+        void unmap(log_file_t& file)
+        {
+            if (file.m_data == nullptr)
+                return;
+#if defined(_WIN32)
+            UnmapViewOfFile(file.m_data);
+            CloseHandle((HANDLE)file.m_handle);
+            CloseHandle((HANDLE)file.m_handle2);
+#else
+            munmap((void*)file.m_data, (size_t)file.m_size);
+#endif
+            file.m_data    = nullptr;
+            file.m_size    = 0;
+            file.m_handle  = nullptr;
+            file.m_handle2 = nullptr;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Replay
+        // ----------------------------------------------------------------------------
+
+        static u64 replayShard(const log_view_t& view, rd03d_t* trackers, i32 sensorCount, i32 shard, i32 shardCount)
+        {
+            u64      frames = 0;
+            target_t targets[MAX_TARGETS];
+            for (u64 i = 0; i < view.m_recordCount; ++i)
+            {
+                const log_record_t& r = record(view, i);
+                if (r.m_sensorId >= sensorCount || (r.m_sensorId % shardCount) != shard)
+                    continue;
+                const i32 count = decode(r, targets);
+                if (r.m_timestamp != 0)
+                    processFrame(trackers[r.m_sensorId], targets, count, r.m_timestamp);
+                else
+                    processFrame(trackers[r.m_sensorId], targets, count);
+                ++frames;
+            }
+            return frames;
+        }
+
+        static replay_stats_t makeStats(u64 frames, std::chrono::steady_clock::time_point start)
+        {
+            replay_stats_t stats;
+            stats.m_frames          = frames;
+            stats.m_seconds         = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+            stats.m_framesPerSecond = (stats.m_seconds > 0.0) ? ((f64)frames / stats.m_seconds) : 0.0;
+            return stats;
+        }
+
+        replay_stats_t replay(const log_view_t& view, rd03d_t& rd, u16 sensorId)
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            u64      frames = 0;
+            target_t targets[MAX_TARGETS];
+            for (u64 i = 0; i < view.m_recordCount; ++i)
+            {
+                const log_record_t& r = record(view, i);
+                if (r.m_sensorId != sensorId)
+                    continue;
+                const i32 count = decode(r, targets);
+                if (r.m_timestamp != 0)
+                    processFrame(rd, targets, count, r.m_timestamp);
+                else
+                    processFrame(rd, targets, count);
+                ++frames;
+            }
+            return makeStats(frames, start);
+        }
+
+        replay_stats_t replay(const log_view_t& view, rd03d_t* trackers, i32 sensorCount, i32 threadCount)
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            threadCount = (threadCount < 1) ? 1 : threadCount;
+            threadCount = (threadCount > sensorCount) ? sensorCount : threadCount;
+            if (threadCount <= 1)
+                return makeStats(replayShard(view, trackers, sensorCount, 0, 1), start);
+
+            enum
+            {
+                MAX_THREADS = 64
+            };
+            threadCount = (threadCount > MAX_THREADS) ? (i32)MAX_THREADS : threadCount;
+
+            std::thread threads[MAX_THREADS];
+            u64         frames[MAX_THREADS];
+            for (i32 t = 1; t < threadCount; ++t)
+                threads[t] = std::thread([&view, trackers, sensorCount, t, threadCount, &frames]() { frames[t] = replayShard(view, trackers, sensorCount, t, threadCount); });
+            frames[0] = replayShard(view, trackers, sensorCount, 0, threadCount);
+
+            u64 total = frames[0];
+            for (i32 t = 1; t < threadCount; ++t)
+            {
+                threads[t].join();
+                total += frames[t];
+            }
+            return makeStats(total, start);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
@@ -0,0 +1,77 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_parser.h"
+
+#include "ccore/c_debug.h"
+#include "ccore/c_math.h"
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        static inline u32 byteAt(const rd03d_parser_t& p, u32 pos) { return p.m_buffer[pos & p.m_mask]; }
+
+        static inline u32 u16At(const rd03d_parser_t& p, u32 pos) { return byteAt(p, pos) | (byteAt(p, pos + 1) << 8); }
+
+        bool next(rd03d_parser_t& p, u32 write, target_t targets[MAX_TARGETS])
+        {
+            while ((write - p.m_read) >= (u32)RD03D_FRAME_SIZE)
+            {
+                const u32 pos = p.m_read;
+                if (byteAt(p, pos) != 0xAA || byteAt(p, pos + 1) != 0xFF || byteAt(p, pos + 2) != 0x03 || byteAt(p, pos + 3) != 0x00 || byteAt(p, pos + 28) != 0x55 || byteAt(p, pos + 29) != 0xCC)
+                {
+                    // Out of sync, try the next byte
+                    p.m_read += 1;
+                    p.m_skipped += 1;
+                    continue;
+                }
+
+                for (i32 i = 0; i < MAX_TARGETS; ++i)
+                {
+                    const u32 t      = pos + RD03D_HEADER_SIZE + (u32)(i * RD03D_TARGET_SIZE);
+                    const u32 rawX   = u16At(p, t);
+                    const u32 rawY   = u16At(p, t + 2);
+                    const u32 rawV   = u16At(p, t + 4);
+                    const u32 rawRes = u16At(p, t + 6);
+
+                    target_t& target  = targets[i];
+                    target.m_id       = (u8)(i + 1);
+                    target.m_detected = (rawX | rawY | rawV | rawRes) != 0;
+                    if (target.m_detected)
+                    {
+                        const f32 x       = (f32)rd03d_decode_field(rawX) * 0.001f;  // mm -> m
+                        const f32 y       = (f32)rd03d_decode_field(rawY) * 0.001f;
+                        target.m_distance = sqrtf(x * x + y * y);
+                        target.m_angle    = atan2f(x, y) * (180.0f / math::PI);
+                        target.m_speed    = (f32)rd03d_decode_field(rawV) * 0.01f;  // cm/s -> m/s
+                    }
+                    else
+                    {
+                        target.m_distance = 0.0f;
+                        target.m_angle    = 0.0f;
+                        target.m_speed    = 0.0f;
+                    }
+                }
+
+                p.m_read += RD03D_FRAME_SIZE;
+                p.m_frames += 1;
+                return true;
+            }
+            return false;
+        }
+
+        i32 parse(rd03d_parser_t& p, u32 write, rd03d_t& rd)
+        {
+            i32      frames = 0;
+            target_t targets[MAX_TARGETS];
+            while (next(p, write, targets))
+            {
+                processFrame(rd, targets, MAX_TARGETS);
+                ++frames;
+            }
+            return frames;
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
@@ -0,0 +1,44 @@
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_pipeline.h"
+
+#include "ccore/c_debug.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        void setup(rd03d_pipeline_t& p, f32 dt, i32 maxMissedFrames)
+        {
+            setup(p.m_queue);
+            setup(p.m_snapshot);
+            setup(p.m_rd, dt, maxMissedFrames);
+            p.m_frames = 0;
+        }
+
+        i32 process(rd03d_pipeline_t& p)
+        {
+            i32           frames    = 0;
+            u64           timestamp = 0;
+            rd03d_frame_t frame;
+            while (pop(p.m_queue, frame))
+            {
+                if (frame.m_timestamp != 0)
+                    processFrame(p.m_rd, frame.m_targets, frame.m_count, frame.m_timestamp);
+                else
+                    processFrame(p.m_rd, frame.m_targets, frame.m_count);
+                timestamp = frame.m_timestamp;
+                ++frames;
+            }
+
+            if (frames > 0)
+            {
+                p.m_frames += (u64)frames;
+                rd03d_state_t state;
+                getState(p.m_rd, p.m_frames, timestamp, state);
+                publish(p.m_snapshot, state);
+            }
+            return frames;
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
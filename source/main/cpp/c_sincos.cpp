@@ -0,0 +1,66 @@
+#include "ckalman/c_sincos.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // sin(i degrees) for i = 0..91 (91 so the interpolation at 90 degrees stays in the table)
+        static const f32 s_sinTable[92] = {
+            0.000000000f, 0.017452406f, 0.034899497f, 0.052335956f, 0.069756474f, 0.087155743f, 0.104528463f, 0.121869343f,
+            0.139173101f, 0.156434465f, 0.173648178f, 0.190808995f, 0.207911691f, 0.224951054f, 0.241921896f, 0.258819045f,
+            0.275637356f, 0.292371705f, 0.309016994f, 0.325568154f, 0.342020143f, 0.358367950f, 0.374606593f, 0.390731128f,
+            0.406736643f, 0.422618262f, 0.438371147f, 0.453990500f, 0.469471563f, 0.484809620f, 0.500000000f, 0.515038075f,
+            0.529919264f, 0.544639035f, 0.559192903f, 0.573576436f, 0.587785252f, 0.601815023f, 0.615661475f, 0.629320391f,
+            0.642787610f, 0.656059029f, 0.669130606f, 0.681998360f, 0.694658370f, 0.707106781f, 0.719339800f, 0.731353702f,
+            0.743144825f, 0.754709580f, 0.766044443f, 0.777145961f, 0.788010754f, 0.798635510f, 0.809016994f, 0.819152044f,
+            0.829037573f, 0.838670568f, 0.848048096f, 0.857167301f, 0.866025404f, 0.874619707f, 0.882947593f, 0.891006524f,
+            0.898794046f, 0.906307787f, 0.913545458f, 0.920504853f, 0.927183855f, 0.933580426f, 0.939692621f, 0.945518576f,
+            0.951056516f, 0.956304756f, 0.961261696f, 0.965925826f, 0.970295726f, 0.974370065f, 0.978147601f, 0.981627183f,
+            0.984807753f, 0.987688341f, 0.990268069f, 0.992546152f, 0.994521895f, 0.996194698f, 0.997564050f, 0.998629535f,
+            0.999390827f, 0.999847695f, 1.000000000f, 0.999847695f,
+        };
+
+        // sin of r in [0, 90] degrees
+        static inline f32 sinTable(f32 r)
+        {
+            const i32 i = (i32)r;
+            const f32 f = r - (f32)i;
+            return s_sinTable[i] + f * (s_sinTable[i + 1] - s_sinTable[i]);
+        }
+
+        namespace nsincos
+        {
+            void sincosLut(f32 degrees, f32& s, f32& c)
+            {
+                // Reduce to [0, 360) and a quadrant, conversions instead of floorf()
+                f32 a = degrees - (f32)(i32)(degrees * (1.0f / 360.0f)) * 360.0f;
+                a     = (a < 0.0f) ? a + 360.0f : a;
+                i32 q = (i32)(a * (1.0f / 90.0f));
+                q     = (q > 3) ? 3 : q;
+
+                const f32 r  = a - (f32)q * 90.0f;  // [0, 90]
+                const f32 sr = sinTable(r);
+                const f32 cr = sinTable(90.0f - r);
+                switch (q)
+                {
+                    case 0: s = sr; c = cr; break;
+                    case 1: s = cr; c = -sr; break;
+                    case 2: s = -sr; c = -cr; break;
+                    default: s = -cr; c = sr; break;
+                }
+            }
+        }  // namespace nsincos
+
+        void polarToCartesianLut(const f32 distance[], const f32 angle[], i32 count, f32 x[], f32 y[])
+        {
+            for (i32 i = 0; i < count; ++i)
+            {
+                f32 s, c;
+                nsincos::sincosLut(angle[i], s, c);
+                x[i] = distance[i] * s;
+                y[i] = distance[i] * c;
+            }
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
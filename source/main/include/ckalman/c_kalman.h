@@ -9,31 +9,88 @@ namespace ncore
 {
     namespace nkalman
     {
-        template <i32 ROWS, i32 COLS>
+        // ----------------------------------------------------------------------------
+        // Scalar type
+        // ----------------------------------------------------------------------------
+        // matrix_t and the filters are templated on their scalar type T (f32 by default). T needs the
+        // arithmetic and comparison operators, construction from an f32 constant (T(0), T(1)) and a
+        // scalar_traits_t<T> specialization that provides:
+        //   acc_t                        multiply-accumulate register type
+        //   to_acc(a)                    load a scalar into an accumulator
+        //   mac(acc, a, b)               acc + a * b
+        //   msc(acc, a, b)               acc - a * b
+        //   from_acc(acc)                accumulator back to a scalar
+        //   reciprocal(a)                1 / a (a != 0)
+        // f32 and f64 are specialized below, see c_kalman_fixed.h for the fixed-point (Q16.16 / Q8.24) scalar types.
+
+        template <typename T>
+        struct scalar_traits_t;
+
+        template <>
+        struct scalar_traits_t<f32>
+        {
+            typedef f32 acc_t;
+
+            static constexpr acc_t to_acc(f32 a) { return a; }
+            static constexpr acc_t mac(acc_t acc, f32 a, f32 b) { return acc + a * b; }
+            static constexpr acc_t msc(acc_t acc, f32 a, f32 b) { return acc - a * b; }
+            static constexpr f32   from_acc(acc_t acc) { return acc; }
+            static constexpr f32   reciprocal(f32 a) { return 1.0f / a; }
+        };
+
+        template <>
+        struct scalar_traits_t<f64>
+        {
+            typedef f64 acc_t;
+
+            static constexpr acc_t to_acc(f64 a) { return a; }
+            static constexpr acc_t mac(acc_t acc, f64 a, f64 b) { return acc + a * b; }
+            static constexpr acc_t msc(acc_t acc, f64 a, f64 b) { return acc - a * b; }
+            static constexpr f64   from_acc(acc_t acc) { return acc; }
+            static constexpr f64   reciprocal(f64 a) { return 1.0 / a; }
+        };
+
+        // Base of the matrix expressions of c_kalman_expr.h
+        template <typename E>
+        struct expr_t;
+
+        // Every operation is constexpr, so models and constants can be computed at compile time
+        // (see c_kalman_model.h). A matrix_t used in a constant expression has to be initialized: matrix_t<N, N> m = {};
+        template <i32 ROWS, i32 COLS, typename T = f32>
         struct matrix_t
         {
-            f32 data[ROWS][COLS];
+            typedef scalar_traits_t<T> traits_t;
+
+            T data[ROWS][COLS];
 
-            void setIdentity()
+            // Evaluates an expression of matrices (operators of c_kalman_expr.h) into this matrix in one loop
+            template <typename E>
+            matrix_t& operator=(const expr_t<E>& e)
+            {
+                assign(*this, static_cast<const E&>(e));
+                return *this;
+            }
+
+            constexpr void setIdentity()
             {
                 for (i32 i = 0; i < ROWS; ++i)
                 {
                     for (i32 j = 0; j < COLS; ++j)
                     {
-                        data[i][j] = (i == j) ? 1.0f : 0.0f;
+                        data[i][j] = (i == j) ? T(1) : T(0);
                     }
                 }
             }
 
-            void clear()
+            constexpr void clear()
             {
                 for (i32 i = 0; i < ROWS; ++i)
                     for (i32 j = 0; j < COLS; ++j)
-                        data[i][j] = 0.0f;
+                        data[i][j] = T(0);
             }
 
             // matrix_t Addition: Out = This + Other
-            void add(const matrix_t<ROWS, COLS>& other, matrix_t<ROWS, COLS>& out) const
+            constexpr void add(const matrix_t<ROWS, COLS, T>& other, matrix_t<ROWS, COLS, T>& out) const
             {
                 for (i32 i = 0; i < ROWS; ++i)
                 {
@@ -45,7 +102,7 @@ namespace ncore
             }
 
             // matrix_t Subtraction: Out = This - Other
-            void subtract(const matrix_t<ROWS, COLS>& other, matrix_t<ROWS, COLS>& out) const
+            constexpr void subtract(const matrix_t<ROWS, COLS, T>& other, matrix_t<ROWS, COLS, T>& out) const
             {
                 for (i32 i = 0; i < ROWS; ++i)
                 {
@@ -58,23 +115,24 @@ namespace ncore
 
             // matrix_t Multiplication: Out (ROWS x OTHERCOLS) = This (ROWS x COLS) * Other (COLS x OTHERCOLS)
             template <i32 OTHERCOLS>
-            void multiply(const matrix_t<COLS, OTHERCOLS>& other, matrix_t<ROWS, OTHERCOLS>& out) const
+            constexpr void multiply(const matrix_t<COLS, OTHERCOLS, T>& other, matrix_t<ROWS, OTHERCOLS, T>& out) const
             {
-                out.clear();
                 for (i32 i = 0; i < ROWS; ++i)
                 {
                     for (i32 j = 0; j < OTHERCOLS; ++j)
                     {
+                        typename traits_t::acc_t sum = traits_t::to_acc(T(0));
                         for (i32 k = 0; k < COLS; ++k)
                         {
-                            out.data[i][j] += this->data[i][k] * other.data[k][j];
+                            sum = traits_t::mac(sum, this->data[i][k], other.data[k][j]);
                         }
+                        out.data[i][j] = traits_t::from_acc(sum);
                     }
                 }
             }
 
             // Transpose: Out (COLS x ROWS) = This^T (ROWS x COLS)
-            void transpose(matrix_t<COLS, ROWS>& out) const
+            constexpr void transpose(matrix_t<COLS, ROWS, T>& out) const
             {
                 for (i32 i = 0; i < ROWS; ++i)
                 {
@@ -85,20 +143,21 @@ namespace ncore
                 }
             }
 
-            // Deterministic Stack Inversion (Supports up to 3x3 matrices)
-            void invert(matrix_t<ROWS, COLS>& out) const
+            // Deterministic Stack Inversion (closed form up to 3x3, Gauss-Jordan with partial pivoting above)
+            // A singular matrix larger than 3x3 results in a zero matrix.
+            constexpr void invert(matrix_t<ROWS, COLS, T>& out) const
             {
                 static_assert(ROWS == COLS, "Inversion requires a square matrix!");
                 out.clear();
 
                 if (ROWS == 1)
                 {
-                    out.data[0][0] = (data[0][0] != 0.0f) ? (1.0f / data[0][0]) : 1.0f;
+                    out.data[0][0] = (data[0][0] != T(0)) ? traits_t::reciprocal(data[0][0]) : T(1);
                 }
                 else if (ROWS == 2)
                 {
-                    f32 det        = data[0][0] * data[1][1] - data[0][1] * data[1][0];
-                    f32 invDet     = (det != 0.0f) ? (1.0f / det) : 1.0f;
+                    T det          = data[0][0] * data[1][1] - data[0][1] * data[1][0];
+                    T invDet       = (det != T(0)) ? traits_t::reciprocal(det) : T(1);
                     out.data[0][0] = data[1][1] * invDet;
                     out.data[0][1] = -data[0][1] * invDet;
                     out.data[1][0] = -data[1][0] * invDet;
@@ -106,8 +165,8 @@ namespace ncore
                 }
                 else if (ROWS == 3)
                 {
-                    f32 det    = data[0][0] * (data[1][1] * data[2][2] - data[1][2] * data[2][1]) - data[0][1] * (data[1][0] * data[2][2] - data[1][2] * data[2][0]) + data[0][2] * (data[1][0] * data[2][1] - data[1][1] * data[2][0]);
-                    f32 invDet = (det != 0.0f) ? (1.0f / det) : 1.0f;
+                    T det    = data[0][0] * (data[1][1] * data[2][2] - data[1][2] * data[2][1]) - data[0][1] * (data[1][0] * data[2][2] - data[1][2] * data[2][0]) + data[0][2] * (data[1][0] * data[2][1] - data[1][1] * data[2][0]);
+                    T invDet = (det != T(0)) ? traits_t::reciprocal(det) : T(1);
 
                     out.data[0][0] = (data[1][1] * data[2][2] - data[1][2] * data[2][1]) * invDet;
                     out.data[0][1] = (data[0][2] * data[2][1] - data[0][1] * data[2][2]) * invDet;
@@ -119,72 +178,375 @@ namespace ncore
                     out.data[2][1] = (data[0][1] * data[2][0] - data[0][0] * data[2][1]) * invDet;
                     out.data[2][2] = (data[0][0] * data[1][1] - data[0][1] * data[1][0]) * invDet;
                 }
+                else
+                {
+                    matrix_t<ROWS, COLS, T> a = *this;
+                    out.setIdentity();
+                    for (i32 c = 0; c < ROWS; ++c)
+                    {
+                        i32 pivot = c;
+                        for (i32 r = c + 1; r < ROWS; ++r)
+                        {
+                            const T v = a.data[r][c] < T(0) ? -a.data[r][c] : a.data[r][c];
+                            const T p = a.data[pivot][c] < T(0) ? -a.data[pivot][c] : a.data[pivot][c];
+                            if (v > p)
+                                pivot = r;
+                        }
+                        if (a.data[pivot][c] == T(0))
+                        {
+                            out.clear();
+                            return;
+                        }
+                        if (pivot != c)
+                        {
+                            for (i32 j = 0; j < COLS; ++j)
+                            {
+                                const T t0 = a.data[c][j];
+                                a.data[c][j] = a.data[pivot][j];
+                                a.data[pivot][j] = t0;
+                                const T t1 = out.data[c][j];
+                                out.data[c][j] = out.data[pivot][j];
+                                out.data[pivot][j] = t1;
+                            }
+                        }
+                        const T inv = traits_t::reciprocal(a.data[c][c]);
+                        for (i32 j = 0; j < COLS; ++j)
+                        {
+                            a.data[c][j] *= inv;
+                            out.data[c][j] *= inv;
+                        }
+                        for (i32 r = 0; r < ROWS; ++r)
+                        {
+                            if (r == c)
+                                continue;
+                            const T f = a.data[r][c];
+                            for (i32 j = 0; j < COLS; ++j)
+                            {
+                                a.data[r][j] -= f * a.data[c][j];
+                                out.data[r][j] -= f * out.data[c][j];
+                            }
+                        }
+                    }
+                }
+            }
+
+            // LDL^T decomposition of a symmetric positive definite matrix (only the lower triangle is read).
+            // The unit lower triangular L is stored below the diagonal of 'out', D on its diagonal.
+            // Returns false when a pivot is not positive (matrix not positive definite).
+            constexpr bool decomposeLDLT(matrix_t<ROWS, COLS, T>& out) const
+            {
+                static_assert(ROWS == COLS, "LDL^T decomposition requires a square matrix!");
+                for (i32 j = 0; j < ROWS; ++j)
+                {
+                    T d = data[j][j];
+                    for (i32 k = 0; k < j; ++k)
+                        d -= out.data[j][k] * out.data[j][k] * out.data[k][k];
+                    if (!(d > T(0)))
+                        return false;
+                    out.data[j][j] = d;
+                    const T inv_d  = traits_t::reciprocal(d);
+                    for (i32 i = j + 1; i < ROWS; ++i)
+                    {
+                        T l = data[i][j];
+                        for (i32 k = 0; k < j; ++k)
+                            l -= out.data[i][k] * out.data[j][k] * out.data[k][k];
+                        out.data[i][j] = l * inv_d;
+                        out.data[j][i] = T(0);
+                    }
+                }
+                return true;
+            }
+
+            // Solve A * X = B where 'this' holds the factors produced by decomposeLDLT() of A
+            template <i32 OTHERCOLS>
+            constexpr void solveLDLT(const matrix_t<ROWS, OTHERCOLS, T>& b, matrix_t<ROWS, OTHERCOLS, T>& out) const
+            {
+                for (i32 c = 0; c < OTHERCOLS; ++c)
+                {
+                    // L * w = b (forward)
+                    for (i32 i = 0; i < ROWS; ++i)
+                    {
+                        T sum = b.data[i][c];
+                        for (i32 k = 0; k < i; ++k)
+                            sum -= data[i][k] * out.data[k][c];
+                        out.data[i][c] = sum;
+                    }
+                    // D * v = w
+                    for (i32 i = 0; i < ROWS; ++i)
+                        out.data[i][c] /= data[i][i];
+                    // L^T * x = v (backward)
+                    for (i32 i = ROWS - 1; i >= 0; --i)
+                    {
+                        T sum = out.data[i][c];
+                        for (i32 k = i + 1; k < ROWS; ++k)
+                            sum -= data[k][i] * out.data[k][c];
+                        out.data[i][c] = sum;
+                    }
+                }
             }
         };
 
         // Simple 1D Kalman Filter Implementation
-        struct kalman_1D_t
+        template <typename T>
+        struct kalman_1D_of_t
         {
-            f32 q;  // process noise covariance
-            f32 r;  // measurement noise covariance
-            f32 p;  // estimation error covariance
-            f32 x;  // state estimate
-            f32 k;  // Kalman gain
+            typedef T value_t;
+
+            T q;  // process noise covariance
+            T r;  // measurement noise covariance
+            T p;  // estimation error covariance
+            T x;  // state estimate
+            T k;  // Kalman gain
         };
 
-        static inline void initialize(kalman_1D_t& kf, f32 processNoise = 0.01f, f32 measurementNoise = 0.1f, f32 estimationError = 1.0f)
+        typedef kalman_1D_of_t<f32> kalman_1D_t;
+
+        template <typename T>
+        static inline void initialize(kalman_1D_of_t<T>& kf, f32 processNoise = 0.01f, f32 measurementNoise = 0.1f, f32 estimationError = 1.0f)
         {
-            kf.q = (processNoise);
-            kf.r = (measurementNoise);
-            kf.p = (estimationError);
-            kf.x = (0.0f);
-            kf.k = (0.0f);
+            kf.q = T(processNoise);
+            kf.r = T(measurementNoise);
+            kf.p = T(estimationError);
+            kf.x = T(0);
+            kf.k = T(0);
         }
 
-        static inline void begin(kalman_1D_t& kf, f32 initialState, f32 initialError = 1.0f)
+        template <typename T>
+        static inline void begin(kalman_1D_of_t<T>& kf, typename kalman_1D_of_t<T>::value_t initialState, f32 initialError = 1.0f)
         {
             kf.x = initialState;
-            kf.p = initialError;
+            kf.p = T(initialError);
         }
 
-        static inline f32 update(kalman_1D_t& kf, f32 measurement)
+        template <typename T>
+        static inline T update(kalman_1D_of_t<T>& kf, typename kalman_1D_of_t<T>::value_t measurement)
         {
+            typedef scalar_traits_t<T> traits_t;
             kf.p = kf.p + kf.q;
-            kf.k = kf.p / (kf.p + kf.r);
+            kf.k = kf.p * traits_t::reciprocal(kf.p + kf.r);
             kf.x = kf.x + kf.k * (measurement - kf.x);
-            kf.p = (1.0f - kf.k) * kf.p;
+            kf.p = (T(1) - kf.k) * kf.p;
             return kf.x;
         }
 
-        static inline f32 getState(const kalman_1D_t& kf) { return kf.x; }
+        template <typename T>
+        static inline T getState(const kalman_1D_of_t<T>& kf) { return kf.x; }
 
         // ============================================================================
         // MULTI-VARIABLE MATRIX KALMAN FILTER (Refactored to use matrix_t functions)
         // ============================================================================
 
-        template <i32 N, i32 M>
+        // ----------------------------------------------------------------------------
+        // Structure policies for F and H
+        // ----------------------------------------------------------------------------
+        // kalman_nd_t takes a policy type for F and for H that declares their sparsity pattern
+        // at compile time. update() performs every product with F or H through the policy, so a
+        // structured model skips the multiply-adds with its known zero entries. The matrices are
+        // still stored (and filled by the user) in full; a policy only decides which entries it reads.
+        //
+        // Policy interface (A is a matrix_t, M is F or H):
+        //   mul(M, A, out)              out = M * A
+        //   mul_transposed(A, M, out)   out = A * M^T
+        // and for H policies additionally:
+        //   update_covariance(K, H, HP, P_pred, P)   P = (I - K * H) * P_pred, where HP = H * P_pred
+        // F policies that model time can provide (required by predict(kf, dt) and predict(kf, dt, steps)):
+        //   set_dt(F, dt)                            F for a frame interval of dt
+        //   predict_steps(Q, dt, k, F_k, Q_k)        F^k and the process noise accumulated over k steps
+
+        // No structure, every entry is used (the default)
+        struct model_dense_t
+        {
+            template <i32 R, i32 C, i32 OTHERCOLS, typename T>
+            static inline void mul(const matrix_t<R, C, T>& m, const matrix_t<C, OTHERCOLS, T>& a, matrix_t<R, OTHERCOLS, T>& out)
+            {
+                m.multiply(a, out);
+            }
+
+            template <i32 R, i32 C, i32 MR, typename T>
+            static inline void mul_transposed(const matrix_t<R, C, T>& a, const matrix_t<MR, C, T>& m, matrix_t<R, MR, T>& out)
+            {
+                for (i32 i = 0; i < R; ++i)
+                {
+                    for (i32 j = 0; j < MR; ++j)
+                    {
+                        typedef scalar_traits_t<T> traits_t;
+                        typename traits_t::acc_t   sum = traits_t::to_acc(T(0));
+                        for (i32 k = 0; k < C; ++k)
+                            sum = traits_t::mac(sum, a.data[i][k], m.data[j][k]);
+                        out.data[i][j] = traits_t::from_acc(sum);
+                    }
+                }
+            }
+
+            template <i32 N, i32 M, typename T>
+            static inline void update_covariance(const matrix_t<N, M, T>& K, const matrix_t<M, N, T>& H, const matrix_t<M, N, T>& /*HP*/, const matrix_t<N, N, T>& P_pred, matrix_t<N, N, T>& P)
+            {
+                matrix_t<N, N, T> KH;
+                K.multiply(H, KH);
+                matrix_t<N, N, T> I_KH;
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = 0; j < N; ++j)
+                        I_KH.data[i][j] = ((i == j) ? T(1) : T(0)) - KH.data[i][j];
+                I_KH.multiply(P_pred, P);
+            }
+        };
+
+        // Constant-velocity F for a state laid out as [positions(D), velocities(D)], N = 2 * D:
+        //   F = | I  dt*I |
+        //       | 0   I   |
+        // Only the dt entries F[i][i + D] are read, so per-axis dt values are supported.
+        struct model_constant_velocity_t
+        {
+            // F for a frame interval of 'dt'
+            template <i32 N, typename T>
+            static constexpr void set_dt(matrix_t<N, N, T>& F, T dt)
+            {
+                static_assert((N % 2) == 0, "constant velocity model requires N = 2 * D");
+                const i32 D = N / 2;
+                F.setIdentity();
+                for (i32 i = 0; i < D; ++i)
+                    F.data[i][i + D] = dt;
+            }
+
+            // F^k and Q_k = sum(F^j * Q * F^jT, j = 0..k-1) for k steps of 'dt', in closed form.
+            // F^j = | I  j*dt*I |, so with Q = | A  B | every term is
+            //       | 0    I    |              | B' C |
+            //   | A + j*dt*(B + B') + j^2*dt^2*C   B + j*dt*C |
+            //   | B' + j*dt*C                      C          |
+            // and the sums over j only need sum(j) = k(k-1)/2 and sum(j^2) = (k-1)k(2k-1)/6.
+            template <i32 N, typename T>
+            static inline void predict_steps(const matrix_t<N, N, T>& Q, f32 dt, i32 k, matrix_t<N, N, T>& F_k, matrix_t<N, N, T>& Q_k)
+            {
+                static_assert((N % 2) == 0, "constant velocity model requires N = 2 * D");
+                const i32 D = N / 2;
+                set_dt(F_k, T(dt * (f32)k));
+
+                const T s0 = T((f32)k);
+                const T s1 = T(dt * (f32)k * (f32)(k - 1) * 0.5f);
+                const T s2 = T(dt * dt * (f32)(k - 1) * (f32)k * (f32)(2 * k - 1) * (1.0f / 6.0f));
+                for (i32 i = 0; i < D; ++i)
+                {
+                    for (i32 j = 0; j < D; ++j)
+                    {
+                        const T a  = Q.data[i][j];
+                        const T b  = Q.data[i][j + D];
+                        const T bt = Q.data[i + D][j];
+                        const T c  = Q.data[i + D][j + D];
+
+                        Q_k.data[i][j]         = s0 * a + s1 * (b + bt) + s2 * c;
+                        Q_k.data[i][j + D]     = s0 * b + s1 * c;
+                        Q_k.data[i + D][j]     = s0 * bt + s1 * c;
+                        Q_k.data[i + D][j + D] = s0 * c;
+                    }
+                }
+            }
+
+            template <i32 N, i32 OTHERCOLS, typename T>
+            static inline void mul(const matrix_t<N, N, T>& F, const matrix_t<N, OTHERCOLS, T>& a, matrix_t<N, OTHERCOLS, T>& out)
+            {
+                static_assert((N % 2) == 0, "constant velocity model requires N = 2 * D");
+                const i32 D = N / 2;
+                for (i32 i = 0; i < D; ++i)
+                {
+                    const T dt = F.data[i][i + D];
+                    for (i32 c = 0; c < OTHERCOLS; ++c)
+                    {
+                        out.data[i][c]     = a.data[i][c] + dt * a.data[i + D][c];
+                        out.data[i + D][c] = a.data[i + D][c];
+                    }
+                }
+            }
+
+            template <i32 R, i32 N, typename T>
+            static inline void mul_transposed(const matrix_t<R, N, T>& a, const matrix_t<N, N, T>& F, matrix_t<R, N, T>& out)
+            {
+                static_assert((N % 2) == 0, "constant velocity model requires N = 2 * D");
+                const i32 D = N / 2;
+                for (i32 r = 0; r < R; ++r)
+                {
+                    for (i32 j = 0; j < D; ++j)
+                    {
+                        out.data[r][j]     = a.data[r][j] + a.data[r][j + D] * F.data[j][j + D];
+                        out.data[r][j + D] = a.data[r][j + D];
+                    }
+                }
+            }
+        };
+
+        // Selection H: row m of H is the unit vector picking state COLS[m], e.g. model_select_t<0, 1>
+        // measures state 0 and state 1 directly. The values stored in H are not read.
+        template <i32... COLS>
+        struct model_select_t
+        {
+            enum
+            {
+                ROWS = sizeof...(COLS)
+            };
+            static constexpr i32 column[ROWS] = {COLS...};
+
+            template <i32 N, i32 OTHERCOLS, typename T>
+            static inline void mul(const matrix_t<ROWS, N, T>&, const matrix_t<N, OTHERCOLS, T>& a, matrix_t<ROWS, OTHERCOLS, T>& out)
+            {
+                for (i32 m = 0; m < ROWS; ++m)
+                    for (i32 c = 0; c < OTHERCOLS; ++c)
+                        out.data[m][c] = a.data[column[m]][c];
+            }
+
+            template <i32 R, i32 N, typename T>
+            static inline void mul_transposed(const matrix_t<R, N, T>& a, const matrix_t<ROWS, N, T>&, matrix_t<R, ROWS, T>& out)
+            {
+                for (i32 r = 0; r < R; ++r)
+                    for (i32 m = 0; m < ROWS; ++m)
+                        out.data[r][m] = a.data[r][column[m]];
+            }
+
+            // P = P_pred - K * (H * P_pred), only N * M * N multiply-adds
+            template <i32 N, typename T>
+            static inline void update_covariance(const matrix_t<N, ROWS, T>& K, const matrix_t<ROWS, N, T>&, const matrix_t<ROWS, N, T>& HP, const matrix_t<N, N, T>& P_pred, matrix_t<N, N, T>& P)
+            {
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        typedef scalar_traits_t<T> traits_t;
+                        typename traits_t::acc_t   sum = traits_t::to_acc(P_pred.data[i][j]);
+                        for (i32 m = 0; m < ROWS; ++m)
+                            sum = traits_t::msc(sum, K.data[i][m], HP.data[m][j]);
+                        P.data[i][j] = traits_t::from_acc(sum);
+                    }
+                }
+            }
+        };
+
+        template <i32... COLS>
+        constexpr i32 model_select_t<COLS...>::column[model_select_t<COLS...>::ROWS];
+
+        template <i32 N, i32 M, typename FMODEL = model_dense_t, typename HMODEL = model_dense_t, typename T = f32>
         struct kalman_nd_t
         {
-            matrix_t<N, N> F;  // State transition
-            matrix_t<N, M> K;  // Kalman Gain
-            matrix_t<N, N> P;  // Estimate error covariance
-            matrix_t<N, N> Q;  // Process noise covariance
-            matrix_t<M, M> R;  // Measurement noise covariance
-            matrix_t<M, N> H;  // Measurement mapping
-            matrix_t<N, 1> x;  // State vector (represented as Nx1 matrix_t)
+            typedef T value_t;
+
+            matrix_t<N, N, T> F;  // State transition
+            matrix_t<N, M, T> K;  // Kalman Gain
+            matrix_t<N, N, T> P;  // Estimate error covariance
+            matrix_t<N, N, T> Q;  // Process noise covariance
+            matrix_t<M, M, T> R;  // Measurement noise covariance
+            matrix_t<M, N, T> H;  // Measurement mapping
+            matrix_t<N, 1, T> x;  // State vector (represented as Nx1 matrix_t)
         };
 
-        template <i32 N, i32 M>
-        static inline void initialize(kalman_nd_t<N, M>& kf)
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void initialize(kalman_nd_t<N, M, FM, HM, T>& kf)
         {
             kf.P.setIdentity();
             kf.Q.setIdentity();
             kf.R.setIdentity();
+            kf.K.clear();
             kf.x.clear();
         }
 
-        template <i32 N, i32 M>
-        static inline void begin(kalman_nd_t<N, M>& kf, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void begin(kalman_nd_t<N, M, FM, HM, T>& kf, const T initial_states[N], f32 initial_uncertainty = 1.0f)
         {
             // 1. Set the initial tracking states
             for (i32 i = 0; i < N; ++i)
@@ -196,70 +558,493 @@ namespace ncore
             kf.P.setIdentity();
             for (i32 i = 0; i < N; ++i)
             {
-                kf.P.data[i][i] = initial_uncertainty;
+                kf.P.data[i][i] = T(initial_uncertainty);
+            }
+
+            // 3. No gain yet, the first correct() computes it from the new P
+            kf.K.clear();
+        }
+
+        // ----------------------------------------------------------------------------
+        // Predict / correct
+        // ----------------------------------------------------------------------------
+        // update() is predict() followed by correct(). Calling them separately allows a variable
+        // frame interval, several predictions without a measurement (coasting) or a prediction
+        // without any correction at all.
+
+        namespace nfilter
+        {
+            // The filter steps on separate model (F, H, Q, R) and state (x, P, K) matrices, so that a model
+            // does not have to be stored in every filter (kalman_track_t in c_kalman_model.h shares one).
+
+            // x = F * x, P = F * P * F^T + Q
+            template <typename FM, i32 N, typename T>
+            static inline void predict(const matrix_t<N, N, T>& F, const matrix_t<N, N, T>& Q, matrix_t<N, 1, T>& x, matrix_t<N, N, T>& P)
+            {
+                // x_pred = F * x
+                matrix_t<N, 1, T> x_pred;
+                FM::mul(F, x, x_pred);
+                x = x_pred;
+
+                // P_pred = F * P * F^T + Q
+                matrix_t<N, N, T> FP;
+                FM::mul(F, P, FP);
+                matrix_t<N, N, T> FP_FT;
+                FM::mul_transposed(FP, F, FP_FT);
+                FP_FT.add(Q, P);
+            }
+
+            // Measurement update of the predicted x and P with the innovation y already computed, writes
+            // the gain to K. Shared by the linear correct() and the extended filter (c_kalman_ekf.h).
+            template <typename HM, i32 N, i32 M, typename T, typename OBSERVER>
+            static inline void correct_innovation(const matrix_t<M, N, T>& H, const matrix_t<M, M, T>& R, const matrix_t<M, 1, T>& y, matrix_t<N, 1, T>& x, matrix_t<N, N, T>& P, matrix_t<N, M, T>& K, OBSERVER& observer)
+            {
+                const matrix_t<N, 1, T> x_pred = x;
+                const matrix_t<N, N, T> P_pred = P;
+
+                // S = H * P_pred * H^T + R
+                matrix_t<M, N, T> HP;
+                HM::mul(H, P_pred, HP);
+                matrix_t<M, M, T> HP_HT;
+                HM::mul_transposed(HP, H, HP_HT);
+                matrix_t<M, M, T> S;
+                HP_HT.add(R, S);
+
+                // K = P_pred * H^T * S^-1
+                if (M <= 3)
+                {
+                    matrix_t<M, M, T> S_inv;
+                    S.invert(S_inv);
+                    matrix_t<N, M, T> P_HT;
+                    HM::mul_transposed(P_pred, H, P_HT);
+                    P_HT.multiply(S_inv, K);
+                }
+                else
+                {
+                    // K^T = S^-1 * (H * P_pred), solved through LDL^T instead of inverting S. When S is not
+                    // positive definite (R not positive definite, P lost its symmetry), K^T falls back to the
+                    // pivoting inverse S^-1 * (H * P_pred).
+                    matrix_t<M, M, T> LD;
+                    matrix_t<M, N, T> K_trans;
+                    if (S.decomposeLDLT(LD))
+                    {
+                        LD.solveLDLT(HP, K_trans);
+                    }
+                    else
+                    {
+                        matrix_t<M, M, T> S_inv;
+                        S.invert(S_inv);
+                        S_inv.multiply(HP, K_trans);
+                    }
+                    K_trans.transpose(K);
+                }
+                observer(y, S, K);
+
+                // x = x_pred + K * y
+                matrix_t<N, 1, T> Ky;
+                K.multiply(y, Ky);
+                x_pred.add(Ky, x);
+
+                // P = (I - K * H) * P_pred
+                HM::update_covariance(K, H, HP, P_pred, P);
             }
+
+            // Measurement update of the predicted x and P, writes the gain to K, see correct(kf, measurement, observer)
+            template <typename HM, i32 N, i32 M, typename T, typename OBSERVER>
+            static inline void correct(const matrix_t<M, N, T>& H, const matrix_t<M, M, T>& R, const T measurement[M], matrix_t<N, 1, T>& x, matrix_t<N, N, T>& P, matrix_t<N, M, T>& K, OBSERVER& observer)
+            {
+                // Wrap raw array into our reusable matrix_t object for computations
+                matrix_t<M, 1, T> z;
+                for (i32 i = 0; i < M; ++i)
+                    z.data[i][0] = measurement[i];
+
+                // y = z - H * x_pred
+                matrix_t<M, 1, T> H_xpred;
+                HM::mul(H, x, H_xpred);
+                matrix_t<M, 1, T> y;
+                z.subtract(H_xpred, y);
+
+                correct_innovation<HM>(H, R, y, x, P, K, observer);
+            }
+        }  // namespace nfilter
+
+        // Time update with the current F: x = F * x, P = F * P * F^T + Q
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void predict(kalman_nd_t<N, M, FM, HM, T>& kf)
+        {
+            nfilter::predict<FM>(kf.F, kf.Q, kf.x, kf.P);
         }
 
-        template <i32 N, i32 M>
-        static inline void update(kalman_nd_t<N, M>& kf, const f32 measurement[M])
+        // Time update over 'dt' seconds, F is rebuilt for dt (and kept for the next predict/update).
+        // Requires an F policy with set_dt(), e.g. model_constant_velocity_t.
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void predict(kalman_nd_t<N, M, FM, HM, T>& kf, f32 dt)
         {
-            // Wrap raw array into our reusable matrix_t object for computations
-            matrix_t<M, 1> z;
-            for (i32 i = 0; i < M; ++i)
-                z.data[i][0] = measurement[i];
+            FM::set_dt(kf.F, T(dt));
+            predict(kf);
+        }
+
+        // 'steps' time updates of 'dt' seconds each in one step: same result as calling predict(kf, dt)
+        // 'steps' times, but with the cost of a single prediction. F^steps and the accumulated process
+        // noise sum(F^j * Q * F^jT, j = 0..steps-1) come from closed forms of the F policy (predict_steps()).
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void predict(kalman_nd_t<N, M, FM, HM, T>& kf, f32 dt, i32 steps)
+        {
+            if (steps <= 0)
+                return;
+
+            FM::set_dt(kf.F, T(dt));
+            if (steps == 1)
+            {
+                predict(kf);
+                return;
+            }
+
+            matrix_t<N, N, T> F_k;
+            matrix_t<N, N, T> Q_k;
+            FM::predict_steps(kf.Q, dt, steps, F_k, Q_k);
+
+            nfilter::predict<FM>(F_k, Q_k, kf.x, kf.P);
+        }
+
+        // Observer of correct() that ignores everything, see correct(kf, measurement, observer)
+        struct innovation_ignore_t
+        {
+            template <i32 N, i32 M, typename T>
+            inline void operator()(const matrix_t<M, 1, T>&, const matrix_t<M, M, T>&, const matrix_t<N, M, T>&) const
+            {
+            }
+        };
+
+        // Measurement update of the predicted state. 'observer(y, S, K)' is called with the innovation
+        // y = z - H x_pred, its covariance S = H P_pred H^T + R and the new gain K, values that are
+        // otherwise only temporaries of the update (used by the telemetry in c_kalman_telemetry.h).
+        template <i32 N, i32 M, typename FM, typename HM, typename T, typename OBSERVER>
+        static inline void correct(kalman_nd_t<N, M, FM, HM, T>& kf, const T measurement[M], OBSERVER& observer)
+        {
+            nfilter::correct<HM>(kf.H, kf.R, measurement, kf.x, kf.P, kf.K, observer);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void correct(kalman_nd_t<N, M, FM, HM, T>& kf, const T measurement[M])
+        {
+            innovation_ignore_t ignore;
+            correct(kf, measurement, ignore);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void update(kalman_nd_t<N, M, FM, HM, T>& kf, const T measurement[M])
+        {
+            predict(kf);
+            correct(kf, measurement);
+        }
+
+        // ============================================================================
+        // FUSED UPDATE (no temporaries, transposes or identity matrices)
+        // ============================================================================
+        // Same filter as update(), restructured for small fixed N and M:
+        // - all loops have compile-time trip counts and are unrolled by unroll_t
+        // - transposed operands are read with swapped indices instead of being copied
+        // - only the upper triangle of the symmetric products P_pred, S and P is computed
+        // - P = P_pred - K * (P_pred * H^T)^T replaces (I - K * H) * P_pred
+
+        template <i32 I, i32 END>
+        struct unroll_t
+        {
+            template <typename FN>
+            static inline void run(FN& fn)
+            {
+                fn(I);
+                unroll_t<I + 1, END>::run(fn);
+            }
+        };
+
+        template <i32 END>
+        struct unroll_t<END, END>
+        {
+            template <typename FN>
+            static inline void run(FN&)
+            {
+            }
+        };
+
+        namespace nfused
+        {
+            // Inverse of a symmetric M x M matrix given its upper triangle. Closed forms up to 3x3 with the same
+            // singular fallback as matrix_t::invert(), LDL^T above and matrix_t::invert() when not positive definite.
+            template <i32 M>
+            static inline void invert_symmetric(const f32 (&S)[M][M], f32 (&out)[M][M])
+            {
+                if (M == 1)
+                {
+                    out[0][0] = (S[0][0] != 0.0f) ? (1.0f / S[0][0]) : 1.0f;
+                }
+                else if (M == 2)
+                {
+                    const f32 det    = S[0][0] * S[1][1] - S[0][1] * S[0][1];
+                    const f32 invDet = (det != 0.0f) ? (1.0f / det) : 1.0f;
+                    out[0][0]        = S[1][1] * invDet;
+                    out[0][1]        = -S[0][1] * invDet;
+                    out[1][0]        = out[0][1];
+                    out[1][1]        = S[0][0] * invDet;
+                }
+                else if (M == 3)
+                {
+                    const f32 c00    = S[1][1] * S[2][2] - S[1][2] * S[1][2];
+                    const f32 c01    = S[0][2] * S[1][2] - S[0][1] * S[2][2];
+                    const f32 c02    = S[0][1] * S[1][2] - S[0][2] * S[1][1];
+                    const f32 det    = S[0][0] * c00 + S[0][1] * c01 + S[0][2] * c02;
+                    const f32 invDet = (det != 0.0f) ? (1.0f / det) : 1.0f;
+                    out[0][0]        = c00 * invDet;
+                    out[0][1]        = c01 * invDet;
+                    out[0][2]        = c02 * invDet;
+                    out[1][1]        = (S[0][0] * S[2][2] - S[0][2] * S[0][2]) * invDet;
+                    out[1][2]        = (S[0][2] * S[0][1] - S[0][0] * S[1][2]) * invDet;
+                    out[2][2]        = (S[0][0] * S[1][1] - S[0][1] * S[0][1]) * invDet;
+                    out[1][0]        = out[0][1];
+                    out[2][0]        = out[0][2];
+                    out[2][1]        = out[1][2];
+                }
+                else
+                {
+                    matrix_t<M, M> A;
+                    for (i32 i = 0; i < M; ++i)
+                        for (i32 j = i; j < M; ++j)
+                        {
+                            A.data[i][j] = S[i][j];
+                            A.data[j][i] = S[i][j];
+                        }
+
+                    matrix_t<M, M> LD;
+                    matrix_t<M, M> I;
+                    matrix_t<M, M> A_inv;
+                    I.setIdentity();
+                    if (A.decomposeLDLT(LD))
+                        LD.solveLDLT(I, A_inv);
+                    else
+                        A.invert(A_inv);
+                    for (i32 i = 0; i < M; ++i)
+                        for (i32 j = 0; j < M; ++j)
+                            out[i][j] = A_inv.data[i][j];
+                }
+            }
+        }  // namespace nfused
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update_fused(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M])
+        {
+            const f32(&F)[N][N] = kf.F.data;
+            const f32(&H)[M][N] = kf.H.data;
+            f32(&P)[N][N]       = kf.P.data;
+            f32(&K)[N][M]       = kf.K.data;
 
             // --- 1. PREDICT PHASE ---
             // x_pred = F * x
-            matrix_t<N, 1> x_pred;
-            kf.F.multiply(kf.x, x_pred);
-
-            // P_pred = F * P * F^T + Q
-            matrix_t<N, N> F_trans;
-            kf.F.transpose(F_trans);
-            matrix_t<N, N> FP;
-            kf.F.multiply(kf.P, FP);
-            matrix_t<N, N> FP_FT;
-            FP.multiply(F_trans, FP_FT);
-            matrix_t<N, N> P_pred;
-            FP_FT.add(kf.Q, P_pred);
+            f32  x_pred[N];
+            auto predict_x = [&](i32 i) {
+                f32  sum  = 0.0f;
+                auto term = [&](i32 k) { sum += F[i][k] * kf.x.data[k][0]; };
+                unroll_t<0, N>::run(term);
+                x_pred[i] = sum;
+            };
+            unroll_t<0, N>::run(predict_x);
+
+            // FP = F * P
+            f32  FP[N][N];
+            auto row_FP = [&](i32 i) {
+                auto col = [&](i32 j) {
+                    f32  sum  = 0.0f;
+                    auto term = [&](i32 k) { sum += F[i][k] * P[k][j]; };
+                    unroll_t<0, N>::run(term);
+                    FP[i][j] = sum;
+                };
+                unroll_t<0, N>::run(col);
+            };
+            unroll_t<0, N>::run(row_FP);
+
+            // P_pred = FP * F^T + Q (upper triangle, mirrored)
+            f32  Pp[N][N];
+            auto row_Pp = [&](i32 i) {
+                auto col = [&](i32 j) {
+                    if (j < i)
+                        return;
+                    f32  sum  = kf.Q.data[i][j];
+                    auto term = [&](i32 k) { sum += FP[i][k] * F[j][k]; };
+                    unroll_t<0, N>::run(term);
+                    Pp[i][j] = sum;
+                    Pp[j][i] = sum;
+                };
+                unroll_t<0, N>::run(col);
+            };
+            unroll_t<0, N>::run(row_Pp);
 
             // --- 2. MEASUREMENT UPDATE PHASE ---
             // y = z - H * x_pred
-            matrix_t<M, 1> H_xpred;
-            kf.H.multiply(x_pred, H_xpred);
-            matrix_t<M, 1> y;
-            z.subtract(H_xpred, y);
-
-            // S = H * P_pred * H^T + R
-            matrix_t<N, M> H_trans;
-            kf.H.transpose(H_trans);
-            matrix_t<M, N> HP;
-            kf.H.multiply(P_pred, HP);
-            matrix_t<M, M> HP_HT;
-            HP.multiply(H_trans, HP_HT);
-            matrix_t<M, M> S;
-            HP_HT.add(kf.R, S);
-
-            // K = P_pred * H^T * S^-1
-            matrix_t<M, M> S_inv;
-            S.invert(S_inv);
-            matrix_t<N, M> P_HT;
-            P_pred.multiply(H_trans, P_HT);
-            P_HT.multiply(S_inv, kf.K);
-
-            // x = x_pred + K * y
-            matrix_t<N, 1> Ky;
-            kf.K.multiply(y, Ky);
-            x_pred.add(Ky, kf.x);
-
-            // P = (I - K * H) * P_pred
-            matrix_t<N, N> I;
-            I.setIdentity();
-            matrix_t<N, N> KH;
-            kf.K.multiply(kf.H, KH);
-            matrix_t<N, N> I_KH;
-            I.subtract(KH, I_KH);
-            I_KH.multiply(P_pred, kf.P);
+            f32  y[M];
+            auto innovation = [&](i32 m) {
+                f32  sum  = 0.0f;
+                auto term = [&](i32 k) { sum += H[m][k] * x_pred[k]; };
+                unroll_t<0, N>::run(term);
+                y[m] = measurement[m] - sum;
+            };
+            unroll_t<0, M>::run(innovation);
+
+            // PHt = P_pred * H^T
+            f32  PHt[N][M];
+            auto row_PHt = [&](i32 i) {
+                auto col = [&](i32 m) {
+                    f32  sum  = 0.0f;
+                    auto term = [&](i32 k) { sum += Pp[i][k] * H[m][k]; };
+                    unroll_t<0, N>::run(term);
+                    PHt[i][m] = sum;
+                };
+                unroll_t<0, M>::run(col);
+            };
+            unroll_t<0, N>::run(row_PHt);
+
+            // S = H * PHt + R (upper triangle)
+            f32  S[M][M];
+            auto row_S = [&](i32 a) {
+                auto col = [&](i32 b) {
+                    if (b < a)
+                        return;
+                    f32  sum  = kf.R.data[a][b];
+                    auto term = [&](i32 k) { sum += H[a][k] * PHt[k][b]; };
+                    unroll_t<0, N>::run(term);
+                    S[a][b] = sum;
+                };
+                unroll_t<0, M>::run(col);
+            };
+            unroll_t<0, M>::run(row_S);
+
+            f32 S_inv[M][M];
+            nfused::invert_symmetric<M>(S, S_inv);
+
+            // K = PHt * S^-1 and x = x_pred + K * y
+            auto row_K = [&](i32 i) {
+                f32  Ky  = 0.0f;
+                auto col = [&](i32 m) {
+                    f32  sum  = 0.0f;
+                    auto term = [&](i32 b) { sum += PHt[i][b] * S_inv[b][m]; };
+                    unroll_t<0, M>::run(term);
+                    K[i][m] = sum;
+                    Ky += sum * y[m];
+                };
+                unroll_t<0, M>::run(col);
+                kf.x.data[i][0] = x_pred[i] + Ky;
+            };
+            unroll_t<0, N>::run(row_K);
+
+            // P = P_pred - K * PHt^T (upper triangle, mirrored)
+            auto row_P = [&](i32 i) {
+                auto col = [&](i32 j) {
+                    if (j < i)
+                        return;
+                    f32  sum  = Pp[i][j];
+                    auto term = [&](i32 m) { sum -= K[i][m] * PHt[j][m]; };
+                    unroll_t<0, M>::run(term);
+                    P[i][j] = sum;
+                    P[j][i] = sum;
+                };
+                unroll_t<0, N>::run(col);
+            };
+            unroll_t<0, N>::run(row_P);
+        }
+
+        // ============================================================================
+        // SEQUENTIAL (SCALAR) MEASUREMENT UPDATE
+        // ============================================================================
+        // For a diagonal R the M measurement components are independent and can be applied
+        // one after the other as scalar updates. Each one needs a single division instead of
+        // an M x M inverse, so this works for any M. Only the diagonal of R is used.
+        // Column m of K receives the gain that was applied for measurement component m.
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update_sequential(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M])
+        {
+            const f32(&F)[N][N] = kf.F.data;
+            const f32(&H)[M][N] = kf.H.data;
+            f32(&P)[N][N]       = kf.P.data;
+
+            // --- 1. PREDICT PHASE ---
+            // x = F * x
+            f32 x[N];
+            for (i32 i = 0; i < N; ++i)
+            {
+                f32 sum = 0.0f;
+                for (i32 k = 0; k < N; ++k)
+                    sum += F[i][k] * kf.x.data[k][0];
+                x[i] = sum;
+            }
+
+            // P = F * P * F^T + Q (upper triangle, mirrored)
+            f32 FP[N][N];
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = 0; j < N; ++j)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 k = 0; k < N; ++k)
+                        sum += F[i][k] * P[k][j];
+                    FP[i][j] = sum;
+                }
+            }
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = i; j < N; ++j)
+                {
+                    f32 sum = kf.Q.data[i][j];
+                    for (i32 k = 0; k < N; ++k)
+                        sum += FP[i][k] * F[j][k];
+                    P[i][j] = sum;
+                    P[j][i] = sum;
+                }
+            }
+
+            // --- 2. MEASUREMENT UPDATE PHASE, one scalar at a time ---
+            for (i32 m = 0; m < M; ++m)
+            {
+                // PHt = P * h^T, s = h * P * h^T + r
+                f32 PHt[N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 k = 0; k < N; ++k)
+                        sum += P[i][k] * H[m][k];
+                    PHt[i] = sum;
+                }
+                f32 s  = kf.R.data[m][m];
+                f32 hx = 0.0f;
+                for (i32 k = 0; k < N; ++k)
+                {
+                    s += H[m][k] * PHt[k];
+                    hx += H[m][k] * x[k];
+                }
+
+                const f32 inv_s = (s != 0.0f) ? (1.0f / s) : 1.0f;
+                const f32 y     = measurement[m] - hx;
+
+                // k = PHt / s, x += k * y, P -= k * PHt^T
+                f32 k[N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    k[i]            = PHt[i] * inv_s;
+                    kf.K.data[i][m] = k[i];
+                    x[i] += k[i] * y;
+                }
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = i; j < N; ++j)
+                    {
+                        const f32 v = P[i][j] - k[i] * PHt[j];
+                        P[i][j]     = v;
+                        P[j][i]     = v;
+                    }
+                }
+            }
+
+            for (i32 i = 0; i < N; ++i)
+                kf.x.data[i][0] = x[i];
         }
 
     }  // namespace nkalman
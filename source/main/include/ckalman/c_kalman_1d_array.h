@@ -0,0 +1,143 @@
+#ifndef __C_KALMAN_FILTER_1D_ARRAY_H__
+#define __C_KALMAN_FILTER_1D_ARRAY_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_simd.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // 1D KALMAN FILTER ARRAY ENGINE (Structure-of-Arrays)
+        // ============================================================================
+        // Runs the kalman_1D_t update over 'count' independent scalar channels whose
+        // q, r, p, x and k live in separate caller-owned arrays, a SIMD vector of channels
+        // at a time (AVX2, SSE2, NEON or scalar). No memory is allocated or copied.
+        //
+        // The optional 'converged' array (one u32 per channel, ~0u = converged) lets channels
+        // whose gain has settled skip the p/k recurrence: they only do x += k * (z - x).
+
+        struct kalman_1d_array_t
+        {
+            f32* q;          // process noise covariance, per channel
+            f32* r;          // measurement noise covariance, per channel
+            f32* p;          // estimation error covariance, per channel
+            f32* x;          // state estimate, per channel
+            f32* k;          // Kalman gain, per channel
+            u32* converged;  // optional (may be nullptr), ~0u when the channel's gain has converged
+            i32  count;      // number of channels
+        };
+
+        static inline void setup(kalman_1d_array_t& a, f32* q, f32* r, f32* p, f32* x, f32* k, u32* converged, i32 count)
+        {
+            a.q         = q;
+            a.r         = r;
+            a.p         = p;
+            a.x         = x;
+            a.k         = k;
+            a.converged = converged;
+            a.count     = count;
+        }
+
+        // Same as initialize(kalman_1D_t&) for every channel
+        static inline void initialize(kalman_1d_array_t& a, f32 processNoise = 0.01f, f32 measurementNoise = 0.1f, f32 estimationError = 1.0f)
+        {
+            for (i32 i = 0; i < a.count; ++i)
+            {
+                a.q[i] = processNoise;
+                a.r[i] = measurementNoise;
+                a.p[i] = estimationError;
+                a.x[i] = 0.0f;
+                a.k[i] = 0.0f;
+                if (a.converged)
+                    a.converged[i] = 0;
+            }
+        }
+
+        // Same as begin(kalman_1D_t&) for one channel, also clears its converged flag
+        static inline void begin(kalman_1d_array_t& a, i32 channel, f32 initialState, f32 initialError = 1.0f)
+        {
+            a.x[channel] = initialState;
+            a.p[channel] = initialError;
+            if (a.converged)
+                a.converged[channel] = 0;
+        }
+
+        namespace narray1d
+        {
+            template <typename V>
+            static inline void update_full(kalman_1d_array_t& a, const f32* z, i32 i)
+            {
+                typedef typename V::vec_t vec_t;
+                vec_t       p = V::add(V::load(&a.p[i]), V::load(&a.q[i]));
+                const vec_t k = V::div(p, V::add(p, V::load(&a.r[i])));
+                const vec_t x = V::load(&a.x[i]);
+                V::store(&a.x[i], V::add(x, V::mul(k, V::sub(V::load(&z[i]), x))));
+                p = V::mul(V::sub(V::set1(1.0f), k), p);
+                V::store(&a.p[i], p);
+                V::store(&a.k[i], k);
+            }
+
+            template <typename V>
+            static inline void update_converging(kalman_1d_array_t& a, const f32* z, i32 i, f32 tolerance)
+            {
+                typedef typename V::vec_t  vec_t;
+                typedef typename V::mask_t mask_t;
+
+                const mask_t done = V::load_mask(&a.converged[i]);
+                const vec_t  x    = V::load(&a.x[i]);
+                const vec_t  y    = V::sub(V::load(&z[i]), x);
+                if (V::all(done))
+                {
+                    // Every channel in this vector has a settled gain, skip the p/k recurrence
+                    V::store(&a.x[i], V::add(x, V::mul(V::load(&a.k[i]), y)));
+                    return;
+                }
+
+                const vec_t k_old = V::load(&a.k[i]);
+                const vec_t p_old = V::load(&a.p[i]);
+                vec_t       p     = V::add(p_old, V::load(&a.q[i]));
+                vec_t       k     = V::div(p, V::add(p, V::load(&a.r[i])));
+                p                 = V::mul(V::sub(V::set1(1.0f), k), p);
+
+                // Converged channels keep their gain and covariance
+                k = V::select(done, k_old, k);
+                p = V::select(done, p_old, p);
+                V::store(&a.p[i], p);
+                V::store(&a.x[i], V::add(x, V::mul(k, y)));
+                V::store(&a.k[i], k);
+                V::store_mask(&a.converged[i], V::mask_or(done, V::less(V::abs(V::sub(k, k_old)), V::set1(tolerance))));
+            }
+        }  // namespace narray1d
+
+        // Update every channel with measurement[i]; same math as update(kalman_1D_t&, f32)
+        static inline void update(kalman_1d_array_t& a, const f32* measurement)
+        {
+            typedef nsimd::f32xN_t V;
+            i32                    i = 0;
+            for (; i + V::WIDTH <= a.count; i += V::WIDTH)
+                narray1d::update_full<V>(a, measurement, i);
+            for (; i < a.count; ++i)
+                narray1d::update_full<nsimd::f32x1_t>(a, measurement, i);
+        }
+
+        // Update every channel, channels marked converged skip the p/k recurrence. A channel becomes
+        // converged when its gain changes by less than 'tolerance' in one update. Requires a.converged.
+        static inline void update_converging(kalman_1d_array_t& a, const f32* measurement, f32 tolerance = 1e-6f)
+        {
+            typedef nsimd::f32xN_t V;
+            i32                    i = 0;
+            for (; i + V::WIDTH <= a.count; i += V::WIDTH)
+                narray1d::update_converging<V>(a, measurement, i, tolerance);
+            for (; i < a.count; ++i)
+                narray1d::update_converging<nsimd::f32x1_t>(a, measurement, i, tolerance);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_1D_ARRAY_H__
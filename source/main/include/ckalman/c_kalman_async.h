@@ -0,0 +1,222 @@
+#ifndef __C_KALMAN_FILTER_ASYNC_H__
+#define __C_KALMAN_FILTER_ASYNC_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // TIMESTAMPED (ASYNCHRONOUS) KALMAN FILTER
+        // ============================================================================
+        // The filter carries the time of its state. A measurement predicts the state lazily to its own
+        // timestamp (F rebuilt for the elapsed time through the F policy, e.g. model_constant_velocity_t)
+        // and then corrects it, so irregular intervals cost nothing extra.
+        //
+        // Q is the process noise of an interval of m_qInterval seconds, a prediction over dt adds
+        // Q * dt / m_qInterval. Measurements with the same timestamp (several sensors) are corrected
+        // without any prediction in between.
+        //
+        // Every measurement is kept in a bounded history together with the state after it. An
+        // out-of-sequence measurement (older than the state) is inserted at its place in time: the
+        // filter restarts from the state before it and re-applies only the newer measurements in the
+        // history. Measurements older than the whole history are rejected. In-sequence measurements
+        // are O(1) in the history length, an out-of-sequence one is O(HISTORY).
+
+        template <i32 N, i32 M, typename FMODEL = model_constant_velocity_t, typename HMODEL = model_dense_t, i32 HISTORY = 16>
+        struct kalman_async_t
+        {
+            typedef kalman_nd_t<N, M, FMODEL, HMODEL> filter_t;
+
+            struct entry_t
+            {
+                u64            m_time;      // microseconds
+                bool           m_measured;  // false for the state given to begin()
+                f32            m_z[M];
+                matrix_t<N, 1> m_x;         // state after the measurement
+                matrix_t<N, N> m_P;
+            };
+
+            filter_t m_filter;         // F, Q, R, H and the state at m_time
+            u64      m_time;           // time of m_filter.x in microseconds
+            f32      m_qInterval;      // interval (seconds) that m_filter.Q belongs to
+            entry_t  m_history[HISTORY];
+            i32      m_first;          // oldest entry in the ring
+            i32      m_count;
+            u32      m_outOfSequence;  // out-of-sequence measurements applied
+            u32      m_rejected;       // measurements older than the history
+        };
+
+        namespace nasync
+        {
+            template <i32 N, i32 M, typename FM, typename HM, i32 H>
+            static inline typename kalman_async_t<N, M, FM, HM, H>::entry_t& entry(kalman_async_t<N, M, FM, HM, H>& af, i32 i)
+            {
+                return af.m_history[(af.m_first + i) % H];
+            }
+
+            // Time update of 'kf' over 'dt' seconds with the process noise scaled to dt
+            template <i32 N, i32 M, typename FM, typename HM>
+            static inline void predict(kalman_nd_t<N, M, FM, HM>& kf, f32 dt, f32 qInterval)
+            {
+                const matrix_t<N, N> Q     = kf.Q;
+                const f32            scale = dt / qInterval;
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = 0; j < N; ++j)
+                        kf.Q.data[i][j] = Q.data[i][j] * scale;
+                nkalman::predict(kf, dt);
+                kf.Q = Q;
+            }
+
+            template <i32 N, i32 M, typename FM, typename HM, i32 H>
+            static inline void advance(kalman_async_t<N, M, FM, HM, H>& af, u64 time)
+            {
+                if (time > af.m_time)
+                    predict(af.m_filter, (f32)(time - af.m_time) * 1e-6f, af.m_qInterval);
+                af.m_time = time;
+            }
+
+            template <i32 N, i32 M, typename FM, typename HM, i32 H>
+            static inline void store(kalman_async_t<N, M, FM, HM, H>& af, typename kalman_async_t<N, M, FM, HM, H>::entry_t& e)
+            {
+                e.m_x = af.m_filter.x;
+                e.m_P = af.m_filter.P;
+            }
+
+            // Appends an entry at the end of the history, the oldest one is dropped when it is full
+            template <i32 N, i32 M, typename FM, typename HM, i32 H>
+            static inline typename kalman_async_t<N, M, FM, HM, H>::entry_t& push(kalman_async_t<N, M, FM, HM, H>& af)
+            {
+                if (af.m_count == H)
+                {
+                    af.m_first = (af.m_first + 1) % H;
+                    af.m_count -= 1;
+                }
+                af.m_count += 1;
+                return entry(af, af.m_count - 1);
+            }
+        }  // namespace nasync
+
+        // F, Q, R and H still have to be set up, 'qInterval' is the interval in seconds that Q is given for
+        template <i32 N, i32 M, typename FM, typename HM, i32 H>
+        static inline void initialize(kalman_async_t<N, M, FM, HM, H>& af, f32 qInterval = 0.05f)
+        {
+            initialize(af.m_filter);
+            af.m_time          = 0;
+            af.m_qInterval     = qInterval;
+            af.m_first         = 0;
+            af.m_count         = 0;
+            af.m_outOfSequence = 0;
+            af.m_rejected      = 0;
+        }
+
+        // Starts the filter at 'time' (microseconds), the history only holds this state afterwards
+        template <i32 N, i32 M, typename FM, typename HM, i32 H>
+        static inline void begin(kalman_async_t<N, M, FM, HM, H>& af, u64 time, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            begin(af.m_filter, initial_states, initial_uncertainty);
+            af.m_time  = time;
+            af.m_first = 0;
+            af.m_count = 0;
+
+            typename kalman_async_t<N, M, FM, HM, H>::entry_t& e = nasync::push(af);
+            e.m_time                                              = time;
+            e.m_measured                                          = false;
+            nasync::store(af, e);
+        }
+
+        // Predicts the state to 'time' without a measurement (e.g. to draw a track between frames).
+        // A later measurement older than 'time' is handled as out-of-sequence.
+        template <i32 N, i32 M, typename FM, typename HM, i32 H>
+        static inline void predict(kalman_async_t<N, M, FM, HM, H>& af, u64 time)
+        {
+            nasync::advance(af, time);
+        }
+
+        // Applies the measurement 'z' taken at 'time' (microseconds). Returns false when it is older
+        // than everything in the history and was dropped.
+        template <i32 N, i32 M, typename FM, typename HM, i32 H>
+        static bool update(kalman_async_t<N, M, FM, HM, H>& af, u64 time, const f32 z[M])
+        {
+            typedef typename kalman_async_t<N, M, FM, HM, H>::entry_t entry_t;
+
+            // In sequence: lazy prediction to the measurement, correction and a new history entry
+            if (time >= af.m_time)
+            {
+                nasync::advance(af, time);
+                correct(af.m_filter, z);
+
+                entry_t& e   = nasync::push(af);
+                e.m_time     = time;
+                e.m_measured = true;
+                for (i32 i = 0; i < M; ++i)
+                    e.m_z[i] = z[i];
+                nasync::store(af, e);
+                return true;
+            }
+
+            // Out of sequence: the measurement goes after every entry that is not newer than it
+            i32 at = af.m_count;
+            while (at > 0 && nasync::entry(af, at - 1).m_time > time)
+                --at;
+            if (at == 0)
+            {
+                af.m_rejected += 1;
+                return false;
+            }
+
+            const u64 now = af.m_time;
+
+            // Restart from the state before the measurement (copied before the ring can drop it)
+            const entry_t& before = nasync::entry(af, at - 1);
+            af.m_filter.x         = before.m_x;
+            af.m_filter.P         = before.m_P;
+            af.m_time             = before.m_time;
+
+            // Make room at 'at', a full history drops its oldest entry
+            if (af.m_count == H)
+            {
+                af.m_first = (af.m_first + 1) % H;
+                af.m_count -= 1;
+                at -= 1;
+            }
+            af.m_count += 1;
+            for (i32 i = af.m_count - 1; i > at; --i)
+                nasync::entry(af, i) = nasync::entry(af, i - 1);
+
+            entry_t& e   = nasync::entry(af, at);
+            e.m_time     = time;
+            e.m_measured = true;
+            for (i32 i = 0; i < M; ++i)
+                e.m_z[i] = z[i];
+
+            // Re-apply the new measurement and every newer one
+            for (i32 i = at; i < af.m_count; ++i)
+            {
+                entry_t& r = nasync::entry(af, i);
+                nasync::advance(af, r.m_time);
+                if (r.m_measured)
+                    correct(af.m_filter, r.m_z);
+                nasync::store(af, r);
+            }
+
+            // The state may have been predicted beyond the last measurement
+            nasync::advance(af, now);
+            af.m_outOfSequence += 1;
+            return true;
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, i32 H>
+        static inline u64 getTime(const kalman_async_t<N, M, FM, HM, H>& af)
+        {
+            return af.m_time;
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_ASYNC_H__
@@ -0,0 +1,339 @@
+#ifndef __C_KALMAN_FILTER_BANK_H__
+#define __C_KALMAN_FILTER_BANK_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_simd.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // BATCHED KALMAN FILTER BANK (Structure-of-Arrays)
+        // ============================================================================
+        // Holds LANES independent kalman_nd_t<N,M> filters, every matrix element stored
+        // contiguously across the filters: P[i][j][lane]. A single update() call runs
+        // predict+correct for all active lanes, a SIMD vector of lanes at a time.
+        // The arithmetic follows the exact operation order of update(kalman_nd_t&),
+        // so each lane produces the same result as the single-filter path, bit for bit.
+        // That holds as long as the compiler does not contract a * b + c into a fused
+        // multiply-add: with FMA enabled (-mfma, -march=native, ARMv8) it contracts the
+        // scalar and the SIMD loops differently and the lanes differ from update() in
+        // the last bits. Build with -ffp-contract=off where bit equality matters.
+
+        template <i32 N, i32 M, i32 LANES>
+        struct alignas(32) kalman_bank_t
+        {
+            f32 F[N][N][LANES];  // State transition
+            f32 K[N][M][LANES];  // Kalman Gain
+            f32 P[N][N][LANES];  // Estimate error covariance
+            f32 Q[N][N][LANES];  // Process noise covariance
+            f32 R[M][M][LANES];  // Measurement noise covariance
+            f32 H[M][N][LANES];  // Measurement mapping
+            f32 x[N][LANES];     // State vector
+            u32 active[LANES];   // ~0u when the lane takes part in update(), 0 otherwise
+        };
+
+        template <i32 N, i32 M, i32 LANES>
+        static inline void initialize(kalman_bank_t<N, M, LANES>& bank)
+        {
+            for (i32 l = 0; l < LANES; ++l)
+            {
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        bank.F[i][j][l] = 0.0f;
+                        bank.P[i][j][l] = (i == j) ? 1.0f : 0.0f;
+                        bank.Q[i][j][l] = (i == j) ? 1.0f : 0.0f;
+                    }
+                    for (i32 j = 0; j < M; ++j)
+                    {
+                        bank.K[i][j][l] = 0.0f;
+                        bank.H[j][i][l] = 0.0f;
+                    }
+                    bank.x[i][l] = 0.0f;
+                }
+                for (i32 i = 0; i < M; ++i)
+                    for (i32 j = 0; j < M; ++j)
+                        bank.R[i][j][l] = (i == j) ? 1.0f : 0.0f;
+                bank.active[l] = 0;
+            }
+        }
+
+        // Copy a single filter (model + state) into a lane
+        template <i32 N, i32 M, i32 LANES, typename FM, typename HM>
+        static inline void set_filter(kalman_bank_t<N, M, LANES>& bank, i32 lane, const kalman_nd_t<N, M, FM, HM>& kf)
+        {
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = 0; j < N; ++j)
+                {
+                    bank.F[i][j][lane] = kf.F.data[i][j];
+                    bank.P[i][j][lane] = kf.P.data[i][j];
+                    bank.Q[i][j][lane] = kf.Q.data[i][j];
+                }
+                for (i32 j = 0; j < M; ++j)
+                {
+                    bank.K[i][j][lane] = kf.K.data[i][j];
+                    bank.H[j][i][lane] = kf.H.data[j][i];
+                }
+                bank.x[i][lane] = kf.x.data[i][0];
+            }
+            for (i32 i = 0; i < M; ++i)
+                for (i32 j = 0; j < M; ++j)
+                    bank.R[i][j][lane] = kf.R.data[i][j];
+        }
+
+        // Copy a lane back out into a single filter
+        template <i32 N, i32 M, i32 LANES, typename FM, typename HM>
+        static inline void get_filter(const kalman_bank_t<N, M, LANES>& bank, i32 lane, kalman_nd_t<N, M, FM, HM>& kf)
+        {
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = 0; j < N; ++j)
+                {
+                    kf.F.data[i][j] = bank.F[i][j][lane];
+                    kf.P.data[i][j] = bank.P[i][j][lane];
+                    kf.Q.data[i][j] = bank.Q[i][j][lane];
+                }
+                for (i32 j = 0; j < M; ++j)
+                {
+                    kf.K.data[i][j] = bank.K[i][j][lane];
+                    kf.H.data[j][i] = bank.H[j][i][lane];
+                }
+                kf.x.data[i][0] = bank.x[i][lane];
+            }
+            for (i32 i = 0; i < M; ++i)
+                for (i32 j = 0; j < M; ++j)
+                    kf.R.data[i][j] = bank.R[i][j][lane];
+        }
+
+        template <i32 N, i32 M, i32 LANES>
+        static inline void set_active(kalman_bank_t<N, M, LANES>& bank, i32 lane, bool active)
+        {
+            bank.active[lane] = active ? ~0u : 0u;
+        }
+
+        template <i32 N, i32 M, i32 LANES>
+        static inline bool is_active(const kalman_bank_t<N, M, LANES>& bank, i32 lane)
+        {
+            return bank.active[lane] != 0;
+        }
+
+        // Same as begin(kalman_nd_t&), for one lane; also marks the lane active
+        template <i32 N, i32 M, i32 LANES>
+        static inline void begin(kalman_bank_t<N, M, LANES>& bank, i32 lane, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            for (i32 i = 0; i < N; ++i)
+            {
+                bank.x[i][lane] = initial_states[i];
+                for (i32 j = 0; j < N; ++j)
+                    bank.P[i][j][lane] = (i == j) ? initial_uncertainty : 0.0f;
+            }
+            bank.active[lane] = ~0u;
+        }
+
+        namespace nbank
+        {
+            // Predict + correct for one group of V::WIDTH lanes starting at lane 'o'
+            template <typename V, i32 N, i32 M, i32 LANES>
+            static inline void update_group(kalman_bank_t<N, M, LANES>& b, const f32 (&z)[M][LANES], i32 o)
+            {
+                typedef typename V::vec_t vec_t;
+
+                const typename V::mask_t mask = V::load_mask(&b.active[o]);
+                if (!V::any(mask))
+                    return;
+
+                // --- 1. PREDICT PHASE ---
+                // x_pred = F * x
+                vec_t x_pred[N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    x_pred[i] = V::zero();
+                    for (i32 k = 0; k < N; ++k)
+                        x_pred[i] = V::add(x_pred[i], V::mul(V::load(&b.F[i][k][o]), V::load(&b.x[k][o])));
+                }
+
+                // FP = F * P
+                vec_t FP[N][N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        FP[i][j] = V::zero();
+                        for (i32 k = 0; k < N; ++k)
+                            FP[i][j] = V::add(FP[i][j], V::mul(V::load(&b.F[i][k][o]), V::load(&b.P[k][j][o])));
+                    }
+                }
+
+                // P_pred = FP * F^T + Q
+                vec_t P_pred[N][N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        vec_t acc = V::zero();
+                        for (i32 k = 0; k < N; ++k)
+                            acc = V::add(acc, V::mul(FP[i][k], V::load(&b.F[j][k][o])));
+                        P_pred[i][j] = V::add(acc, V::load(&b.Q[i][j][o]));
+                    }
+                }
+
+                // --- 2. MEASUREMENT UPDATE PHASE ---
+                // y = z - H * x_pred
+                vec_t y[M];
+                for (i32 i = 0; i < M; ++i)
+                {
+                    vec_t acc = V::zero();
+                    for (i32 k = 0; k < N; ++k)
+                        acc = V::add(acc, V::mul(V::load(&b.H[i][k][o]), x_pred[k]));
+                    y[i] = V::sub(V::load(&z[i][o]), acc);
+                }
+
+                // HP = H * P_pred
+                vec_t HP[M][N];
+                for (i32 i = 0; i < M; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        HP[i][j] = V::zero();
+                        for (i32 k = 0; k < N; ++k)
+                            HP[i][j] = V::add(HP[i][j], V::mul(V::load(&b.H[i][k][o]), P_pred[k][j]));
+                    }
+                }
+
+                // S = HP * H^T + R
+                vec_t S[M][M];
+                for (i32 i = 0; i < M; ++i)
+                {
+                    for (i32 j = 0; j < M; ++j)
+                    {
+                        vec_t acc = V::zero();
+                        for (i32 k = 0; k < N; ++k)
+                            acc = V::add(acc, V::mul(HP[i][k], V::load(&b.H[j][k][o])));
+                        S[i][j] = V::add(acc, V::load(&b.R[i][j][o]));
+                    }
+                }
+
+                // S^-1, same closed forms (and same singular fallback) as matrix_t::invert()
+                vec_t S_inv[M][M];
+                const vec_t one = V::set1(1.0f);
+                if (M == 1)
+                {
+                    S_inv[0][0] = V::select(V::not_zero(S[0][0]), V::div(one, S[0][0]), one);
+                }
+                else if (M == 2)
+                {
+                    const vec_t det    = V::sub(V::mul(S[0][0], S[1][1]), V::mul(S[0][1], S[1][0]));
+                    const vec_t invDet = V::select(V::not_zero(det), V::div(one, det), one);
+                    const vec_t neg    = V::set1(-1.0f);
+                    S_inv[0][0]        = V::mul(S[1][1], invDet);
+                    S_inv[0][1]        = V::mul(V::mul(neg, S[0][1]), invDet);
+                    S_inv[1][0]        = V::mul(V::mul(neg, S[1][0]), invDet);
+                    S_inv[1][1]        = V::mul(S[0][0], invDet);
+                }
+                else
+                {
+                    const vec_t c00    = V::sub(V::mul(S[1][1], S[2][2]), V::mul(S[1][2], S[2][1]));
+                    const vec_t c01    = V::sub(V::mul(S[1][0], S[2][2]), V::mul(S[1][2], S[2][0]));
+                    const vec_t c02    = V::sub(V::mul(S[1][0], S[2][1]), V::mul(S[1][1], S[2][0]));
+                    const vec_t det    = V::add(V::sub(V::mul(S[0][0], c00), V::mul(S[0][1], c01)), V::mul(S[0][2], c02));
+                    const vec_t invDet = V::select(V::not_zero(det), V::div(one, det), one);
+
+                    S_inv[0][0] = V::mul(c00, invDet);
+                    S_inv[0][1] = V::mul(V::sub(V::mul(S[0][2], S[2][1]), V::mul(S[0][1], S[2][2])), invDet);
+                    S_inv[0][2] = V::mul(V::sub(V::mul(S[0][1], S[1][2]), V::mul(S[0][2], S[1][1])), invDet);
+                    S_inv[1][0] = V::mul(V::sub(V::mul(S[1][2], S[2][0]), V::mul(S[1][0], S[2][2])), invDet);
+                    S_inv[1][1] = V::mul(V::sub(V::mul(S[0][0], S[2][2]), V::mul(S[0][2], S[2][0])), invDet);
+                    S_inv[1][2] = V::mul(V::sub(V::mul(S[0][2], S[1][0]), V::mul(S[0][0], S[1][2])), invDet);
+                    S_inv[2][0] = V::mul(c02, invDet);
+                    S_inv[2][1] = V::mul(V::sub(V::mul(S[0][1], S[2][0]), V::mul(S[0][0], S[2][1])), invDet);
+                    S_inv[2][2] = V::mul(V::sub(V::mul(S[0][0], S[1][1]), V::mul(S[0][1], S[1][0])), invDet);
+                }
+
+                // K = (P_pred * H^T) * S^-1
+                vec_t P_HT[N][M];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < M; ++j)
+                    {
+                        P_HT[i][j] = V::zero();
+                        for (i32 k = 0; k < N; ++k)
+                            P_HT[i][j] = V::add(P_HT[i][j], V::mul(P_pred[i][k], V::load(&b.H[j][k][o])));
+                    }
+                }
+                vec_t K[N][M];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < M; ++j)
+                    {
+                        K[i][j] = V::zero();
+                        for (i32 k = 0; k < M; ++k)
+                            K[i][j] = V::add(K[i][j], V::mul(P_HT[i][k], S_inv[k][j]));
+                        V::store_masked(&b.K[i][j][o], K[i][j], mask);
+                    }
+                }
+
+                // x = x_pred + K * y
+                for (i32 i = 0; i < N; ++i)
+                {
+                    vec_t Ky = V::zero();
+                    for (i32 k = 0; k < M; ++k)
+                        Ky = V::add(Ky, V::mul(K[i][k], y[k]));
+                    V::store_masked(&b.x[i][o], V::add(x_pred[i], Ky), mask);
+                }
+
+                // P = (I - K * H) * P_pred
+                vec_t I_KH[N][N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        vec_t KH = V::zero();
+                        for (i32 k = 0; k < M; ++k)
+                            KH = V::add(KH, V::mul(K[i][k], V::load(&b.H[k][j][o])));
+                        I_KH[i][j] = V::sub((i == j) ? one : V::zero(), KH);
+                    }
+                }
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < N; ++j)
+                    {
+                        vec_t acc = V::zero();
+                        for (i32 k = 0; k < N; ++k)
+                            acc = V::add(acc, V::mul(I_KH[i][k], P_pred[k][j]));
+                        V::store_masked(&b.P[i][j][o], acc, mask);
+                    }
+                }
+            }
+        }  // namespace nbank
+
+        // Predict + correct every active lane of the bank.
+        // measurement[i][lane] holds measurement component i for that lane; inactive lanes are left untouched.
+        template <i32 N, i32 M, i32 LANES>
+        static inline void update(kalman_bank_t<N, M, LANES>& bank, const f32 (&measurement)[M][LANES])
+        {
+            static_assert(M >= 1 && M <= 3, "The bank update supports measurement dimensions 1..3 (closed-form S inverse)");
+            typedef typename nsimd::select_t<LANES>::type V;
+            for (i32 o = 0; o < LANES; o += V::WIDTH)
+                nbank::update_group<V>(bank, measurement, o);
+        }
+
+        // Same as update() but forced onto the scalar path, useful as a reference and for benchmarking
+        template <i32 N, i32 M, i32 LANES>
+        static inline void update_scalar(kalman_bank_t<N, M, LANES>& bank, const f32 (&measurement)[M][LANES])
+        {
+            static_assert(M >= 1 && M <= 3, "The bank update supports measurement dimensions 1..3 (closed-form S inverse)");
+            for (i32 o = 0; o < LANES; ++o)
+                nbank::update_group<nsimd::f32x1_t>(bank, measurement, o);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_BANK_H__
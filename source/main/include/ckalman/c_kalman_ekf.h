@@ -0,0 +1,146 @@
+#ifndef __C_KALMAN_FILTER_EKF_H__
+#define __C_KALMAN_FILTER_EKF_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // EXTENDED KALMAN FILTER (nonlinear measurement function)
+        // ============================================================================
+        // correct_ekf() / update_ekf() run a kalman_nd_t with a nonlinear measurement z = h(x) instead of
+        // z = H x. The correction linearizes h at the predicted state:
+        //   y = z - h(x_pred),  H = dh/dx(x_pred),  S = H P_pred H^T + R,  K = P_pred H^T S^-1
+        // and from there on is the linear correction. The prediction (F, Q and the F policy) is unchanged.
+        // The measurement function is a template argument, update_ekf<HF>(kf, z), so its Jacobian is
+        // evaluated inline and its products skip the entries that are zero by construction.
+        //
+        // Measurement function interface:
+        //   linearize(x, h, H)        h = h(x) and the analytic Jacobian H = dh/dx at x (every entry)
+        //   residual(y)               y = z - h(x) normalized in place, e.g. angle differences wrapped
+        //   mul, mul_transposed, update_covariance
+        //                             the H policy functions (see model_dense_t), used on the Jacobian
+        // A user supplied function with a dense Jacobian derives from model_dense_t for the last three.
+        //
+        // kf.H receives the Jacobian of the last correction and the HMODEL of kf is not used. Linear and
+        // extended corrections can be mixed on a filter whose HMODEL does not read H (model_select_t).
+
+        // Range and angle of a position (x[X], x[Y]) seen from a sensor at the origin looking along +y,
+        // the RD-03D measurement (distance in meters, angle in degrees, positive towards +x):
+        //   h(x) = | r = sqrt(px^2 + py^2) |     H = | px / r       py / r      |  (columns X and Y,
+        //          | a = atan2(px, py) * c |         | c py / r^2   -c px / r^2 |   zero elsewhere)
+        // with c = 180 / pi. Only columns X and Y of H are read, so the products cost what they cost for
+        // a 2 x 2 H. Closer than 1 mm to the sensor the Jacobian is evaluated at 1 mm.
+        template <i32 X, i32 Y>
+        struct measurement_polar_t
+        {
+            enum
+            {
+                ROWS = 2
+            };
+
+            template <i32 N>
+            static inline void linearize(const matrix_t<N, 1>& x, matrix_t<ROWS, 1>& h, matrix_t<ROWS, N>& H)
+            {
+                const f32 c  = 57.2957795f;
+                const f32 px = x.data[X][0];
+                const f32 py = x.data[Y][0];
+                f32       r2 = px * px + py * py;
+                r2           = (r2 < 1e-6f) ? 1e-6f : r2;
+                const f32 r  = sqrtf(r2);
+
+                h.data[0][0] = r;
+                h.data[1][0] = atan2f(px, py) * c;
+
+                H.clear();
+                const f32 invR  = 1.0f / r;
+                const f32 invR2 = c * invR * invR;
+                H.data[0][X]    = px * invR;
+                H.data[0][Y]    = py * invR;
+                H.data[1][X]    = py * invR2;
+                H.data[1][Y]    = -px * invR2;
+            }
+
+            // Angle difference to [-180, 180] degrees
+            static inline void residual(matrix_t<ROWS, 1>& y)
+            {
+                f32& a = y.data[1][0];
+                a      = (a > 180.0f) ? a - 360.0f : ((a < -180.0f) ? a + 360.0f : a);
+            }
+
+            template <i32 N, i32 OTHERCOLS, typename T>
+            static inline void mul(const matrix_t<ROWS, N, T>& H, const matrix_t<N, OTHERCOLS, T>& a, matrix_t<ROWS, OTHERCOLS, T>& out)
+            {
+                for (i32 m = 0; m < ROWS; ++m)
+                    for (i32 c = 0; c < OTHERCOLS; ++c)
+                        out.data[m][c] = H.data[m][X] * a.data[X][c] + H.data[m][Y] * a.data[Y][c];
+            }
+
+            template <i32 R, i32 N, typename T>
+            static inline void mul_transposed(const matrix_t<R, N, T>& a, const matrix_t<ROWS, N, T>& H, matrix_t<R, ROWS, T>& out)
+            {
+                for (i32 r = 0; r < R; ++r)
+                    for (i32 m = 0; m < ROWS; ++m)
+                        out.data[r][m] = a.data[r][X] * H.data[m][X] + a.data[r][Y] * H.data[m][Y];
+            }
+
+            // P = P_pred - K * (H * P_pred)
+            template <i32 N, typename T>
+            static inline void update_covariance(const matrix_t<N, ROWS, T>& K, const matrix_t<ROWS, N, T>&, const matrix_t<ROWS, N, T>& HP, const matrix_t<N, N, T>& P_pred, matrix_t<N, N, T>& P)
+            {
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = 0; j < N; ++j)
+                        P.data[i][j] = P_pred.data[i][j] - K.data[i][0] * HP.data[0][j] - K.data[i][1] * HP.data[1][j];
+            }
+        };
+
+        namespace nfilter
+        {
+            // Extended measurement update of the predicted x and P, writes the Jacobian to H and the gain to K
+            template <typename HF, i32 N, i32 M, typename T, typename OBSERVER>
+            static inline void correct_ekf(matrix_t<M, N, T>& H, const matrix_t<M, M, T>& R, const T measurement[M], matrix_t<N, 1, T>& x, matrix_t<N, N, T>& P, matrix_t<N, M, T>& K, OBSERVER& observer)
+            {
+                // y = z - h(x_pred), H = dh/dx(x_pred)
+                matrix_t<M, 1, T> h;
+                HF::linearize(x, h, H);
+                matrix_t<M, 1, T> y;
+                for (i32 i = 0; i < M; ++i)
+                    y.data[i][0] = measurement[i] - h.data[i][0];
+                HF::residual(y);
+
+                correct_innovation<HF>(H, R, y, x, P, K, observer);
+            }
+        }  // namespace nfilter
+
+        // Measurement update with the measurement function HF, 'observer(y, S, K)' as for correct()
+        template <typename HF, i32 N, i32 M, typename FM, typename HM, typename T, typename OBSERVER>
+        static inline void correct_ekf(kalman_nd_t<N, M, FM, HM, T>& kf, const T measurement[M], OBSERVER& observer)
+        {
+            nfilter::correct_ekf<HF>(kf.H, kf.R, measurement, kf.x, kf.P, kf.K, observer);
+        }
+
+        template <typename HF, i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void correct_ekf(kalman_nd_t<N, M, FM, HM, T>& kf, const T measurement[M])
+        {
+            innovation_ignore_t ignore;
+            nfilter::correct_ekf<HF>(kf.H, kf.R, measurement, kf.x, kf.P, kf.K, ignore);
+        }
+
+        template <typename HF, i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void update_ekf(kalman_nd_t<N, M, FM, HM, T>& kf, const T measurement[M])
+        {
+            predict(kf);
+            correct_ekf<HF>(kf, measurement);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_EKF_H__
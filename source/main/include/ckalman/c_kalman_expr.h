@@ -0,0 +1,399 @@
+#ifndef __C_KALMAN_FILTER_EXPR_H__
+#define __C_KALMAN_FILTER_EXPR_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // MATRIX EXPRESSIONS
+        // ============================================================================
+        // Operators on matrix_t for user-written filter math (custom models, Jacobians, Q construction):
+        //   P = F * symmetric(P) * transposed(F) + Q;
+        //   Q = G * q * transposed(G);
+        //   y = z - H * x;
+        // An expression is only a small tree of references and is evaluated element by element straight
+        // into the destination, so sums, differences, scaling and transposes need no temporaries and
+        // there is no clear() before a product. The one exception is a product used as an operand of
+        // another product: it is evaluated once into a matrix held inside the expression (on the stack),
+        // otherwise every element would recompute it. Nothing is ever allocated.
+        //
+        // Symmetric results are recognized and only their upper triangle is computed:
+        //   X * transposed(X)                   (the same matrix X twice)
+        //   X * symmetric(S) * transposed(X)    (S marked as symmetric by the caller)
+        // and sums, differences and scalings of symmetric terms.
+        //
+        // The destination may appear in the expression (x = F * x): when an element of it would be read
+        // after it has been written, the expression is evaluated into a temporary first.
+        //
+        // Every expression node provides:
+        //   ROWS, COLS, value_t
+        //   at(i, j)       element (i, j) of the result
+        //   symmetric()    the result is known to be symmetric
+        //   reads(p)       matrix 'p' is an operand
+        //   aliases(p)     matrix 'p' is read at other positions than the element being computed
+
+        template <typename E>
+        struct expr_t
+        {
+            typedef E expr_node_t;
+        };
+
+        // A matrix_t operand, by reference
+        template <i32 R, i32 C, typename T>
+        struct expr_ref_t : expr_t<expr_ref_t<R, C, T> >
+        {
+            enum
+            {
+                ROWS = R,
+                COLS = C
+            };
+            typedef T value_t;
+
+            const matrix_t<R, C, T>& m_matrix;
+
+            explicit expr_ref_t(const matrix_t<R, C, T>& m) : m_matrix(m) {}
+
+            inline T    at(i32 i, i32 j) const { return m_matrix.data[i][j]; }
+            inline bool symmetric() const { return false; }
+            inline bool reads(const void* p) const { return &m_matrix == p; }
+            inline bool aliases(const void*) const { return false; }
+        };
+
+        // An evaluated sub-expression, by value
+        template <i32 R, i32 C, typename T>
+        struct expr_value_t : expr_t<expr_value_t<R, C, T> >
+        {
+            enum
+            {
+                ROWS = R,
+                COLS = C
+            };
+            typedef T value_t;
+
+            matrix_t<R, C, T> m_matrix;
+            bool              m_symmetric;
+
+            template <typename E>
+            explicit expr_value_t(const E& e) : m_symmetric(e.symmetric())
+            {
+                assign(m_matrix, e);
+            }
+
+            inline T    at(i32 i, i32 j) const { return m_matrix.data[i][j]; }
+            inline bool symmetric() const { return m_symmetric; }
+            inline bool reads(const void*) const { return false; }
+            inline bool aliases(const void*) const { return false; }
+        };
+
+        template <typename E>
+        struct expr_transpose_t : expr_t<expr_transpose_t<E> >
+        {
+            enum
+            {
+                ROWS = E::COLS,
+                COLS = E::ROWS
+            };
+            typedef typename E::value_t value_t;
+
+            E m_e;
+
+            explicit expr_transpose_t(const E& e) : m_e(e) {}
+
+            inline value_t at(i32 i, i32 j) const { return m_e.at(j, i); }
+            inline bool    symmetric() const { return m_e.symmetric(); }
+            inline bool    reads(const void* p) const { return m_e.reads(p); }
+            inline bool    aliases(const void* p) const { return m_e.reads(p); }
+        };
+
+        // Marks an operand as symmetric, the values are not checked
+        template <typename E>
+        struct expr_symmetric_t : expr_t<expr_symmetric_t<E> >
+        {
+            enum
+            {
+                ROWS = E::ROWS,
+                COLS = E::COLS
+            };
+            typedef typename E::value_t value_t;
+
+            E m_e;
+
+            explicit expr_symmetric_t(const E& e) : m_e(e) { static_assert(ROWS == COLS, "only a square matrix can be symmetric"); }
+
+            inline value_t at(i32 i, i32 j) const { return m_e.at(i, j); }
+            inline bool    symmetric() const { return true; }
+            inline bool    reads(const void* p) const { return m_e.reads(p); }
+            inline bool    aliases(const void* p) const { return m_e.aliases(p); }
+        };
+
+        template <typename A, typename B>
+        struct expr_sum_t : expr_t<expr_sum_t<A, B> >
+        {
+            enum
+            {
+                ROWS = A::ROWS,
+                COLS = A::COLS
+            };
+            typedef typename A::value_t value_t;
+
+            A m_a;
+            B m_b;
+
+            expr_sum_t(const A& a, const B& b) : m_a(a), m_b(b) { static_assert((i32)A::ROWS == (i32)B::ROWS && (i32)A::COLS == (i32)B::COLS, "matrix sum requires equal dimensions"); }
+
+            inline value_t at(i32 i, i32 j) const { return m_a.at(i, j) + m_b.at(i, j); }
+            inline bool    symmetric() const { return m_a.symmetric() && m_b.symmetric(); }
+            inline bool    reads(const void* p) const { return m_a.reads(p) || m_b.reads(p); }
+            inline bool    aliases(const void* p) const { return m_a.aliases(p) || m_b.aliases(p); }
+        };
+
+        template <typename A, typename B>
+        struct expr_difference_t : expr_t<expr_difference_t<A, B> >
+        {
+            enum
+            {
+                ROWS = A::ROWS,
+                COLS = A::COLS
+            };
+            typedef typename A::value_t value_t;
+
+            A m_a;
+            B m_b;
+
+            expr_difference_t(const A& a, const B& b) : m_a(a), m_b(b) { static_assert((i32)A::ROWS == (i32)B::ROWS && (i32)A::COLS == (i32)B::COLS, "matrix difference requires equal dimensions"); }
+
+            inline value_t at(i32 i, i32 j) const { return m_a.at(i, j) - m_b.at(i, j); }
+            inline bool    symmetric() const { return m_a.symmetric() && m_b.symmetric(); }
+            inline bool    reads(const void* p) const { return m_a.reads(p) || m_b.reads(p); }
+            inline bool    aliases(const void* p) const { return m_a.aliases(p) || m_b.aliases(p); }
+        };
+
+        template <typename E>
+        struct expr_scaled_t : expr_t<expr_scaled_t<E> >
+        {
+            enum
+            {
+                ROWS = E::ROWS,
+                COLS = E::COLS
+            };
+            typedef typename E::value_t value_t;
+
+            value_t m_s;
+            E       m_e;
+
+            expr_scaled_t(value_t s, const E& e) : m_s(s), m_e(e) {}
+
+            inline value_t at(i32 i, i32 j) const { return m_s * m_e.at(i, j); }
+            inline bool    symmetric() const { return m_e.symmetric(); }
+            inline bool    reads(const void* p) const { return m_e.reads(p); }
+            inline bool    aliases(const void* p) const { return m_e.aliases(p); }
+        };
+
+        template <typename A, typename B>
+        struct expr_product_t;
+
+        namespace nexpr
+        {
+            template <typename X>
+            struct void_of
+            {
+                typedef void type;
+            };
+
+            // Operands of the operators: matrix_t (wrapped in expr_ref_t) and expression nodes.
+            // Any other type has no 'type' and drops the operator from overload resolution.
+            template <typename X, typename ENABLE = void>
+            struct operand_t
+            {
+            };
+
+            template <typename X>
+            struct operand_t<X, typename void_of<typename X::expr_node_t>::type>
+            {
+                typedef X type;
+                static inline const X& wrap(const X& e) { return e; }
+            };
+
+            template <i32 R, i32 C, typename T>
+            struct operand_t<matrix_t<R, C, T>, void>
+            {
+                typedef expr_ref_t<R, C, T> type;
+                static inline type wrap(const matrix_t<R, C, T>& m) { return type(m); }
+            };
+
+            // How an operand of a product is held: matrices, their transposes and symmetric marks by
+            // reference, anything else is evaluated once into an expr_value_t.
+            template <typename E>
+            struct nested_t
+            {
+                typedef expr_value_t<E::ROWS, E::COLS, typename E::value_t> type;
+            };
+
+            template <i32 R, i32 C, typename T>
+            struct nested_t<expr_ref_t<R, C, T> >
+            {
+                typedef expr_ref_t<R, C, T> type;
+            };
+
+            template <i32 R, i32 C, typename T>
+            struct nested_t<expr_transpose_t<expr_ref_t<R, C, T> > >
+            {
+                typedef expr_transpose_t<expr_ref_t<R, C, T> > type;
+            };
+
+            template <i32 R, i32 C, typename T>
+            struct nested_t<expr_symmetric_t<expr_ref_t<R, C, T> > >
+            {
+                typedef expr_symmetric_t<expr_ref_t<R, C, T> > type;
+            };
+
+            // Is a * b symmetric: X * X^T, or X * S * X^T with S symmetric
+            template <typename A, typename B>
+            static inline bool mirrors(const A&, const B&)
+            {
+                return false;
+            }
+
+            template <i32 R, i32 C, typename T>
+            static inline bool mirrors(const expr_ref_t<R, C, T>& a, const expr_transpose_t<expr_ref_t<R, C, T> >& b)
+            {
+                return &a.m_matrix == &b.m_e.m_matrix;
+            }
+
+            template <i32 R, i32 C, typename T, typename S>
+            static inline bool mirrors(const expr_product_t<expr_ref_t<R, C, T>, S>& a, const expr_transpose_t<expr_ref_t<R, C, T> >& b)
+            {
+                return &a.m_a.m_matrix == &b.m_e.m_matrix && a.m_b.symmetric();
+            }
+
+            template <i32 R, i32 C, typename T, typename E>
+            static inline void evaluate(matrix_t<R, C, T>& out, const E& e, bool symmetric)
+            {
+                if (symmetric)
+                {
+                    for (i32 i = 0; i < R; ++i)
+                    {
+                        for (i32 j = i; j < C; ++j)
+                        {
+                            const T v      = e.at(i, j);
+                            out.data[i][j] = v;
+                            out.data[j][i] = v;
+                        }
+                    }
+                }
+                else
+                {
+                    for (i32 i = 0; i < R; ++i)
+                        for (i32 j = 0; j < C; ++j)
+                            out.data[i][j] = e.at(i, j);
+                }
+            }
+        }  // namespace nexpr
+
+        template <typename A, typename B>
+        struct expr_product_t : expr_t<expr_product_t<A, B> >
+        {
+            enum
+            {
+                ROWS = A::ROWS,
+                COLS = B::COLS
+            };
+            typedef typename A::value_t value_t;
+            typedef scalar_traits_t<value_t> traits_t;
+
+            typename nexpr::nested_t<A>::type m_a;
+            typename nexpr::nested_t<B>::type m_b;
+            bool                              m_symmetric;
+
+            expr_product_t(const A& a, const B& b) : m_a(a), m_b(b), m_symmetric(nexpr::mirrors(a, b)) { static_assert((i32)A::COLS == (i32)B::ROWS, "matrix product requires A::COLS == B::ROWS"); }
+
+            inline value_t at(i32 i, i32 j) const
+            {
+                typename traits_t::acc_t sum = traits_t::to_acc(value_t(0));
+                for (i32 k = 0; k < (i32)A::COLS; ++k)
+                    sum = traits_t::mac(sum, m_a.at(i, k), m_b.at(k, j));
+                return traits_t::from_acc(sum);
+            }
+            inline bool symmetric() const { return m_symmetric; }
+            inline bool reads(const void* p) const { return m_a.reads(p) || m_b.reads(p); }
+            inline bool aliases(const void* p) const { return m_a.reads(p) || m_b.reads(p); }
+        };
+
+        // out = e, in one loop over the elements of out (over its upper triangle when e is symmetric)
+        template <i32 R, i32 C, typename T, typename E>
+        static inline void assign(matrix_t<R, C, T>& out, const E& e)
+        {
+            static_assert((i32)E::ROWS == R && (i32)E::COLS == C, "expression and destination differ in dimensions");
+            const bool symmetric = (R == C) && e.symmetric();
+            if (symmetric ? e.reads(&out) : e.aliases(&out))
+            {
+                matrix_t<R, C, T> tmp;
+                nexpr::evaluate(tmp, e, symmetric);
+                out = tmp;
+                return;
+            }
+            nexpr::evaluate(out, e, symmetric);
+        }
+
+        // ----------------------------------------------------------------------------
+        // Operators
+        // ----------------------------------------------------------------------------
+
+        template <typename A>
+        static inline expr_transpose_t<typename nexpr::operand_t<A>::type> transposed(const A& a)
+        {
+            return expr_transpose_t<typename nexpr::operand_t<A>::type>(nexpr::operand_t<A>::wrap(a));
+        }
+
+        template <typename A>
+        static inline expr_symmetric_t<typename nexpr::operand_t<A>::type> symmetric(const A& a)
+        {
+            return expr_symmetric_t<typename nexpr::operand_t<A>::type>(nexpr::operand_t<A>::wrap(a));
+        }
+
+        template <typename A, typename B>
+        static inline expr_sum_t<typename nexpr::operand_t<A>::type, typename nexpr::operand_t<B>::type> operator+(const A& a, const B& b)
+        {
+            typedef nexpr::operand_t<A> a_t;
+            typedef nexpr::operand_t<B> b_t;
+            return expr_sum_t<typename a_t::type, typename b_t::type>(a_t::wrap(a), b_t::wrap(b));
+        }
+
+        template <typename A, typename B>
+        static inline expr_difference_t<typename nexpr::operand_t<A>::type, typename nexpr::operand_t<B>::type> operator-(const A& a, const B& b)
+        {
+            typedef nexpr::operand_t<A> a_t;
+            typedef nexpr::operand_t<B> b_t;
+            return expr_difference_t<typename a_t::type, typename b_t::type>(a_t::wrap(a), b_t::wrap(b));
+        }
+
+        template <typename A, typename B>
+        static inline expr_product_t<typename nexpr::operand_t<A>::type, typename nexpr::operand_t<B>::type> operator*(const A& a, const B& b)
+        {
+            typedef nexpr::operand_t<A> a_t;
+            typedef nexpr::operand_t<B> b_t;
+            return expr_product_t<typename a_t::type, typename b_t::type>(a_t::wrap(a), b_t::wrap(b));
+        }
+
+        template <typename B>
+        static inline expr_scaled_t<typename nexpr::operand_t<B>::type> operator*(typename nexpr::operand_t<B>::type::value_t s, const B& b)
+        {
+            return expr_scaled_t<typename nexpr::operand_t<B>::type>(s, nexpr::operand_t<B>::wrap(b));
+        }
+
+        template <typename A>
+        static inline expr_scaled_t<typename nexpr::operand_t<A>::type> operator*(const A& a, typename nexpr::operand_t<A>::type::value_t s)
+        {
+            return expr_scaled_t<typename nexpr::operand_t<A>::type>(s, nexpr::operand_t<A>::wrap(a));
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_EXPR_H__
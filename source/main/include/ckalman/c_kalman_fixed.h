@@ -0,0 +1,204 @@
+#ifndef __C_KALMAN_FILTER_FIXED_H__
+#define __C_KALMAN_FILTER_FIXED_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // FIXED-POINT SCALAR (Q16.16 / Q8.24)
+        // ============================================================================
+        // Signed 32-bit fixed-point number with FRAC fractional bits, for targets without an FPU.
+        // Plug it into the filters as their scalar type:
+        //   kalman_1D_of_t<q16_16_t>                                          1D filter
+        //   matrix_t<3, 3, q16_16_t>                                          matrix
+        //   kalman_nd_t<4, 2, model_constant_velocity_t, model_select_t<0, 1>, q8_24_t>
+        //
+        // All arithmetic saturates at the representable range instead of wrapping. Products are
+        // rounded to nearest; matrix products accumulate in 64 bits (one rounding per element).
+        // Division by zero saturates to the largest magnitude with the sign of the dividend.
+        //
+        // Range and resolution:
+        //   q16_16_t   [-32768, 32768)   1.5e-5
+        //   q8_24_t    [-128, 128)       6.0e-8
+        // Q8.24 is the better choice when all state, covariance and gain values stay well below 128,
+        // e.g. positions in meters within a few meters and moderate initial uncertainties.
+        //
+        // Only the generic initialize/begin/update of kalman_1D_of_t and kalman_nd_t are templated on the
+        // scalar type; the fused, sequential, packed, bank and steady-state variants are f32 only.
+
+        namespace nfixed
+        {
+            static inline s32 saturate(s64 v)
+            {
+                return (v > (s64)0x7FFFFFFF) ? (s32)0x7FFFFFFF : ((v < -(s64)0x80000000) ? (s32)(-(s64)0x80000000) : (s32)v);
+            }
+
+            // Number of leading zero bits of a non-zero value
+            static inline i32 clz(u32 v)
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                return __builtin_clz(v);
+#else
+                i32 n = 0;
+                while ((v & 0x80000000u) == 0)
+                {
+                    v <<= 1;
+                    ++n;
+                }
+                return n;
+#endif
+            }
+        }  // namespace nfixed
+
+        template <i32 FRAC>
+        struct fixed_t
+        {
+            static_assert(FRAC > 0 && FRAC < 31, "fixed_t requires 1 to 30 fractional bits");
+
+            enum
+            {
+                FRACTION_BITS = FRAC
+            };
+
+            s32 raw;
+
+            fixed_t() = default;
+
+            // Rounds to nearest and saturates, constexpr so that constants like T(1) cost nothing at runtime
+            constexpr explicit fixed_t(f32 v)
+                : raw((v * (f32)(1 << FRAC) >= 2147483520.0f) ? (s32)0x7FFFFFFF : ((v * (f32)(1 << FRAC) <= -2147483648.0f) ? (s32)(-(s64)0x80000000) : (s32)(v * (f32)(1 << FRAC) + ((v < 0.0f) ? -0.5f : 0.5f))))
+            {
+            }
+
+            static inline fixed_t fromRaw(s32 r)
+            {
+                fixed_t f;
+                f.raw = r;
+                return f;
+            }
+
+            fixed_t operator-() const { return fromRaw(nfixed::saturate(-(s64)raw)); }
+
+            fixed_t operator+(fixed_t b) const { return fromRaw(nfixed::saturate((s64)raw + (s64)b.raw)); }
+            fixed_t operator-(fixed_t b) const { return fromRaw(nfixed::saturate((s64)raw - (s64)b.raw)); }
+            fixed_t operator*(fixed_t b) const { return fromRaw(nfixed::saturate(((s64)raw * (s64)b.raw + ((s64)1 << (FRAC - 1))) >> FRAC)); }
+            fixed_t operator/(fixed_t b) const
+            {
+                if (b.raw == 0)
+                    return fromRaw(raw < 0 ? (s32)(-(s64)0x80000000) : (s32)0x7FFFFFFF);
+                return fromRaw(nfixed::saturate(((s64)raw * ((s64)1 << FRAC)) / (s64)b.raw));
+            }
+
+            fixed_t& operator+=(fixed_t b) { return *this = *this + b; }
+            fixed_t& operator-=(fixed_t b) { return *this = *this - b; }
+            fixed_t& operator*=(fixed_t b) { return *this = *this * b; }
+            fixed_t& operator/=(fixed_t b) { return *this = *this / b; }
+
+            bool operator==(fixed_t b) const { return raw == b.raw; }
+            bool operator!=(fixed_t b) const { return raw != b.raw; }
+            bool operator<(fixed_t b) const { return raw < b.raw; }
+            bool operator>(fixed_t b) const { return raw > b.raw; }
+            bool operator<=(fixed_t b) const { return raw <= b.raw; }
+            bool operator>=(fixed_t b) const { return raw >= b.raw; }
+        };
+
+        typedef fixed_t<16> q16_16_t;
+        typedef fixed_t<24> q8_24_t;
+
+        template <i32 FRAC>
+        static inline f32 toFloat(fixed_t<FRAC> v)
+        {
+            return (f32)v.raw * (1.0f / (f32)(1 << FRAC));
+        }
+
+        // 1 / v without a divide instruction: v is normalized to d in [0.5, 1), 1/d is refined from the
+        // linear estimate 48/17 - 32/17 d by three Newton-Raphson steps x = x (2 - d x) in Q2.30 and
+        // scaled back. Accurate to the last bit of the result; saturates when 1 / v is out of range.
+        template <i32 FRAC>
+        static inline fixed_t<FRAC> reciprocal(fixed_t<FRAC> v)
+        {
+            if (v.raw == 0)
+                return fixed_t<FRAC>::fromRaw((s32)0x7FFFFFFF);
+
+            const bool negative = v.raw < 0;
+            const u32  a        = negative ? (u32)(-(s64)v.raw) : (u32)v.raw;
+            const i32  shift    = nfixed::clz(a);
+            const u32  d        = a << shift;  // Q0.32, in [0.5, 1)
+
+            // x0 = 48/17 - 32/17 * d in Q2.30
+            u32 x = 0xB4B4B4B4u - (u32)(((u64)d * 0x78787878u) >> 32);
+            for (i32 i = 0; i < 3; ++i)
+            {
+                const u32 e = (u32)(((u64)d * x) >> 32);  // d * x, Q2.30
+                x           = (u32)(((u64)x * (0x80000000u - e)) >> 30);
+            }
+
+            // 1 / v = x * 2^(shift + 2 * FRAC - 62) in raw units
+            const i32 s = shift + 2 * FRAC - 62;
+            s64       r;
+            if (s >= 0)
+                r = (s > 31 || (u64)x > ((u64)0x7FFFFFFF >> s)) ? (s64)0x7FFFFFFF : ((s64)x << s);
+            else if (s > -63)
+                r = ((s64)x + ((s64)1 << (-s - 1))) >> -s;
+            else
+                r = 0;
+            return fixed_t<FRAC>::fromRaw(nfixed::saturate(negative ? -r : r));
+        }
+
+        // Saturating multiply-accumulate: products are summed exactly in 64 bits (Q.2*FRAC) and
+        // rounded and saturated once when converted back.
+        template <i32 FRAC>
+        struct scalar_traits_t<fixed_t<FRAC> >
+        {
+            typedef fixed_t<FRAC> value_t;
+            typedef s64           acc_t;
+
+            static inline acc_t to_acc(value_t a) { return (s64)a.raw * ((s64)1 << FRAC); }
+            static inline acc_t mac(acc_t acc, value_t a, value_t b) { return acc + (s64)a.raw * (s64)b.raw; }
+            static inline acc_t msc(acc_t acc, value_t a, value_t b) { return acc - (s64)a.raw * (s64)b.raw; }
+            static inline value_t from_acc(acc_t acc) { return value_t::fromRaw(nfixed::saturate((acc + ((s64)1 << (FRAC - 1))) >> FRAC)); }
+            static inline value_t reciprocal(value_t a) { return nkalman::reciprocal(a); }
+        };
+
+        // ----------------------------------------------------------------------------
+        // Conversion from/to f32, e.g. set a filter up in f32 once and run it in fixed-point
+        // ----------------------------------------------------------------------------
+
+        template <i32 R, i32 C, i32 FRAC>
+        static inline void toFixed(const matrix_t<R, C>& in, matrix_t<R, C, fixed_t<FRAC> >& out)
+        {
+            for (i32 i = 0; i < R; ++i)
+                for (i32 j = 0; j < C; ++j)
+                    out.data[i][j] = fixed_t<FRAC>(in.data[i][j]);
+        }
+
+        template <i32 R, i32 C, i32 FRAC>
+        static inline void toFloat(const matrix_t<R, C, fixed_t<FRAC> >& in, matrix_t<R, C>& out)
+        {
+            for (i32 i = 0; i < R; ++i)
+                for (i32 j = 0; j < C; ++j)
+                    out.data[i][j] = toFloat(in.data[i][j]);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, i32 FRAC>
+        static inline void toFixed(const kalman_nd_t<N, M, FM, HM>& in, kalman_nd_t<N, M, FM, HM, fixed_t<FRAC> >& out)
+        {
+            toFixed(in.F, out.F);
+            toFixed(in.K, out.K);
+            toFixed(in.P, out.P);
+            toFixed(in.Q, out.Q);
+            toFixed(in.R, out.R);
+            toFixed(in.H, out.H);
+            toFixed(in.x, out.x);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_FIXED_H__
@@ -0,0 +1,230 @@
+#ifndef __C_KALMAN_FILTER_INFO_H__
+#define __C_KALMAN_FILTER_INFO_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // INFORMATION FILTER (multi-sensor fusion)
+        // ============================================================================
+        // Keeps Y = P^-1 and y = P^-1 x instead of P and x. In this form the measurement update of a
+        // sensor is a plain sum:
+        //   Y += H^T R^-1 H
+        //   y += H^T R^-1 z
+        // so any number of sensors observing the same state are fused without a gain computation per
+        // sensor. H^T R^-1 and H^T R^-1 H are constant per sensor and prepared once (info_sensor_t).
+        //
+        // Contributions are summed into an info_contribution_t. Independent accumulators (e.g. one per
+        // thread or per group of sensors) are combined with merge() and folded into the filter once per
+        // tick with correct(). The price is the prediction: it goes through the covariance form and
+        // costs two N x N symmetric inversions per tick, independent of the number of sensors.
+
+        template <i32 N, typename FMODEL = model_dense_t>
+        struct kalman_info_t
+        {
+            matrix_t<N, N> F;  // State transition
+            matrix_t<N, N> Q;  // Process noise covariance
+            matrix_t<N, N> Y;  // Information matrix P^-1
+            matrix_t<N, 1> y;  // Information vector P^-1 x
+        };
+
+        // One sensor with M measurements of the N states
+        template <i32 N, i32 M>
+        struct info_sensor_t
+        {
+            matrix_t<N, M> HtRinv;   // H^T R^-1
+            matrix_t<N, N> HtRinvH;  // H^T R^-1 H
+        };
+
+        // Sum of the contributions of the sensors of one tick
+        template <i32 N>
+        struct info_contribution_t
+        {
+            matrix_t<N, N> I;  // sum H^T R^-1 H
+            matrix_t<N, 1> i;  // sum H^T R^-1 z
+        };
+
+        namespace ninfo
+        {
+            // Inverse of a symmetric positive definite matrix through A = L D L^T:
+            // A^-1 = L^-T D^-1 L^-1, one reciprocal per row and only the lower triangle computed.
+            // Returns false when A is not positive definite.
+            template <i32 N>
+            static inline bool invert_spd(const matrix_t<N, N>& A, matrix_t<N, N>& out)
+            {
+                matrix_t<N, N> LD;
+                if (!A.decomposeLDLT(LD))
+                    return false;
+
+                f32 dinv[N];
+                for (i32 i = 0; i < N; ++i)
+                    dinv[i] = 1.0f / LD.data[i][i];
+
+                // W = L^-1 (unit lower triangular)
+                f32 W[N][N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < i; ++j)
+                    {
+                        f32 sum = -LD.data[i][j];
+                        for (i32 k = j + 1; k < i; ++k)
+                            sum -= LD.data[i][k] * W[k][j];
+                        W[i][j] = sum;
+                    }
+                    W[i][i] = 1.0f;
+                    for (i32 j = i + 1; j < N; ++j)
+                        W[i][j] = 0.0f;
+                }
+
+                // out = W^T D^-1 W
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j <= i; ++j)
+                    {
+                        f32 sum = 0.0f;
+                        for (i32 k = i; k < N; ++k)
+                            sum += W[k][i] * dinv[k] * W[k][j];
+                        out.data[i][j] = sum;
+                        out.data[j][i] = sum;
+                    }
+                }
+                return true;
+            }
+        }  // namespace ninfo
+
+        // F and Q identity, no information (Y = 0: infinite uncertainty)
+        template <i32 N, typename FM>
+        static inline void initialize(kalman_info_t<N, FM>& kf)
+        {
+            kf.F.setIdentity();
+            kf.Q.setIdentity();
+            kf.Y.clear();
+            kf.y.clear();
+        }
+
+        // State 'initial_states' with covariance initial_uncertainty * I
+        template <i32 N, typename FM>
+        static inline void begin(kalman_info_t<N, FM>& kf, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            const f32 information = 1.0f / initial_uncertainty;
+            kf.Y.clear();
+            for (i32 i = 0; i < N; ++i)
+            {
+                kf.Y.data[i][i] = information;
+                kf.y.data[i][0] = initial_states[i] * information;
+            }
+        }
+
+        // Prepares the constant terms of a sensor with measurement matrix H and noise covariance R
+        template <i32 N, i32 M>
+        static inline void setup(info_sensor_t<N, M>& sensor, const matrix_t<M, N>& H, const matrix_t<M, M>& R)
+        {
+            // H^T R^-1 = (R^-1 H)^T, R symmetric
+            matrix_t<M, M> LD;
+            matrix_t<M, N> RinvH;
+            if (R.decomposeLDLT(LD))
+                LD.solveLDLT(H, RinvH);
+            else
+                RinvH.clear();
+            RinvH.transpose(sensor.HtRinv);
+            sensor.HtRinv.multiply(H, sensor.HtRinvH);
+        }
+
+        template <i32 N>
+        static inline void clear(info_contribution_t<N>& c)
+        {
+            c.I.clear();
+            c.i.clear();
+        }
+
+        // Adds the measurement 'z' of 'sensor'
+        template <i32 N, i32 M>
+        static inline void contribute(info_contribution_t<N>& c, const info_sensor_t<N, M>& sensor, const f32 z[M])
+        {
+            for (i32 r = 0; r < N; ++r)
+            {
+                f32 sum = c.i.data[r][0];
+                for (i32 m = 0; m < M; ++m)
+                    sum += sensor.HtRinv.data[r][m] * z[m];
+                c.i.data[r][0] = sum;
+                for (i32 k = 0; k < N; ++k)
+                    c.I.data[r][k] += sensor.HtRinvH.data[r][k];
+            }
+        }
+
+        // c += other
+        template <i32 N>
+        static inline void merge(info_contribution_t<N>& c, const info_contribution_t<N>& other)
+        {
+            for (i32 r = 0; r < N; ++r)
+            {
+                c.i.data[r][0] += other.i.data[r][0];
+                for (i32 k = 0; k < N; ++k)
+                    c.I.data[r][k] += other.I.data[r][k];
+            }
+        }
+
+        // Time update through the covariance form: P = Y^-1, x = P y, P = F P F^T + Q, Y = P^-1, y = Y x.
+        // Y must be positive definite (begin() or enough information), otherwise the state is left as is.
+        template <i32 N, typename FM>
+        static bool predict(kalman_info_t<N, FM>& kf)
+        {
+            matrix_t<N, N> P;
+            if (!ninfo::invert_spd(kf.Y, P))
+                return false;
+            matrix_t<N, 1> x;
+            P.multiply(kf.y, x);
+
+            matrix_t<N, 1> x_pred;
+            FM::mul(kf.F, x, x_pred);
+            matrix_t<N, N> FP;
+            FM::mul(kf.F, P, FP);
+            matrix_t<N, N> FPFt;
+            FM::mul_transposed(FP, kf.F, FPFt);
+            matrix_t<N, N> P_pred;
+            FPFt.add(kf.Q, P_pred);
+
+            if (!ninfo::invert_spd(P_pred, kf.Y))
+                return false;
+            kf.Y.multiply(x_pred, kf.y);
+            return true;
+        }
+
+        // Measurement update with the summed contributions of all sensors of this tick
+        template <i32 N, typename FM>
+        static inline void correct(kalman_info_t<N, FM>& kf, const info_contribution_t<N>& c)
+        {
+            matrix_t<N, N> Y = kf.Y;
+            Y.add(c.I, kf.Y);
+            matrix_t<N, 1> y = kf.y;
+            y.add(c.i, kf.y);
+        }
+
+        // x = Y^-1 y, returns false when Y is not positive definite (not enough information yet)
+        template <i32 N, typename FM>
+        static inline bool getState(const kalman_info_t<N, FM>& kf, matrix_t<N, 1>& x)
+        {
+            matrix_t<N, N> LD;
+            if (!kf.Y.decomposeLDLT(LD))
+                return false;
+            LD.solveLDLT(kf.y, x);
+            return true;
+        }
+
+        // P = Y^-1
+        template <i32 N, typename FM>
+        static inline bool getCovariance(const kalman_info_t<N, FM>& kf, matrix_t<N, N>& P)
+        {
+            return ninfo::invert_spd(kf.Y, P);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_INFO_H__
@@ -0,0 +1,118 @@
+#ifndef __C_KALMAN_FILTER_MODEL_H__
+#define __C_KALMAN_FILTER_MODEL_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // SHARED MODEL AND PER-TRACK STATE
+        // ============================================================================
+        // kalman_nd_t stores the model (F, H, Q, R) in every filter, although trackers usually run many
+        // filters with the same model. Here the two are split: a kalman_model_t is set up once and shared,
+        // a kalman_track_t only holds what changes per target (x, P and K), for the 4x2 rd03d filter 112
+        // instead of 288 bytes.
+        //
+        // matrix_t is constexpr, so a model can be a compile-time constant:
+        //   static constexpr rd03d_model_t s_model = rd03d_model(0.05f);
+        //   update(s_model, track, z);
+        // With the model a constant expression the compiler folds F, H, Q and R into the update instead of
+        // loading them every frame, and the zero entries drop out of the products.
+
+        template <i32 N, i32 M, typename FMODEL = model_dense_t, typename HMODEL = model_dense_t, typename T = f32>
+        struct kalman_model_t
+        {
+            typedef T value_t;
+
+            matrix_t<N, N, T> F;  // State transition
+            matrix_t<M, N, T> H;  // Measurement mapping
+            matrix_t<N, N, T> Q;  // Process noise covariance
+            matrix_t<M, M, T> R;  // Measurement noise covariance
+        };
+
+        template <i32 N, i32 M, typename T = f32>
+        struct kalman_track_t
+        {
+            typedef T value_t;
+
+            matrix_t<N, M, T> K;  // Kalman Gain
+            matrix_t<N, N, T> P;  // Estimate error covariance
+            matrix_t<N, 1, T> x;  // State vector
+        };
+
+        // F, H, Q and R identity (usable in constant expressions)
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static constexpr void initialize(kalman_model_t<N, M, FM, HM, T>& model)
+        {
+            model.F.setIdentity();
+            model.H.setIdentity();
+            model.Q.setIdentity();
+            model.R.setIdentity();
+        }
+
+        // A full filter with the given model, P identity and x zero
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void initialize(kalman_nd_t<N, M, FM, HM, T>& kf, const kalman_model_t<N, M, FM, HM, T>& model)
+        {
+            initialize(kf);
+            kf.F = model.F;
+            kf.H = model.H;
+            kf.Q = model.Q;
+            kf.R = model.R;
+        }
+
+        template <i32 N, i32 M, typename T>
+        static inline void initialize(kalman_track_t<N, M, T>& track)
+        {
+            track.K.clear();
+            track.P.setIdentity();
+            track.x.clear();
+        }
+
+        template <i32 N, i32 M, typename T>
+        static inline void begin(kalman_track_t<N, M, T>& track, const T initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            track.P.clear();
+            for (i32 i = 0; i < N; ++i)
+            {
+                track.x.data[i][0] = initial_states[i];
+                track.P.data[i][i] = T(initial_uncertainty);
+            }
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void predict(const kalman_model_t<N, M, FM, HM, T>& model, kalman_track_t<N, M, T>& track)
+        {
+            nfilter::predict<FM>(model.F, model.Q, track.x, track.P);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, typename T, typename OBSERVER>
+        static inline void correct(const kalman_model_t<N, M, FM, HM, T>& model, kalman_track_t<N, M, T>& track, const T measurement[M], OBSERVER& observer)
+        {
+            nfilter::correct<HM>(model.H, model.R, measurement, track.x, track.P, track.K, observer);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void correct(const kalman_model_t<N, M, FM, HM, T>& model, kalman_track_t<N, M, T>& track, const T measurement[M])
+        {
+            innovation_ignore_t ignore;
+            nfilter::correct<HM>(model.H, model.R, measurement, track.x, track.P, track.K, ignore);
+        }
+
+        // Same result as update() of a kalman_nd_t with this model and the state of 'track'
+        template <i32 N, i32 M, typename FM, typename HM, typename T>
+        static inline void update(const kalman_model_t<N, M, FM, HM, T>& model, kalman_track_t<N, M, T>& track, const T measurement[M])
+        {
+            predict(model, track);
+            correct(model, track, measurement);
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_MODEL_H__
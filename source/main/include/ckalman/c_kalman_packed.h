@@ -0,0 +1,251 @@
+#ifndef __C_KALMAN_FILTER_PACKED_H__
+#define __C_KALMAN_FILTER_PACKED_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // Symmetric N x N matrix, stores only the upper triangle (N*(N+1)/2 values) packed row by row
+        template <i32 N>
+        struct symmetric_t
+        {
+            enum
+            {
+                SIZE = N * (N + 1) / 2
+            };
+
+            f32 data[SIZE];
+
+            // Packed index of element (i, j), valid for i <= j
+            static inline i32 upper(i32 i, i32 j) { return i * N - (i * (i - 1)) / 2 + (j - i); }
+            static inline i32 index(i32 i, i32 j) { return (i <= j) ? upper(i, j) : upper(j, i); }
+
+            f32  get(i32 i, i32 j) const { return data[index(i, j)]; }
+            void set(i32 i, i32 j, f32 v) { data[index(i, j)] = v; }
+
+            void clear()
+            {
+                for (i32 i = 0; i < SIZE; ++i)
+                    data[i] = 0.0f;
+            }
+
+            void setIdentity()
+            {
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = i; j < N; ++j)
+                        data[upper(i, j)] = (i == j) ? 1.0f : 0.0f;
+            }
+
+            // Expand into a full matrix
+            void toMatrix(matrix_t<N, N>& out) const
+            {
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = 0; j < N; ++j)
+                        out.data[i][j] = get(i, j);
+            }
+
+            // Pack the upper triangle of a (symmetric) full matrix
+            void fromMatrix(const matrix_t<N, N>& in)
+            {
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = i; j < N; ++j)
+                        data[upper(i, j)] = in.data[i][j];
+            }
+        };
+
+        // Diagonal N x N matrix, stores only the N diagonal values
+        template <i32 N>
+        struct diagonal_t
+        {
+            f32 data[N];
+
+            f32  get(i32 i, i32 j) const { return (i == j) ? data[i] : 0.0f; }
+            void clear()
+            {
+                for (i32 i = 0; i < N; ++i)
+                    data[i] = 0.0f;
+            }
+            void setIdentity()
+            {
+                for (i32 i = 0; i < N; ++i)
+                    data[i] = 1.0f;
+            }
+            void toMatrix(matrix_t<N, N>& out) const
+            {
+                for (i32 i = 0; i < N; ++i)
+                    for (i32 j = 0; j < N; ++j)
+                        out.data[i][j] = (i == j) ? data[i] : 0.0f;
+            }
+        };
+
+        // ============================================================================
+        // KALMAN FILTER WITH PACKED COVARIANCES
+        // ============================================================================
+        // Same filter as kalman_nd_t but P is stored packed-symmetric and Q and R are diagonal,
+        // for the 4x2 RD03D filter this is 52 instead of 72 floats per track.
+
+        template <i32 N, i32 M>
+        struct kalman_packed_t
+        {
+            matrix_t<N, N> F;  // State transition
+            matrix_t<N, M> K;  // Kalman Gain
+            symmetric_t<N> P;  // Estimate error covariance
+            diagonal_t<N>  Q;  // Process noise covariance
+            diagonal_t<M>  R;  // Measurement noise covariance
+            matrix_t<M, N> H;  // Measurement mapping
+            matrix_t<N, 1> x;  // State vector
+        };
+
+        template <i32 N, i32 M>
+        static inline void initialize(kalman_packed_t<N, M>& kf)
+        {
+            kf.P.setIdentity();
+            kf.Q.setIdentity();
+            kf.R.setIdentity();
+            kf.x.clear();
+        }
+
+        template <i32 N, i32 M>
+        static inline void begin(kalman_packed_t<N, M>& kf, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            for (i32 i = 0; i < N; ++i)
+                kf.x.data[i][0] = initial_states[i];
+
+            kf.P.clear();
+            for (i32 i = 0; i < N; ++i)
+                kf.P.data[symmetric_t<N>::upper(i, i)] = initial_uncertainty;
+        }
+
+        // Predict + correct, touching only the unique elements of P, Q and R
+        template <i32 N, i32 M>
+        static inline void update(kalman_packed_t<N, M>& kf, const f32 measurement[M])
+        {
+            const f32(&F)[N][N] = kf.F.data;
+            const f32(&H)[M][N] = kf.H.data;
+
+            // --- 1. PREDICT PHASE ---
+            // x_pred = F * x
+            f32 x_pred[N];
+            for (i32 i = 0; i < N; ++i)
+            {
+                f32 sum = 0.0f;
+                for (i32 k = 0; k < N; ++k)
+                    sum += F[i][k] * kf.x.data[k][0];
+                x_pred[i] = sum;
+            }
+
+            // Unpack P into registers, each unique element is read once
+            f32 P[N][N];
+            for (i32 i = 0, e = 0; i < N; ++i)
+            {
+                for (i32 j = i; j < N; ++j, ++e)
+                {
+                    P[i][j] = kf.P.data[e];
+                    P[j][i] = kf.P.data[e];
+                }
+            }
+
+            // FP = F * P
+            f32 FP[N][N];
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = 0; j < N; ++j)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 k = 0; k < N; ++k)
+                        sum += F[i][k] * P[k][j];
+                    FP[i][j] = sum;
+                }
+            }
+
+            // P_pred = FP * F^T + Q (upper triangle, mirrored)
+            f32 Pp[N][N];
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = i; j < N; ++j)
+                {
+                    f32 sum = (i == j) ? kf.Q.data[i] : 0.0f;
+                    for (i32 k = 0; k < N; ++k)
+                        sum += FP[i][k] * F[j][k];
+                    Pp[i][j] = sum;
+                    Pp[j][i] = sum;
+                }
+            }
+
+            // --- 2. MEASUREMENT UPDATE PHASE ---
+            // y = z - H * x_pred
+            f32 y[M];
+            for (i32 m = 0; m < M; ++m)
+            {
+                f32 sum = 0.0f;
+                for (i32 k = 0; k < N; ++k)
+                    sum += H[m][k] * x_pred[k];
+                y[m] = measurement[m] - sum;
+            }
+
+            // PHt = P_pred * H^T
+            f32 PHt[N][M];
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 m = 0; m < M; ++m)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 k = 0; k < N; ++k)
+                        sum += Pp[i][k] * H[m][k];
+                    PHt[i][m] = sum;
+                }
+            }
+
+            // S = H * PHt + R (upper triangle only)
+            f32 S[M][M];
+            for (i32 a = 0; a < M; ++a)
+            {
+                for (i32 b = a; b < M; ++b)
+                {
+                    f32 sum = (a == b) ? kf.R.data[a] : 0.0f;
+                    for (i32 k = 0; k < N; ++k)
+                        sum += H[a][k] * PHt[k][b];
+                    S[a][b] = sum;
+                }
+            }
+
+            f32 S_inv[M][M];
+            nfused::invert_symmetric<M>(S, S_inv);
+
+            // K = PHt * S^-1, x = x_pred + K * y
+            for (i32 i = 0; i < N; ++i)
+            {
+                f32 Ky = 0.0f;
+                for (i32 m = 0; m < M; ++m)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 b = 0; b < M; ++b)
+                        sum += PHt[i][b] * S_inv[b][m];
+                    kf.K.data[i][m] = sum;
+                    Ky += sum * y[m];
+                }
+                kf.x.data[i][0] = x_pred[i] + Ky;
+            }
+
+            // P = P_pred - K * PHt^T (upper triangle only, written back packed)
+            for (i32 i = 0, e = 0; i < N; ++i)
+            {
+                for (i32 j = i; j < N; ++j, ++e)
+                {
+                    f32 sum = Pp[i][j];
+                    for (i32 m = 0; m < M; ++m)
+                        sum -= kf.K.data[i][m] * PHt[j][m];
+                    kf.P.data[e] = sum;
+                }
+            }
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_PACKED_H__
@@ -0,0 +1,185 @@
+#ifndef __C_KALMAN_FILTER_SMOOTHER_H__
+#define __C_KALMAN_FILTER_SMOOTHER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // RAUCH-TUNG-STRIEBEL SMOOTHER (fixed-lag and batch)
+        // ============================================================================
+        // The filter estimate of frame k only uses the measurements up to k. The RTS smoother also
+        // uses the later ones, going backwards from the newest filtered state:
+        //   C_j  = P_j|j F^T P_j+1|j^-1
+        //   xs_j = x_j|j + C_j (xs_j+1 - x_j+1|j)
+        //   Ps_j = P_j|j + C_j (Ps_j+1 - P_j+1|j) C_j^T
+        //
+        // Fixed-lag: a ring of LAG + 1 frames holds the filtered state, the predicted state and C of
+        // every frame. C_j is computed once, when frame j+1 is predicted, so the backward pass over the
+        // ring is O(LAG * N^2) per frame. The smoothed state of frame k - LAG is available after frame k.
+        //
+        // Batch: smooth() runs the filter over a whole recorded track and then the backward pass over
+        // it, in place in the caller's arrays.
+
+        template <i32 N, i32 M, typename FMODEL = model_dense_t, typename HMODEL = model_dense_t, i32 LAG = 8>
+        struct kalman_smoother_t
+        {
+            typedef kalman_nd_t<N, M, FMODEL, HMODEL> filter_t;
+
+            struct frame_t
+            {
+                matrix_t<N, 1> m_xf;  // filtered state x_j|j
+                matrix_t<N, N> m_Pf;  // filtered covariance P_j|j
+                matrix_t<N, 1> m_xp;  // predicted state x_j|j-1
+                matrix_t<N, N> m_C;   // smoother gain C_j, valid once frame j+1 exists
+            };
+
+            filter_t m_filter;
+            frame_t  m_frames[LAG + 1];
+            i32      m_newest;  // ring index of the newest frame
+            i32      m_count;   // frames in the ring
+        };
+
+        namespace nsmoother
+        {
+            // C = Pf F^T Pp^-1, through C^T = Pp^-1 (F Pf) with Pp symmetric positive definite
+            template <i32 N, i32 M, typename FM, typename HM>
+            static inline void gain(const kalman_nd_t<N, M, FM, HM>& kf, const matrix_t<N, N>& Pf, const matrix_t<N, N>& Pp, matrix_t<N, N>& C)
+            {
+                matrix_t<N, N> FP;
+                FM::mul(kf.F, Pf, FP);
+
+                matrix_t<N, N> LD;
+                if (!Pp.decomposeLDLT(LD))
+                {
+                    C.clear();
+                    return;
+                }
+                matrix_t<N, N> C_trans;
+                LD.solveLDLT(FP, C_trans);
+                C_trans.transpose(C);
+            }
+        }  // namespace nsmoother
+
+        // F, Q, R and H of m_filter still have to be set up
+        template <i32 N, i32 M, typename FM, typename HM, i32 L>
+        static inline void initialize(kalman_smoother_t<N, M, FM, HM, L>& sm)
+        {
+            initialize(sm.m_filter);
+            sm.m_newest = 0;
+            sm.m_count  = 0;
+        }
+
+        // Restarts the filter and empties the ring
+        template <i32 N, i32 M, typename FM, typename HM, i32 L>
+        static inline void begin(kalman_smoother_t<N, M, FM, HM, L>& sm, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            begin(sm.m_filter, initial_states, initial_uncertainty);
+            sm.m_newest = 0;
+            sm.m_count  = 0;
+        }
+
+        // Runs the filter on 'measurement' (m_filter.x is the usual forward estimate afterwards).
+        // Returns true when 'smoothed' holds the smoothed state of the frame LAG frames ago.
+        template <i32 N, i32 M, typename FM, typename HM, i32 L>
+        static bool update(kalman_smoother_t<N, M, FM, HM, L>& sm, const f32 measurement[M], matrix_t<N, 1>& smoothed)
+        {
+            typedef typename kalman_smoother_t<N, M, FM, HM, L>::frame_t frame_t;
+            const i32                                                   RING = L + 1;
+
+            predict(sm.m_filter);
+            if (sm.m_count > 0)
+            {
+                frame_t& previous = sm.m_frames[sm.m_newest];
+                nsmoother::gain(sm.m_filter, previous.m_Pf, sm.m_filter.P, previous.m_C);
+            }
+            const matrix_t<N, 1> x_pred = sm.m_filter.x;
+            correct(sm.m_filter, measurement);
+
+            sm.m_newest     = (sm.m_count == 0) ? 0 : ((sm.m_newest + 1) % RING);
+            sm.m_count      = (sm.m_count < RING) ? (sm.m_count + 1) : RING;
+            frame_t& newest = sm.m_frames[sm.m_newest];
+            newest.m_xf     = sm.m_filter.x;
+            newest.m_Pf     = sm.m_filter.P;
+            newest.m_xp     = x_pred;
+            if (sm.m_count < RING)
+                return false;
+
+            // Backward pass from the newest frame to the oldest one in the ring
+            smoothed = newest.m_xf;
+            i32 next = sm.m_newest;
+            for (i32 k = 1; k < RING; ++k)
+            {
+                const i32      j = (sm.m_newest + RING - k) % RING;
+                const frame_t& f = sm.m_frames[j];
+                matrix_t<N, 1> innovation;
+                smoothed.subtract(sm.m_frames[next].m_xp, innovation);
+                matrix_t<N, 1> correction;
+                f.m_C.multiply(innovation, correction);
+                f.m_xf.add(correction, smoothed);
+                next = j;
+            }
+            return true;
+        }
+
+        // Batch smoothing of a recorded track: runs 'kf' (copied, F, Q, R, H and the initial state and
+        // covariance are used as they are) over 'count' measurements and writes the smoothed states and
+        // covariances to 'xs' and 'Ps'. The arrays first receive the filtered estimates, the backward pass
+        // replaces them in place, so no memory besides the caller's arrays is needed.
+        template <i32 N, i32 M, typename FM, typename HM>
+        static void smooth(const kalman_nd_t<N, M, FM, HM>& kf, const f32 measurements[][M], i32 count, matrix_t<N, 1> xs[], matrix_t<N, N> Ps[])
+        {
+            kalman_nd_t<N, M, FM, HM> filter = kf;
+            for (i32 i = 0; i < count; ++i)
+            {
+                update(filter, measurements[i]);
+                xs[i] = filter.x;
+                Ps[i] = filter.P;
+            }
+
+            for (i32 j = count - 2; j >= 0; --j)
+            {
+                // Prediction of frame j+1 from the filtered frame j
+                matrix_t<N, 1> xp;
+                FM::mul(filter.F, xs[j], xp);
+                matrix_t<N, N> FP;
+                FM::mul(filter.F, Ps[j], FP);
+                matrix_t<N, N> FPFt;
+                FM::mul_transposed(FP, filter.F, FPFt);
+                matrix_t<N, N> Pp;
+                FPFt.add(filter.Q, Pp);
+
+                matrix_t<N, N> C;
+                nsmoother::gain(filter, Ps[j], Pp, C);
+
+                // xs_j = x_j|j + C (xs_j+1 - x_j+1|j)
+                matrix_t<N, 1> dx;
+                xs[j + 1].subtract(xp, dx);
+                matrix_t<N, 1> Cdx;
+                C.multiply(dx, Cdx);
+                matrix_t<N, 1> x = xs[j];
+                x.add(Cdx, xs[j]);
+
+                // Ps_j = P_j|j + C (Ps_j+1 - P_j+1|j) C^T
+                matrix_t<N, N> dP;
+                Ps[j + 1].subtract(Pp, dP);
+                matrix_t<N, N> CdP;
+                C.multiply(dP, CdP);
+                matrix_t<N, N> Ct;
+                C.transpose(Ct);
+                matrix_t<N, N> CdPCt;
+                CdP.multiply(Ct, CdPCt);
+                matrix_t<N, N> P = Ps[j];
+                P.add(CdPCt, Ps[j]);
+            }
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_SMOOTHER_H__
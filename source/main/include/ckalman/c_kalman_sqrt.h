@@ -0,0 +1,242 @@
+#ifndef __C_KALMAN_FILTER_SQRT_H__
+#define __C_KALMAN_FILTER_SQRT_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // SQUARE-ROOT (CHOLESKY FACTOR) KALMAN FILTER
+        // ============================================================================
+        // Propagates a lower triangular S with P = S S^T instead of P. Every step is an orthogonal
+        // (Householder) triangularization, so P stays symmetric and positive semi-definite by
+        // construction and f32 keeps about twice the significant digits of P compared to the
+        // covariance form, where (I - K H) P_pred slowly loses symmetry and definiteness.
+        //
+        // Predict, with Sq the Cholesky factor of Q:
+        //   [F S | Sq]^T = Q R      ->  S_pred = R^T                  (P_pred = F P F^T + Q)
+        // Correct, with Sr the Cholesky factor of R (array form):
+        //   | Sr  H S_pred |        | X  0  |    X X^T = H P_pred H^T + R
+        //   | 0   S_pred   | * T  = | Y  S  |    K     = Y X^-1
+        // with T orthogonal, again from a QR decomposition of the transposed pre-array.
+
+        template <i32 N, i32 M, typename FMODEL = model_dense_t, typename HMODEL = model_dense_t>
+        struct kalman_sqrt_t
+        {
+            matrix_t<N, N> F;   // State transition
+            matrix_t<M, N> H;   // Measurement mapping
+            matrix_t<N, N> Sq;  // Cholesky factor of the process noise covariance Q
+            matrix_t<M, M> Sr;  // Cholesky factor of the measurement noise covariance R
+            matrix_t<N, N> S;   // Cholesky factor of the error covariance P (lower triangular)
+            matrix_t<N, M> K;   // Kalman Gain
+            matrix_t<N, 1> x;   // State vector
+        };
+
+        namespace nsqrt
+        {
+            // Householder QR in place: A becomes R (upper triangular in the first COLS rows, zero below).
+            // Q is not formed, only R is needed.
+            template <i32 ROWS, i32 COLS>
+            static inline void triangularize(f32 (&A)[ROWS][COLS])
+            {
+                static_assert(ROWS >= COLS, "triangularize() requires at least as many rows as columns");
+                for (i32 c = 0; c < COLS; ++c)
+                {
+                    f32 norm2 = 0.0f;
+                    for (i32 r = c; r < ROWS; ++r)
+                        norm2 += A[r][c] * A[r][c];
+                    if (norm2 == 0.0f)
+                        continue;
+
+                    // v = a + sign(a0) |a| e0, H = I - 2 v v^T / (v^T v) maps a to -sign(a0) |a| e0
+                    const f32 norm  = sqrtf(norm2);
+                    const f32 alpha = (A[c][c] >= 0.0f) ? -norm : norm;
+                    const f32 v0    = A[c][c] - alpha;
+                    const f32 vtv   = norm2 - A[c][c] * A[c][c] + v0 * v0;
+                    const f32 beta  = 2.0f / vtv;
+
+                    A[c][c] = alpha;
+                    for (i32 k = c + 1; k < COLS; ++k)
+                    {
+                        f32 dot = v0 * A[c][k];
+                        for (i32 r = c + 1; r < ROWS; ++r)
+                            dot += A[r][c] * A[r][k];
+                        const f32 s = beta * dot;
+                        A[c][k] -= s * v0;
+                        for (i32 r = c + 1; r < ROWS; ++r)
+                            A[r][k] -= s * A[r][c];
+                    }
+                    for (i32 r = c + 1; r < ROWS; ++r)
+                        A[r][c] = 0.0f;
+                }
+            }
+        }  // namespace nsqrt
+
+        // Lower triangular L with A = L L^T for a symmetric positive definite A (through LDL^T).
+        // Returns false (L zero) when A is not positive definite.
+        template <i32 N>
+        static inline bool cholesky(const matrix_t<N, N>& A, matrix_t<N, N>& L)
+        {
+            matrix_t<N, N> LD;
+            if (!A.decomposeLDLT(LD))
+            {
+                L.clear();
+                return false;
+            }
+            for (i32 j = 0; j < N; ++j)
+            {
+                const f32 d = sqrtf(LD.data[j][j]);
+                L.data[j][j] = d;
+                for (i32 i = 0; i < N; ++i)
+                {
+                    if (i > j)
+                        L.data[i][j] = LD.data[i][j] * d;
+                    else if (i < j)
+                        L.data[i][j] = 0.0f;
+                }
+            }
+            return true;
+        }
+
+        // Takes F, H, x and the Cholesky factors of Q, R and P from a covariance-form filter
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline bool initialize(kalman_sqrt_t<N, M, FM, HM>& sf, const kalman_nd_t<N, M, FM, HM>& kf)
+        {
+            sf.F = kf.F;
+            sf.H = kf.H;
+            sf.K = kf.K;
+            sf.x = kf.x;
+            bool ok = cholesky(kf.Q, sf.Sq);
+            ok      = cholesky(kf.R, sf.Sr) && ok;
+            ok      = cholesky(kf.P, sf.S) && ok;
+            return ok;
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void begin(kalman_sqrt_t<N, M, FM, HM>& sf, const f32 initial_states[N], f32 initial_uncertainty = 1.0f)
+        {
+            const f32 s = sqrtf(initial_uncertainty);
+            sf.S.clear();
+            for (i32 i = 0; i < N; ++i)
+            {
+                sf.x.data[i][0] = initial_states[i];
+                sf.S.data[i][i] = s;
+            }
+        }
+
+        // x = F x, S = triangular factor of [F S | Sq]
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void predict(kalman_sqrt_t<N, M, FM, HM>& sf)
+        {
+            matrix_t<N, 1> x_pred;
+            FM::mul(sf.F, sf.x, x_pred);
+            sf.x = x_pred;
+
+            matrix_t<N, N> FS;
+            FM::mul(sf.F, sf.S, FS);
+
+            // Rows of the transposed pre-array [F S | Sq]^T
+            f32 A[2 * N][N];
+            for (i32 r = 0; r < N; ++r)
+            {
+                for (i32 c = 0; c < N; ++c)
+                {
+                    A[r][c]     = FS.data[c][r];
+                    A[N + r][c] = sf.Sq.data[c][r];
+                }
+            }
+            nsqrt::triangularize(A);
+
+            for (i32 r = 0; r < N; ++r)
+                for (i32 c = 0; c < N; ++c)
+                    sf.S.data[r][c] = (c <= r) ? A[c][r] : 0.0f;
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void correct(kalman_sqrt_t<N, M, FM, HM>& sf, const f32 measurement[M])
+        {
+            matrix_t<M, N> HS;
+            HM::mul(sf.H, sf.S, HS);
+
+            // Transposed pre-array | Sr  H S |^T
+            //                      | 0   S   |
+            f32 A[M + N][M + N];
+            for (i32 r = 0; r < M; ++r)
+            {
+                for (i32 c = 0; c < M; ++c)
+                    A[r][c] = sf.Sr.data[c][r];
+                for (i32 c = 0; c < N; ++c)
+                    A[r][M + c] = 0.0f;
+            }
+            for (i32 r = 0; r < N; ++r)
+            {
+                for (i32 c = 0; c < M; ++c)
+                    A[M + r][c] = HS.data[c][r];
+                for (i32 c = 0; c < N; ++c)
+                    A[M + r][M + c] = sf.S.data[c][r];
+            }
+            nsqrt::triangularize(A);
+
+            // Post-array (transpose of A): X = A[0..M)[0..M)^T, Y = A[0..M)[M..M+N)^T, S = A[M..)[M..)^T
+            // K = Y X^-1, solved per row of K with X lower triangular: K X = Y
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = M - 1; j >= 0; --j)
+                {
+                    f32 sum = A[j][M + i];  // Y[i][j]
+                    for (i32 k = j + 1; k < M; ++k)
+                        sum -= sf.K.data[i][k] * A[j][k];  // K[i][k] * X[k][j]
+                    sf.K.data[i][j] = sum / A[j][j];
+                }
+            }
+            for (i32 r = 0; r < N; ++r)
+                for (i32 c = 0; c < N; ++c)
+                    sf.S.data[r][c] = (c <= r) ? A[M + c][M + r] : 0.0f;
+
+            // x = x + K (z - H x)
+            matrix_t<M, 1> Hx;
+            HM::mul(sf.H, sf.x, Hx);
+            for (i32 i = 0; i < N; ++i)
+            {
+                f32 sum = sf.x.data[i][0];
+                for (i32 m = 0; m < M; ++m)
+                    sum += sf.K.data[i][m] * (measurement[m] - Hx.data[m][0]);
+                sf.x.data[i][0] = sum;
+            }
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update(kalman_sqrt_t<N, M, FM, HM>& sf, const f32 measurement[M])
+        {
+            predict(sf);
+            correct(sf, measurement);
+        }
+
+        // P = S S^T
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void getCovariance(const kalman_sqrt_t<N, M, FM, HM>& sf, matrix_t<N, N>& P)
+        {
+            for (i32 i = 0; i < N; ++i)
+            {
+                for (i32 j = 0; j <= i; ++j)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 k = 0; k <= j; ++k)
+                        sum += sf.S.data[i][k] * sf.S.data[j][k];
+                    P.data[i][j] = sum;
+                    P.data[j][i] = sum;
+                }
+            }
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_SQRT_H__
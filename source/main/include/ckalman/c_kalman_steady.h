@@ -0,0 +1,197 @@
+#ifndef __C_KALMAN_FILTER_STEADY_H__
+#define __C_KALMAN_FILTER_STEADY_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // STEADY-STATE (GAIN-ONLY) KALMAN FILTER
+        // ============================================================================
+        // With constant F, H, Q and R the covariance P and gain K converge to fixed values
+        // (the solution of the discrete algebraic Riccati equation). From then on the update
+        // reduces to x = F x + K (z - H F x), which costs O(N*N + N*M) instead of O(N^3).
+
+        // Iterates the Riccati recursion of 'kf' (starting from kf.P) until the gain changes less than
+        // 'tolerance' per element. Writes the converged gain and posterior covariance, 'kf' is not modified.
+        // Returns false when it did not converge within 'maxIterations'.
+        template <i32 N, i32 M, typename FM, typename HM>
+        static bool solve_steady_state(const kalman_nd_t<N, M, FM, HM>& kf, matrix_t<N, M>& K, matrix_t<N, N>& P, f32 tolerance = 1e-6f, i32 maxIterations = 1000)
+        {
+            // The covariance recursion does not depend on the measurements, so iterate on a copy with z = H x
+            kalman_nd_t<N, M, FM, HM> riccati = kf;
+            riccati.x.clear();
+            riccati.K.clear();
+
+            const f32 z[M] = {};
+            for (i32 it = 0; it < maxIterations; ++it)
+            {
+                const matrix_t<N, M> K_prev = riccati.K;
+                update(riccati, z);
+
+                f32 delta = 0.0f;
+                for (i32 i = 0; i < N; ++i)
+                {
+                    for (i32 j = 0; j < M; ++j)
+                    {
+                        const f32 d = riccati.K.data[i][j] - K_prev.data[i][j];
+                        delta       = (d > delta) ? d : ((-d > delta) ? -d : delta);
+                    }
+                }
+
+                if (delta < tolerance)
+                {
+                    K = riccati.K;
+                    P = riccati.P;
+                    return true;
+                }
+            }
+            K = riccati.K;
+            P = riccati.P;
+            return false;
+        }
+
+        namespace nsteady
+        {
+            // x = F x + K (z - H F x) on separate model, gain and state matrices, shared by the gain-only
+            // update of kalman_nd_t and kalman_steady_t
+            template <typename FM, typename HM, i32 N, i32 M>
+            static inline void update(const matrix_t<N, N>& F, const matrix_t<M, N>& H, const matrix_t<N, M>& K, matrix_t<N, 1>& x, const f32 measurement[M])
+            {
+                matrix_t<N, 1> x_pred;
+                FM::mul(F, x, x_pred);
+
+                matrix_t<M, 1> H_xpred;
+                HM::mul(H, x_pred, H_xpred);
+
+                for (i32 i = 0; i < N; ++i)
+                {
+                    f32 sum = x_pred.data[i][0];
+                    for (i32 m = 0; m < M; ++m)
+                        sum += K.data[i][m] * (measurement[m] - H_xpred.data[m][0]);
+                    x.data[i][0] = sum;
+                }
+            }
+        }  // namespace nsteady
+
+        // Gain-only update on a regular filter that has reached steady state: x = F x + K (z - H F x).
+        // kf.K and kf.P are left untouched (P stays at its converged value).
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update_steady(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M])
+        {
+            nsteady::update<FM, HM>(kf.F, kf.H, kf.K, kf.x, measurement);
+        }
+
+        // Compact gain-only filter: only the model, the converged gain and the state
+        template <i32 N, i32 M, typename FMODEL = model_dense_t, typename HMODEL = model_dense_t>
+        struct kalman_steady_t
+        {
+            matrix_t<N, N> F;  // State transition
+            matrix_t<M, N> H;  // Measurement mapping
+            matrix_t<N, M> K;  // Steady-state Kalman Gain
+            matrix_t<N, 1> x;  // State vector
+        };
+
+        // Solve the steady-state gain of 'kf' and set up a gain-only filter with it, the state is copied from 'kf'
+        template <i32 N, i32 M, typename FM, typename HM>
+        static bool initialize(kalman_steady_t<N, M, FM, HM>& ss, const kalman_nd_t<N, M, FM, HM>& kf, f32 tolerance = 1e-6f, i32 maxIterations = 1000)
+        {
+            matrix_t<N, N> P;
+            const bool     converged = solve_steady_state(kf, ss.K, P, tolerance, maxIterations);
+            ss.F                     = kf.F;
+            ss.H                     = kf.H;
+            ss.x                     = kf.x;
+            return converged;
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void begin(kalman_steady_t<N, M, FM, HM>& ss, const f32 initial_states[N])
+        {
+            for (i32 i = 0; i < N; ++i)
+                ss.x.data[i][0] = initial_states[i];
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update(kalman_steady_t<N, M, FM, HM>& ss, const f32 measurement[M])
+        {
+            nsteady::update<FM, HM>(ss.F, ss.H, ss.K, ss.x, measurement);
+        }
+
+        // ----------------------------------------------------------------------------
+        // Automatic switch from the full filter to the gain-only update
+        // ----------------------------------------------------------------------------
+        // Runs the full update() until the gain has changed less than 'tolerance' per element for
+        // 'requiredFrames' consecutive updates, then switches to update_steady(). Call reset() whenever
+        // the filter is restarted with begin() or its model changes.
+
+        struct convergence_t
+        {
+            f32  m_tolerance;
+            i32  m_requiredFrames;
+            i32  m_stableFrames;
+            bool m_converged;
+        };
+
+        static inline void initialize(convergence_t& cs, f32 tolerance = 1e-4f, i32 requiredFrames = 5)
+        {
+            cs.m_tolerance      = tolerance;
+            cs.m_requiredFrames = requiredFrames;
+            cs.m_stableFrames   = 0;
+            cs.m_converged      = false;
+        }
+
+        static inline void reset(convergence_t& cs)
+        {
+            cs.m_stableFrames = 0;
+            cs.m_converged    = false;
+        }
+
+        static inline bool isConverged(const convergence_t& cs) { return cs.m_converged; }
+
+        // Counts the stable frames after a full update that changed the gain from 'K_prev' to 'K'
+        template <i32 N, i32 M>
+        static inline void track(convergence_t& cs, const matrix_t<N, M>& K_prev, const matrix_t<N, M>& K)
+        {
+            bool stable = true;
+            for (i32 i = 0; i < N && stable; ++i)
+            {
+                for (i32 j = 0; j < M; ++j)
+                {
+                    const f32 d = K.data[i][j] - K_prev.data[i][j];
+                    if (d > cs.m_tolerance || -d > cs.m_tolerance)
+                    {
+                        stable = false;
+                        break;
+                    }
+                }
+            }
+
+            cs.m_stableFrames = stable ? (cs.m_stableFrames + 1) : 0;
+            cs.m_converged    = cs.m_stableFrames >= cs.m_requiredFrames;
+        }
+
+        // Returns true when the update ran in gain-only mode
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline bool update(kalman_nd_t<N, M, FM, HM>& kf, convergence_t& cs, const f32 measurement[M])
+        {
+            if (cs.m_converged)
+            {
+                update_steady(kf, measurement);
+                return true;
+            }
+
+            const matrix_t<N, M> K_prev = kf.K;
+            update(kf, measurement);
+            track(cs, K_prev, kf.K);
+            return false;
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_STEADY_H__
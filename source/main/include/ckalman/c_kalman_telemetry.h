@@ -0,0 +1,294 @@
+#ifndef __C_KALMAN_FILTER_TELEMETRY_H__
+#define __C_KALMAN_FILTER_TELEMETRY_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_ekf.h"
+#include "ckalman/c_kalman_steady.h"
+
+#if defined(CKALMAN_TELEMETRY)
+#    include <atomic>
+#    include <chrono>
+#    include <cmath>
+#endif
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // TELEMETRY (compile-time optional)
+        // ============================================================================
+        // Define CKALMAN_TELEMETRY for the whole build to keep running statistics of the filters:
+        // - normalized innovation squared NIS = y^T S^-1 y (mean and variance, a consistent filter
+        //   has a mean NIS equal to the measurement dimension M)
+        // - Frobenius norm of the gain K
+        // - latency histogram of the updates
+        // - track spawns, drops and coasts of processFrame() (rd03d_t::m_telemetry)
+        //
+        // Without CKALMAN_TELEMETRY telemetry_t is empty, the update() overloads below forward to the
+        // plain updates and rd03d_t has no telemetry member: nothing is left in the hot path.
+        //
+        // The counters are relaxed atomics with a single writer (the thread that runs the filter) and
+        // any number of readers, a monitoring thread can read them at any time without locks. A reader
+        // may see the fields of one update partially applied. Counters and sums are 64 bit where 64-bit
+        // atomics are lock-free and 32 bit (u32, f32) elsewhere, e.g. on 32-bit microcontrollers; there
+        // the counters wrap after 2^32 updates and the f32 sums lose precision after about 10^6 updates,
+        // call initialize() from the writer to start a new window.
+
+        enum telemetry_config_t
+        {
+            TELEMETRY_LATENCY_BUCKETS = 20  // bucket i counts updates of [2^i, 2^(i+1)) ns, the last one everything above
+        };
+
+#if defined(CKALMAN_TELEMETRY)
+
+#    if ATOMIC_LLONG_LOCK_FREE == 2
+        typedef u64 telemetry_count_t;
+        typedef f64 telemetry_sum_t;
+#    else
+        static_assert(ATOMIC_INT_LOCK_FREE == 2, "telemetry counters need lock-free 32-bit atomics");
+        typedef u32 telemetry_count_t;
+        typedef f32 telemetry_sum_t;
+#    endif
+
+        struct telemetry_t
+        {
+            std::atomic<telemetry_count_t> m_updates;        // full updates (NIS and gain statistics)
+            std::atomic<telemetry_count_t> m_steadyUpdates;  // gain-only updates
+            std::atomic<telemetry_sum_t>   m_nisSum;
+            std::atomic<telemetry_sum_t>   m_nisSumSq;
+            std::atomic<telemetry_sum_t>   m_gainNormSum;
+            std::atomic<telemetry_sum_t>   m_gainNormMax;
+            std::atomic<telemetry_count_t> m_latency[TELEMETRY_LATENCY_BUCKETS];
+            std::atomic<telemetry_count_t> m_spawns;
+            std::atomic<telemetry_count_t> m_drops;
+            std::atomic<telemetry_count_t> m_coasts;  // coasting tracks that were detected again
+        };
+
+        namespace ntelemetry
+        {
+            // Single writer: a plain load/store pair, no read-modify-write instruction is needed
+            template <typename V>
+            static inline void add(std::atomic<V>& a, V v)
+            {
+                a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+            }
+
+            static inline u64 now_ns() { return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+            static inline void latency(telemetry_t& t, u64 ns)
+            {
+                i32 bucket = 0;
+                while (ns > 1 && bucket < TELEMETRY_LATENCY_BUCKETS - 1)
+                {
+                    ns >>= 1;
+                    ++bucket;
+                }
+                add(t.m_latency[bucket], (telemetry_count_t)1);
+            }
+
+            // Observer of correct(), accumulates NIS and gain norm
+            struct observer_t
+            {
+                telemetry_t* m_telemetry;
+
+                template <i32 N, i32 M>
+                inline void operator()(const matrix_t<M, 1>& y, const matrix_t<M, M>& S, const matrix_t<N, M>& K) const
+                {
+                    // NIS = y^T S^-1 y, through LDL^T so that it works for every M
+                    f64            nis = 0.0;
+                    matrix_t<M, M> LD;
+                    matrix_t<M, 1> Sy;
+                    if (S.decomposeLDLT(LD))
+                    {
+                        LD.solveLDLT(y, Sy);
+                        for (i32 i = 0; i < M; ++i)
+                            nis += (f64)y.data[i][0] * (f64)Sy.data[i][0];
+                    }
+
+                    f64 gain = 0.0;
+                    for (i32 i = 0; i < N; ++i)
+                        for (i32 j = 0; j < M; ++j)
+                            gain += (f64)K.data[i][j] * (f64)K.data[i][j];
+                    gain = sqrt(gain);
+
+                    telemetry_t& t = *m_telemetry;
+                    add(t.m_updates, (telemetry_count_t)1);
+                    add(t.m_nisSum, (telemetry_sum_t)nis);
+                    add(t.m_nisSumSq, (telemetry_sum_t)(nis * nis));
+                    add(t.m_gainNormSum, (telemetry_sum_t)gain);
+                    if ((telemetry_sum_t)gain > t.m_gainNormMax.load(std::memory_order_relaxed))
+                        t.m_gainNormMax.store((telemetry_sum_t)gain, std::memory_order_relaxed);
+                }
+            };
+        }  // namespace ntelemetry
+
+        static inline void initialize(telemetry_t& t)
+        {
+            t.m_updates.store(0, std::memory_order_relaxed);
+            t.m_steadyUpdates.store(0, std::memory_order_relaxed);
+            t.m_nisSum.store(0, std::memory_order_relaxed);
+            t.m_nisSumSq.store(0, std::memory_order_relaxed);
+            t.m_gainNormSum.store(0, std::memory_order_relaxed);
+            t.m_gainNormMax.store(0, std::memory_order_relaxed);
+            for (i32 i = 0; i < TELEMETRY_LATENCY_BUCKETS; ++i)
+                t.m_latency[i].store(0, std::memory_order_relaxed);
+            t.m_spawns.store(0, std::memory_order_relaxed);
+            t.m_drops.store(0, std::memory_order_relaxed);
+            t.m_coasts.store(0, std::memory_order_relaxed);
+        }
+
+        // Full update with NIS, gain and latency statistics
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t& t)
+        {
+            const u64                    start    = ntelemetry::now_ns();
+            const ntelemetry::observer_t observer = {&t};
+            predict(kf);
+            correct(kf, measurement, observer);
+            ntelemetry::latency(t, ntelemetry::now_ns() - start);
+        }
+
+        // update_ekf<HF>(kf, measurement) with statistics, the NIS of the range/angle (or other h(x)) innovation
+        template <typename HF, i32 N, i32 M, typename FM, typename HM>
+        static inline void update_ekf(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t& t)
+        {
+            const u64                    start    = ntelemetry::now_ns();
+            const ntelemetry::observer_t observer = {&t};
+            predict(kf);
+            correct_ekf<HF>(kf, measurement, observer);
+            ntelemetry::latency(t, ntelemetry::now_ns() - start);
+        }
+
+        // Corrections alone (after a separate predict) add to the NIS and gain statistics, not to the latency
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void correct(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t& t)
+        {
+            const ntelemetry::observer_t observer = {&t};
+            correct(kf, measurement, observer);
+        }
+
+        template <typename HF, i32 N, i32 M, typename FM, typename HM>
+        static inline void correct_ekf(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t& t)
+        {
+            const ntelemetry::observer_t observer = {&t};
+            correct_ekf<HF>(kf, measurement, observer);
+        }
+
+        // update(kf, cs, measurement) with statistics, gain-only updates only count and time
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline bool update(kalman_nd_t<N, M, FM, HM>& kf, convergence_t& cs, const f32 measurement[M], telemetry_t& t)
+        {
+            const u64 start = ntelemetry::now_ns();
+            if (cs.m_converged)
+            {
+                update_steady(kf, measurement);
+                ntelemetry::add(t.m_steadyUpdates, (telemetry_count_t)1);
+                ntelemetry::latency(t, ntelemetry::now_ns() - start);
+                return true;
+            }
+
+            const matrix_t<N, M>         K_prev   = kf.K;
+            const ntelemetry::observer_t observer = {&t};
+            predict(kf);
+            correct(kf, measurement, observer);
+            track(cs, K_prev, kf.K);
+            ntelemetry::latency(t, ntelemetry::now_ns() - start);
+            return false;
+        }
+
+        static inline void onSpawn(telemetry_t& t) { ntelemetry::add(t.m_spawns, (telemetry_count_t)1); }
+        static inline void onDrop(telemetry_t& t) { ntelemetry::add(t.m_drops, (telemetry_count_t)1); }
+        static inline void onCoast(telemetry_t& t) { ntelemetry::add(t.m_coasts, (telemetry_count_t)1); }
+
+        // Mean and (population) variance of the NIS over all full updates
+        static inline f64 getNisMean(const telemetry_t& t)
+        {
+            const u64 n = t.m_updates.load(std::memory_order_relaxed);
+            return (n > 0) ? (t.m_nisSum.load(std::memory_order_relaxed) / (f64)n) : 0.0;
+        }
+
+        static inline f64 getNisVariance(const telemetry_t& t)
+        {
+            const u64 n = t.m_updates.load(std::memory_order_relaxed);
+            if (n == 0)
+                return 0.0;
+            const f64 mean = t.m_nisSum.load(std::memory_order_relaxed) / (f64)n;
+            const f64 var  = t.m_nisSumSq.load(std::memory_order_relaxed) / (f64)n - mean * mean;
+            return (var > 0.0) ? var : 0.0;
+        }
+
+        static inline f64 getGainNormMean(const telemetry_t& t)
+        {
+            const u64 n = t.m_updates.load(std::memory_order_relaxed);
+            return (n > 0) ? (t.m_gainNormSum.load(std::memory_order_relaxed) / (f64)n) : 0.0;
+        }
+
+        // Upper bound in ns of the bucket that contains the given fraction (0..1) of all updates
+        static inline u64 getLatencyPercentile(const telemetry_t& t, f64 fraction)
+        {
+            u64 total = 0;
+            for (i32 i = 0; i < TELEMETRY_LATENCY_BUCKETS; ++i)
+                total += t.m_latency[i].load(std::memory_order_relaxed);
+            const u64 target = (u64)(fraction * (f64)total);
+            u64       seen   = 0;
+            for (i32 i = 0; i < TELEMETRY_LATENCY_BUCKETS; ++i)
+            {
+                seen += t.m_latency[i].load(std::memory_order_relaxed);
+                if (seen > target || seen == total)
+                    return (u64)2 << i;
+            }
+            return (u64)2 << (TELEMETRY_LATENCY_BUCKETS - 1);
+        }
+
+#else
+
+        struct telemetry_t
+        {
+        };
+
+        static inline void initialize(telemetry_t&) {}
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void update(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t&)
+        {
+            update(kf, measurement);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline bool update(kalman_nd_t<N, M, FM, HM>& kf, convergence_t& cs, const f32 measurement[M], telemetry_t&)
+        {
+            return update(kf, cs, measurement);
+        }
+
+        template <typename HF, i32 N, i32 M, typename FM, typename HM>
+        static inline void update_ekf(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t&)
+        {
+            update_ekf<HF>(kf, measurement);
+        }
+
+        template <i32 N, i32 M, typename FM, typename HM>
+        static inline void correct(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t&)
+        {
+            correct(kf, measurement);
+        }
+
+        template <typename HF, i32 N, i32 M, typename FM, typename HM>
+        static inline void correct_ekf(kalman_nd_t<N, M, FM, HM>& kf, const f32 measurement[M], telemetry_t&)
+        {
+            correct_ekf<HF>(kf, measurement);
+        }
+
+        static inline void onSpawn(telemetry_t&) {}
+        static inline void onDrop(telemetry_t&) {}
+        static inline void onCoast(telemetry_t&) {}
+
+#endif
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_TELEMETRY_H__
@@ -0,0 +1,525 @@
+#ifndef __C_KALMAN_FILTER_TRACKER_H__
+#define __C_KALMAN_FILTER_TRACKER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_model.h"
+#include "ckalman/c_rd03d.h"
+
+#include <cmath>
+#include <string.h>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // MULTI-TARGET TRACKER
+        // ============================================================================
+        // rd03d_t keeps one filter per sensor ID (3 slots) and trusts the ID the sensor reports. The
+        // tracker here associates measurements to tracks itself, so it works for any number of targets
+        // and keeps its track IDs when the sensor swaps its own:
+        //
+        // 1. Every active track is predicted and its innovation covariance S = H P H^T + R inverted.
+        // 2. The measurements are bucketed in a uniform grid (cells of m_cellSize meters, hashed into
+        //    BUCKETS buckets). A track only visits the cells its gate can reach, so association costs
+        //    O(tracks + measurements) for targets that are spread out instead of O(tracks * measurements).
+        // 3. A measurement is a candidate for a track when its Mahalanobis distance d^2 = y^T S^-1 y is
+        //    within m_gate (chi-square quantile, 9.21 = 99% for 2 measured dimensions).
+        // 4. The candidates are assigned greedily (smallest d^2 first) or by an auction, which minimizes
+        //    the total d^2 (within 'tracks * epsilon', a missed track costs m_gate) where greedy can pick
+        //    a pair that forces a worse one, e.g. when targets cross.
+        // 5. Assigned tracks are corrected, unassigned tracks coast (predicted only) and are dropped after
+        //    m_maxMissed frames, unassigned measurements start new tracks while slots are free.
+        //
+        // The first two measured dimensions are the position used by the grid. All memory is part of
+        // the tracker (no allocation per frame), the active tracks are a dense list so inactive slots are
+        // never visited. The model is shared by all tracks (kalman_model_t), a track only keeps x, P and K.
+
+        enum tracker_solver_t
+        {
+            TRACKER_GREEDY  = 0,
+            TRACKER_AUCTION = 1
+        };
+
+        namespace ntracker
+        {
+            static constexpr i32 pow2(i32 n, i32 p = 1) { return (p >= n) ? p : pow2(n, p * 2); }
+        }  // namespace ntracker
+
+        template <i32 CAPACITY, i32 MEASUREMENTS = CAPACITY, i32 N = STATE_DIM, i32 M = MEASURE_DIM, typename FMODEL = model_constant_velocity_t, typename HMODEL = model_select_t<0, 1> >
+        struct tracker_t
+        {
+            static_assert(M >= 2, "the tracker needs at least two measured dimensions (the position)");
+
+            enum
+            {
+                BUCKETS    = ntracker::pow2(2 * MEASUREMENTS),
+                CANDIDATES = 8 * CAPACITY  // gated (track, measurement) pairs per frame, further pairs are dropped
+            };
+
+            typedef kalman_model_t<N, M, FMODEL, HMODEL> model_t;
+            typedef kalman_track_t<N, M>                 track_t;
+
+            model_t          m_model;
+            tracker_solver_t m_solver;
+            f32              m_gate;                // chi-square gate on d^2
+            f32              m_cellSize;            // grid cell size in meters
+            f32              m_initialUncertainty;  // P of a new track
+            i32              m_maxMissed;           // a track is dropped after this many missed frames
+            u32              m_nextId;              // track IDs start at 1, 0 is 'no track'
+
+            // Track slots, the first m_activeCount entries of m_active are the active ones
+            track_t m_tracks[CAPACITY];
+            u32     m_id[CAPACITY];
+            i32     m_missed[CAPACITY];  // consecutive frames without a measurement
+            i32     m_active[CAPACITY];  // dense list of active slots
+            i32     m_activeCount;
+            i32     m_free[CAPACITY];  // stack of free slots
+            i32     m_freeCount;
+
+            // Per frame, indexed by the position in m_active
+            matrix_t<M, 1> m_predicted[CAPACITY];  // predicted measurement H x
+            matrix_t<M, M> m_Sinv[CAPACITY];       // inverse innovation covariance
+            f32            m_reach[CAPACITY];      // largest position distance the gate can accept
+            i32            m_candidate[CAPACITY + 1];  // candidates of active track a: [m_candidate[a], m_candidate[a + 1])
+            i32            m_assigned[CAPACITY];       // measurement of active track a, -1 none
+            i32            m_queue[CAPACITY];          // auction, tracks waiting to bid
+
+            // Per frame, grid and candidates
+            i32 m_bucketHead[BUCKETS];   // first measurement in the bucket, valid when m_bucketFrame is m_frame
+            u32 m_bucketFrame[BUCKETS];  // frame the bucket head was written in, so buckets are never cleared
+            i32 m_next[MEASUREMENTS];    // next measurement in the same bucket, -1 last
+            u32 m_frame;
+            u32 m_bucketStamp[BUCKETS];  // bucket already visited for the current track
+            u32 m_stamp;
+            i32 m_candTrack[CANDIDATES];
+            i32 m_candMeasurement[CANDIDATES];
+            f32 m_candCost[CANDIDATES];  // d^2
+            u64 m_order[CANDIDATES];     // greedy, sort keys (cost, candidate)
+            i32 m_owner[MEASUREMENTS];   // active track the measurement is assigned to, -1 none
+            f32 m_price[MEASUREMENTS];   // auction prices
+
+            u32 m_dropped;  // candidates dropped because CANDIDATES was exceeded (total)
+        };
+
+        // The tracker is large, allocate it statically or on the heap. 'gate' is the chi-square threshold of
+        // d^2, 'cellSize' the grid cell size (about the distance a target moves per frame plus the noise).
+        template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+        static inline void setup(tracker_t<C, K, N, M, FM, HM>& tr, const typename tracker_t<C, K, N, M, FM, HM>::model_t& model, tracker_solver_t solver = TRACKER_GREEDY, f32 gate = 9.21f,
+                                 f32 cellSize = 1.0f, i32 maxMissed = 10, f32 initialUncertainty = 5.0f)
+        {
+            tr.m_model              = model;
+            tr.m_solver             = solver;
+            tr.m_gate               = gate;
+            tr.m_cellSize           = cellSize;
+            tr.m_initialUncertainty = initialUncertainty;
+            tr.m_maxMissed          = maxMissed;
+            tr.m_nextId             = 1;
+            tr.m_activeCount        = 0;
+            tr.m_freeCount          = C;
+            for (i32 i = 0; i < C; ++i)
+                tr.m_free[i] = C - 1 - i;
+            for (i32 b = 0; b < tr.BUCKETS; ++b)
+            {
+                tr.m_bucketFrame[b] = 0;
+                tr.m_bucketStamp[b] = 0;
+            }
+            tr.m_frame   = 0;
+            tr.m_stamp   = 0;
+            tr.m_dropped = 0;
+        }
+
+        namespace ntracker
+        {
+            static inline i32 cell(f32 v, f32 inverseCellSize) { return (i32)floorf(v * inverseCellSize); }
+
+            template <i32 BUCKETS>
+            static inline i32 bucket(i32 cx, i32 cy)
+            {
+                return (i32)(((u32)cx * 73856093u ^ (u32)cy * 19349663u) & (u32)(BUCKETS - 1));
+            }
+
+            // Predicts every active track and prepares its gate
+            template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+            static inline void predict(tracker_t<C, K, N, M, FM, HM>& tr)
+            {
+                for (i32 a = 0; a < tr.m_activeCount; ++a)
+                {
+                    kalman_track_t<N, M>& track = tr.m_tracks[tr.m_active[a]];
+                    nkalman::predict(tr.m_model, track);
+                    HM::mul(tr.m_model.H, track.x, tr.m_predicted[a]);
+
+                    // S = H P H^T + R
+                    matrix_t<M, N> HP;
+                    HM::mul(tr.m_model.H, track.P, HP);
+                    matrix_t<M, M> HPHt;
+                    HM::mul_transposed(HP, tr.m_model.H, HPHt);
+                    matrix_t<M, M> S;
+                    HPHt.add(tr.m_model.R, S);
+                    S.invert(tr.m_Sinv[a]);
+
+                    // The gate ellipse projected on the position is the ellipse of the upper left 2x2 block of S,
+                    // its largest axis is sqrt(gate * largest eigenvalue of the block)
+                    const f32 mean    = 0.5f * (S.data[0][0] + S.data[1][1]);
+                    const f32 half    = 0.5f * (S.data[0][0] - S.data[1][1]);
+                    const f32 largest = mean + sqrtf(half * half + S.data[0][1] * S.data[1][0]);
+                    tr.m_reach[a]     = sqrtf(tr.m_gate * largest);
+                }
+            }
+
+            // Links the measurements into per bucket lists. Only the buckets of this frame's measurements are
+            // written, the others are recognized as empty by their older frame number.
+            template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+            static inline void index(tracker_t<C, K, N, M, FM, HM>& tr, const f32 measurements[][M], i32 count)
+            {
+                tr.m_frame += 1;
+                if (tr.m_frame == 0)
+                {
+                    for (i32 b = 0; b < tr.BUCKETS; ++b)
+                        tr.m_bucketFrame[b] = 0;
+                    tr.m_frame = 1;
+                }
+
+                const f32 inverse = 1.0f / tr.m_cellSize;
+                for (i32 k = count - 1; k >= 0; --k)
+                {
+                    const i32 b = bucket<tracker_t<C, K, N, M, FM, HM>::BUCKETS>(cell(measurements[k][0], inverse), cell(measurements[k][1], inverse));
+                    tr.m_next[k]        = (tr.m_bucketFrame[b] == tr.m_frame) ? tr.m_bucketHead[b] : -1;
+                    tr.m_bucketHead[b]  = k;
+                    tr.m_bucketFrame[b] = tr.m_frame;
+                }
+            }
+
+            template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+            static inline void consider(tracker_t<C, K, N, M, FM, HM>& tr, i32 a, const f32 measurements[][M], i32 k, i32& n)
+            {
+                f32 y[M];
+                for (i32 m = 0; m < M; ++m)
+                    y[m] = measurements[k][m] - tr.m_predicted[a].data[m][0];
+
+                // d^2 = y^T S^-1 y
+                f32 d2 = 0.0f;
+                for (i32 i = 0; i < M; ++i)
+                {
+                    f32 row = 0.0f;
+                    for (i32 j = 0; j < M; ++j)
+                        row += tr.m_Sinv[a].data[i][j] * y[j];
+                    d2 += y[i] * row;
+                }
+                if (d2 > tr.m_gate)
+                    return;
+                if (n == tr.CANDIDATES)
+                {
+                    tr.m_dropped += 1;
+                    return;
+                }
+                tr.m_candTrack[n]       = a;
+                tr.m_candMeasurement[n] = k;
+                tr.m_candCost[n]        = d2;
+                n += 1;
+            }
+
+            // Collects the (track, measurement) pairs within the gate, visiting only the grid cells within
+            // the reach of each track. A reach wider than the grid falls back to all measurements.
+            template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+            static inline void gate(tracker_t<C, K, N, M, FM, HM>& tr, const f32 measurements[][M], i32 count)
+            {
+                const f32 inverse = 1.0f / tr.m_cellSize;
+                i32       n       = 0;
+                for (i32 a = 0; a < tr.m_activeCount; ++a)
+                {
+                    tr.m_candidate[a] = n;
+
+                    const f32 px    = tr.m_predicted[a].data[0][0];
+                    const f32 py    = tr.m_predicted[a].data[1][0];
+                    const f32 reach = tr.m_reach[a];
+                    const f32 span  = 2.0f * reach * inverse + 2.0f;  // cells per axis, at most
+                    if (span * span > (f32)tr.BUCKETS || count < 8)
+                    {
+                        for (i32 k = 0; k < count; ++k)
+                            consider(tr, a, measurements, k, n);
+                        continue;
+                    }
+
+                    tr.m_stamp += 1;
+                    if (tr.m_stamp == 0)
+                    {
+                        for (i32 b = 0; b < tr.BUCKETS; ++b)
+                            tr.m_bucketStamp[b] = 0;
+                        tr.m_stamp = 1;
+                    }
+
+                    const i32 cx0 = cell(px - reach, inverse);
+                    const i32 cx1 = cell(px + reach, inverse);
+                    const i32 cy0 = cell(py - reach, inverse);
+                    const i32 cy1 = cell(py + reach, inverse);
+                    for (i32 cy = cy0; cy <= cy1; ++cy)
+                    {
+                        for (i32 cx = cx0; cx <= cx1; ++cx)
+                        {
+                            // Distinct cells can hash to the same bucket, visit every bucket once
+                            const i32 b = bucket<tracker_t<C, K, N, M, FM, HM>::BUCKETS>(cx, cy);
+                            if (tr.m_bucketStamp[b] == tr.m_stamp)
+                                continue;
+                            tr.m_bucketStamp[b] = tr.m_stamp;
+                            if (tr.m_bucketFrame[b] != tr.m_frame)
+                                continue;
+                            for (i32 k = tr.m_bucketHead[b]; k >= 0; k = tr.m_next[k])
+                                consider(tr, a, measurements, k, n);
+                        }
+                    }
+                }
+                tr.m_candidate[tr.m_activeCount] = n;
+            }
+
+            // Heap sort of the keys, ascending
+            static inline void sift(u64 keys[], i32 root, i32 n)
+            {
+                const u64 item = keys[root];
+                while (2 * root + 1 < n)
+                {
+                    i32 child = 2 * root + 1;
+                    if (child + 1 < n && keys[child + 1] > keys[child])
+                        child += 1;
+                    if (keys[child] <= item)
+                        break;
+                    keys[root] = keys[child];
+                    root       = child;
+                }
+                keys[root] = item;
+            }
+
+            static inline void sort(u64 keys[], i32 n)
+            {
+                for (i32 i = n / 2 - 1; i >= 0; --i)
+                    sift(keys, i, n);
+                for (i32 end = n - 1; end > 0; --end)
+                {
+                    const u64 top = keys[0];
+                    keys[0]       = keys[end];
+                    keys[end]     = top;
+                    sift(keys, 0, end);
+                }
+            }
+
+            // Smallest d^2 first. The keys are the bits of d^2 (a non-negative f32 orders like its bits) above
+            // the candidate index, so the sort moves plain integers instead of indices into the costs.
+            template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+            static inline void greedy(tracker_t<C, K, N, M, FM, HM>& tr)
+            {
+                const i32 n = tr.m_candidate[tr.m_activeCount];
+                for (i32 c = 0; c < n; ++c)
+                {
+                    const f32 cost = (tr.m_candCost[c] > 0.0f) ? tr.m_candCost[c] : 0.0f;
+                    u32       bits;
+                    memcpy(&bits, &cost, sizeof(bits));
+                    tr.m_order[c] = ((u64)bits << 32) | (u32)c;
+                }
+                sort(tr.m_order, n);
+                for (i32 i = 0; i < n; ++i)
+                {
+                    const i32 c = (i32)(u32)tr.m_order[i];
+                    const i32 a = tr.m_candTrack[c];
+                    const i32 k = tr.m_candMeasurement[c];
+                    if (tr.m_assigned[a] < 0 && tr.m_owner[k] < 0)
+                    {
+                        tr.m_assigned[a] = k;
+                        tr.m_owner[k]    = a;
+                    }
+                }
+            }
+
+            // Forward auction (Bertsekas): tracks bid for measurements with the benefit gate - d^2, every track
+            // also has a private 'missed' object of benefit 0. An unassigned track bids for its best object
+            // and raises its price by the margin to the second best plus epsilon, outbidding the current
+            // owner, which bids again. Prices only rise, so every bid costs at least epsilon of the at most
+            // m_gate a track can gain, which bounds the number of bids.
+            template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+            static inline void auction(tracker_t<C, K, N, M, FM, HM>& tr, i32 count)
+            {
+                const f32 epsilon = 1e-3f * tr.m_gate;
+                for (i32 k = 0; k < count; ++k)
+                    tr.m_price[k] = 0.0f;
+
+                // Ring of the tracks that have to bid, a track is in it at most once
+                i32 head = 0, size = 0;
+                for (i32 a = 0; a < tr.m_activeCount; ++a)
+                {
+                    if (tr.m_candidate[a + 1] > tr.m_candidate[a])
+                        tr.m_queue[size++] = a;
+                }
+
+                while (size > 0)
+                {
+                    const i32 a = tr.m_queue[head];
+                    head        = (head + 1 == C) ? 0 : head + 1;
+                    size -= 1;
+
+                    // Best and second best value, the private 'missed' object has value 0
+                    i32 best   = -1;
+                    f32 first  = 0.0f;
+                    f32 second = -1.0f;
+                    for (i32 c = tr.m_candidate[a]; c < tr.m_candidate[a + 1]; ++c)
+                    {
+                        const i32 k = tr.m_candMeasurement[c];
+                        const f32 v = tr.m_gate - tr.m_candCost[c] - tr.m_price[k];
+                        if (v > first)
+                        {
+                            second = first;
+                            first  = v;
+                            best   = k;
+                        }
+                        else if (v > second)
+                        {
+                            second = v;
+                        }
+                    }
+                    if (best < 0)
+                        continue;  // missing the frame is the best this track can do, final as prices only rise
+
+                    tr.m_price[best] += first - second + epsilon;
+                    const i32 previous = tr.m_owner[best];
+                    tr.m_owner[best]   = a;
+                    tr.m_assigned[a]   = best;
+                    if (previous >= 0)
+                    {
+                        tr.m_assigned[previous] = -1;
+                        i32 tail                = head + size;
+                        tail                    = (tail >= C) ? tail - C : tail;
+                        tr.m_queue[tail]        = previous;
+                        size += 1;
+                    }
+                }
+            }
+        }  // namespace ntracker
+
+        // Processes one frame of 'count' measurements (at most MEASUREMENTS are used). ids[k] receives the ID
+        // of the track measurement k was assigned to or started, 0 when all track slots are in use.
+        // Returns the number of active tracks.
+        template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+        static inline i32 update(tracker_t<C, K, N, M, FM, HM>& tr, const f32 measurements[][M], i32 count, u32 ids[])
+        {
+            for (i32 k = K; k < count; ++k)
+                ids[k] = 0;
+            count = (count < K) ? count : K;
+
+            ntracker::predict(tr);
+            ntracker::index(tr, measurements, count);
+            ntracker::gate(tr, measurements, count);
+
+            for (i32 a = 0; a < tr.m_activeCount; ++a)
+                tr.m_assigned[a] = -1;
+            for (i32 k = 0; k < count; ++k)
+            {
+                tr.m_owner[k] = -1;
+                ids[k]        = 0;
+            }
+            if (tr.m_solver == TRACKER_AUCTION)
+                ntracker::auction(tr, count);
+            else
+                ntracker::greedy(tr);
+
+            // Correct the assigned tracks, drop the ones that missed too many frames (swap with the last)
+            for (i32 a = 0; a < tr.m_activeCount;)
+            {
+                const i32 slot = tr.m_active[a];
+                const i32 k    = tr.m_assigned[a];
+                if (k >= 0)
+                {
+                    correct(tr.m_model, tr.m_tracks[slot], measurements[k]);
+                    tr.m_missed[slot] = 0;
+                    ids[k]            = tr.m_id[slot];
+                    a += 1;
+                }
+                else if (++tr.m_missed[slot] > tr.m_maxMissed)
+                {
+                    tr.m_free[tr.m_freeCount++] = slot;
+                    tr.m_activeCount -= 1;
+                    tr.m_active[a]   = tr.m_active[tr.m_activeCount];
+                    tr.m_assigned[a] = tr.m_assigned[tr.m_activeCount];
+                }
+                else
+                {
+                    a += 1;
+                }
+            }
+
+            // Unassigned measurements start tracks, the state is x = H^T z (zero velocity for rd03d)
+            for (i32 k = 0; k < count && tr.m_freeCount > 0; ++k)
+            {
+                if (tr.m_owner[k] >= 0)
+                    continue;
+                const i32 slot = tr.m_free[--tr.m_freeCount];
+                f32       initial[N];
+                for (i32 i = 0; i < N; ++i)
+                {
+                    f32 sum = 0.0f;
+                    for (i32 m = 0; m < M; ++m)
+                        sum += tr.m_model.H.data[m][i] * measurements[k][m];
+                    initial[i] = sum;
+                }
+                begin(tr.m_tracks[slot], initial, tr.m_initialUncertainty);
+                tr.m_id[slot]                   = tr.m_nextId++;
+                tr.m_missed[slot]               = 0;
+                tr.m_active[tr.m_activeCount++] = slot;
+                ids[k]                          = tr.m_id[slot];
+            }
+            return tr.m_activeCount;
+        }
+
+        // The active track with 'id', null when there is none
+        template <i32 C, i32 K, i32 N, i32 M, typename FM, typename HM>
+        static inline const kalman_track_t<N, M>* find(const tracker_t<C, K, N, M, FM, HM>& tr, u32 id)
+        {
+            for (i32 a = 0; a < tr.m_activeCount; ++a)
+            {
+                if (tr.m_id[tr.m_active[a]] == id)
+                    return &tr.m_tracks[tr.m_active[a]];
+            }
+            return 0;
+        }
+
+        // ----------------------------------------------------------------------------
+        // RD03D
+        // ----------------------------------------------------------------------------
+        // The tracker as a replacement of rd03d_t: tracks follow positions, not the IDs of the sensor.
+
+        // rd03d_model(dt) for the model, ids[i] receives the track ID of targets[i] (0 when not detected)
+        template <i32 C, i32 K, typename FM, typename HM>
+        static inline i32 processFrame(tracker_t<C, K, STATE_DIM, MEASURE_DIM, FM, HM>& tr, const target_t targets[], i32 count, u32 ids[])
+        {
+            for (i32 i = K; i < count; ++i)
+                ids[i] = 0;
+            count = (count < K) ? count : K;
+
+            f32 x[K], y[K];
+            polarToCartesian(targets, count, x, y);
+
+            f32 measurements[K][MEASURE_DIM];
+            i32 source[K];
+            i32 detected = 0;
+            for (i32 i = 0; i < count; ++i)
+            {
+                ids[i] = 0;
+                if (!targets[i].m_detected)
+                    continue;
+                measurements[detected][0] = x[i];
+                measurements[detected][1] = y[i];
+                source[detected]          = i;
+                detected += 1;
+            }
+
+            u32       assigned[K];
+            const i32 active = update(tr, measurements, detected, assigned);
+            for (i32 d = 0; d < detected; ++d)
+                ids[source[d]] = assigned[d];
+            return active;
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_FILTER_TRACKER_H__
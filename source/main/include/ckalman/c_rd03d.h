@@ -7,6 +7,11 @@
 
 #include "ccore/c_math.h"
 #include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_ekf.h"
+#include "ckalman/c_kalman_model.h"
+#include "ckalman/c_kalman_steady.h"
+#include "ckalman/c_sincos.h"
+#include "ckalman/c_kalman_telemetry.h"
 
 namespace ncore
 {
@@ -19,63 +24,107 @@ namespace ncore
             MEASURE_DIM = 2   // [X_pos, Y_pos]
         };
 
+        // What the track filters measure:
+        // - CARTESIAN: the position converted from distance and angle, with a fixed axis-aligned R
+        // - POLAR: distance and angle directly through the extended filter (update_ekf with rd03d_polar_t),
+        //   R is in range and angle, so the position uncertainty grows across the line of sight with the
+        //   distance instead of being the same everywhere
+        enum rd03d_measurement_t
+        {
+            RD03D_MEASURE_CARTESIAN = 0,
+            RD03D_MEASURE_POLAR     = 1
+        };
+
+        typedef measurement_polar_t<0, 1> rd03d_polar_t;
+
+        // F is constant velocity and H selects the two position states, update() skips their zero entries
+        typedef kalman_nd_t<STATE_DIM, MEASURE_DIM, model_constant_velocity_t, model_select_t<0, 1> >    rd03d_filter_t;
+        typedef kalman_model_t<STATE_DIM, MEASURE_DIM, model_constant_velocity_t, model_select_t<0, 1> > rd03d_model_t;
+        typedef kalman_track_t<STATE_DIM, MEASURE_DIM>                                                  rd03d_track_t;
+
+        // The room tracking model for a frame interval of 'dt', a constant expression for a constant dt
+        static constexpr rd03d_model_t rd03d_model(f32 dt)
+        {
+            rd03d_model_t model = {};
+            initialize(model);
+
+            // --- F MATRIX: State Transitions ---
+            // New_X = X + (Vx * dt)
+            // New_Y = Y + (Vy * dt)
+            model_constant_velocity_t::set_dt(model.F, dt);
+
+            // --- H MATRIX: Map States to Measurements ---
+            // We measure state index 0 (X position) and index 1 (Y position)
+            model.H.clear();
+            model.H.data[0][0] = 1.0f;
+            model.H.data[1][1] = 1.0f;
+
+            // --- Q MATRIX: Process Noise (Target Acceleration dynamics) ---
+            model.Q.data[0][0] = 0.01f;  // Position X variance
+            model.Q.data[1][1] = 0.01f;  // Position Y variance
+            model.Q.data[2][2] = 0.10f;  // Velocity X variance
+            model.Q.data[3][3] = 0.10f;  // Velocity Y variance
+
+            // --- R MATRIX: Sensor Measurement Noise Covariance ---
+            // mmWave angle tracking is generally noisier than distance tracking
+            model.R.data[0][0] = 0.25f;  // X measurement variance (influenced heavily by angle)
+            model.R.data[1][1] = 0.15f;  // Y measurement variance
+            return model;
+        }
+
+        // A track that is not detected coasts: it stays active for up to m_maxMissedFrames frames without
+        // any filter work. When the target is detected again the missed frames are predicted in one
+        // closed-form step (predict(kf, dt, steps)) before the measurement update, so position and
+        // velocity carry over instead of the track being restarted with begin().
+        // Note: the state of a coasting track is the state at its last detection.
         struct rd03d_t
         {
-            kalman_nd_t<STATE_DIM, MEASURE_DIM> m_roomFilters[MAX_TARGETS];
+            rd03d_filter_t                      m_roomFilters[MAX_TARGETS];
+            convergence_t                       m_convergence[MAX_TARGETS];  // switches a track to gain-only updates once converged
             bool                                m_targetActive[MAX_TARGETS];
+            i32                                 m_missedFrames[MAX_TARGETS];  // consecutive frames the track was not detected
+            i32                                 m_maxMissedFrames;            // a track is dropped after this many missed frames
+            rd03d_measurement_t                 m_measurement;                // cartesian or polar (extended filter) measurements
+            f32                                 m_dt;                         // frame interval in seconds
+            u64                                 m_time[MAX_TARGETS];          // time of the last update of the track in microseconds (timestamped frames)
+#if defined(CKALMAN_TELEMETRY)
+            telemetry_t                         m_telemetry;                  // statistics of all tracks
+#endif
         };
 
-        // dt = 0.05f -> 50ms intervals (20Hz)
-        static inline void setup(rd03d_t& rd, f32 dt = 0.05f)
+        // dt = 0.05f -> 50ms intervals (20Hz), maxMissedFrames = 10 -> tracks coast for up to 0.5s
+        static inline void setup(rd03d_t& rd, f32 dt = 0.05f, i32 maxMissedFrames = 10, rd03d_measurement_t measurement = RD03D_MEASURE_CARTESIAN)
         {
             rd.m_targetActive[0] = false;
             rd.m_targetActive[1] = false;
             rd.m_targetActive[2] = false;
+            rd.m_missedFrames[0] = 0;
+            rd.m_missedFrames[1] = 0;
+            rd.m_missedFrames[2] = 0;
+            rd.m_time[0]         = 0;
+            rd.m_time[1]         = 0;
+            rd.m_time[2]         = 0;
+            rd.m_maxMissedFrames = maxMissedFrames;
+            rd.m_dt              = dt;
+            rd.m_measurement     = measurement;
+#if defined(CKALMAN_TELEMETRY)
+            initialize(rd.m_telemetry);
+#endif
 
+            // One model for all tracks, the filters get a copy of it
+            const rd03d_model_t model = rd03d_model(dt);
             for (i32 i = 0; i < MAX_TARGETS; i++)
             {
-                // --- F MATRIX: State Transitions ---
-                // New_X = X + (Vx * dt)
-                // New_Y = Y + (Vy * dt)
-                rd.m_roomFilters[i].F.data[0][0] = 1.0f;
-                rd.m_roomFilters[i].F.data[0][1] = 0.0f;
-                rd.m_roomFilters[i].F.data[0][2] = dt;
-                rd.m_roomFilters[i].F.data[0][3] = 0.0f;
-                rd.m_roomFilters[i].F.data[1][0] = 0.0f;
-                rd.m_roomFilters[i].F.data[1][1] = 1.0f;
-                rd.m_roomFilters[i].F.data[1][2] = 0.0f;
-                rd.m_roomFilters[i].F.data[1][3] = dt;
-                rd.m_roomFilters[i].F.data[2][0] = 0.0f;
-                rd.m_roomFilters[i].F.data[2][1] = 0.0f;
-                rd.m_roomFilters[i].F.data[2][2] = 1.0f;
-                rd.m_roomFilters[i].F.data[2][3] = 0.0f;
-                rd.m_roomFilters[i].F.data[3][0] = 0.0f;
-                rd.m_roomFilters[i].F.data[3][1] = 0.0f;
-                rd.m_roomFilters[i].F.data[3][2] = 0.0f;
-                rd.m_roomFilters[i].F.data[3][3] = 1.0f;
-
-                // --- H MATRIX: Map States to Measurements ---
-                // We measure state index 0 (X position) and index 1 (Y position)
-                rd.m_roomFilters[i].H.data[0][0] = 1.0f;
-                rd.m_roomFilters[i].H.data[0][1] = 0.0f;
-                rd.m_roomFilters[i].H.data[0][2] = 0.0f;
-                rd.m_roomFilters[i].H.data[0][3] = 0.0f;
-                rd.m_roomFilters[i].H.data[1][0] = 0.0f;
-                rd.m_roomFilters[i].H.data[1][1] = 1.0f;
-                rd.m_roomFilters[i].H.data[1][2] = 0.0f;
-                rd.m_roomFilters[i].H.data[1][3] = 0.0f;
-
-                // --- Q MATRIX: Process Noise (Target Acceleration dynamics) ---
-                rd.m_roomFilters[i].Q.setIdentity();
-                rd.m_roomFilters[i].Q.data[0][0] = 0.01f;  // Position X variance
-                rd.m_roomFilters[i].Q.data[1][1] = 0.01f;  // Position Y variance
-                rd.m_roomFilters[i].Q.data[2][2] = 0.10f;  // Velocity X variance
-                rd.m_roomFilters[i].Q.data[3][3] = 0.10f;  // Velocity Y variance
-
-                // --- R MATRIX: Sensor Measurement Noise Covariance ---
-                // mmWave angle tracking is generally noisier than distance tracking
-                rd.m_roomFilters[i].R.data[0][0] = 0.25f;  // X measurement variance (influenced heavily by angle)
-                rd.m_roomFilters[i].R.data[1][1] = 0.15f;  // Y measurement variance
+                initialize(rd.m_convergence[i]);
+                initialize(rd.m_roomFilters[i], model);  // P identity and x zero
+                if (measurement == RD03D_MEASURE_POLAR)
+                {
+                    // Range and angle noise weighted against Q like the Cartesian R at 4 m (0.5 m across the
+                    // line of sight is 7.1 degrees there): less position noise across the line of sight for
+                    // closer targets, more for farther ones
+                    rd.m_roomFilters[i].R.data[0][0] = 0.15f;  // m^2
+                    rd.m_roomFilters[i].R.data[1][1] = 50.0f;  // degrees^2
+                }
             }
         }
 
@@ -85,10 +134,52 @@ namespace ncore
             bool m_detected;  // Whether the target is currently detected in this frame
             f32  m_distance;  // in meters
             f32  m_angle;     // in degrees (Ensure your library converts raw bytes to degrees)
+            f32  m_speed;     // radial speed in m/s as reported by the sensor (not used by processFrame)
         };
 
+        // Positions of 'count' targets (detected or not): x = distance * sin(angle), y = distance * cos(angle),
+        // all of them at once with the vectorized sincos of c_sincos.h
+        static inline void polarToCartesian(const target_t targets[], i32 count, f32 x[], f32 y[])
+        {
+            enum
+            {
+                CHUNK = 64  // a multiple of every vector width
+            };
+            typedef nsimd::f32xN_t V;
+
+            for (i32 begin = 0; begin < count; begin += CHUNK)
+            {
+                const i32 n      = (count - begin < CHUNK) ? count - begin : (i32)CHUNK;
+                const i32 padded = ((n + V::WIDTH - 1) / V::WIDTH) * V::WIDTH;  // a frame of 3 targets is one vector
+                f32       distance[CHUNK], angle[CHUNK], px[CHUNK], py[CHUNK];
+                for (i32 i = 0; i < n; ++i)
+                {
+                    distance[i] = targets[begin + i].m_distance;
+                    angle[i]    = targets[begin + i].m_angle;
+                }
+                for (i32 i = n; i < padded; ++i)
+                {
+                    distance[i] = 0.0f;
+                    angle[i]    = 0.0f;
+                }
+                polarToCartesian(distance, angle, padded, px, py);
+                for (i32 i = 0; i < n; ++i)
+                {
+                    x[begin + i] = px[i];
+                    y[begin + i] = py[i];
+                }
+            }
+        }
+
+        // Frames at the regular interval rd.m_dt
         void processFrame(rd03d_t& rd, const target_t targets[], i32 count);
 
+        // Frame taken at 'timestamp' (microseconds, non-decreasing per sensor). Every track is predicted
+        // lazily over the time since its own last update: frames close to rd.m_dt use the regular
+        // (gain-only once converged) update, jittered or late frames a prediction over the actual
+        // elapsed time. A frame older than a track's last update is ignored for that track.
+        void processFrame(rd03d_t& rd, const target_t targets[], i32 count, u64 timestamp);
+
     }  // namespace nkalman
 }  // namespace ncore
 
@@ -0,0 +1,129 @@
+#ifndef __C_KALMAN_FILTER_RD03D_FLEET_H__
+#define __C_KALMAN_FILTER_RD03D_FLEET_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_pipeline.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // RD03D FLEET (many sensors, one tick at a time on a work-stealing thread pool)
+        // ============================================================================
+        // A backend with thousands of sensors calls push() for every received frame and tick() at its
+        // processing rate:
+        //
+        //   push(fleet, sensor, frame)   appends the frame to the sensor's pending frames, the first
+        //                                pending frame puts the sensor in the batch of the next tick
+        //   tick(fleet)                  splits the batch in chunks of sensors and runs them on the pool,
+        //                                returns when every pending frame has been processed
+        //
+        // A sensor is in at most one chunk per tick and its frames are processed in the order they were
+        // pushed, so the result per sensor is the same as calling processFrame() serially.
+        //
+        // Work stealing: every worker starts with an even share of the chunks, a range [next, end) in one
+        // atomic word. The owner takes chunks from the front, an idle worker steals the back half of another
+        // worker's range with one compare-and-swap. Sensors with more targets (more work) and workers
+        // that are descheduled are balanced without a shared queue that every chunk has to pass through.
+        //
+        // Memory: the sensors and the batch list live in one block provided by the caller (size from
+        // rd03d_fleet_memory()), every sensor on its own cache lines. Nothing is allocated per frame or
+        // per tick, the worker threads are started by setup() and stopped by teardown().
+        // push() and tick() are called from the same thread (or externally serialized).
+
+        enum rd03d_fleet_config_t
+        {
+            RD03D_FLEET_PENDING     = 4,   // frames a sensor can queue between two ticks
+            RD03D_FLEET_MAX_WORKERS = 64,  // threads including the one calling tick()
+            RD03D_FLEET_CHUNK       = 16   // sensors per chunk (unit of work stealing)
+        };
+
+        struct alignas(RD03D_CACHE_LINE_SIZE) rd03d_sensor_t
+        {
+            rd03d_t       m_rd;
+            rd03d_frame_t m_pending[RD03D_FLEET_PENDING];
+            i32           m_pendingCount;
+            u32           m_rejected;  // frames rejected because RD03D_FLEET_PENDING frames were pending
+            u64           m_frames;    // frames processed
+        };
+
+        struct rd03d_fleet_worker_t
+        {
+            alignas(RD03D_CACHE_LINE_SIZE) std::atomic<u64> m_range;  // chunks [next, end): next in the low, end in the high 32 bits
+        };
+
+        struct rd03d_fleet_t
+        {
+            rd03d_sensor_t* m_sensors;  // in the caller's memory block
+            i32*            m_batch;    // sensors with pending frames, in the caller's memory block
+            i32             m_sensorCount;
+            i32             m_batchCount;
+            i32             m_chunkCount;  // chunks of the current tick
+            i32             m_workerCount;
+            u64             m_ticks;
+
+            rd03d_fleet_worker_t m_workers[RD03D_FLEET_MAX_WORKERS];
+
+            alignas(RD03D_CACHE_LINE_SIZE) std::atomic<i32> m_remaining;  // chunks of the current tick not yet done
+            std::atomic<i32>                                 m_busy;       // pool threads still in the current tick
+            std::atomic<i32>                                 m_processed;  // frames processed in the current tick
+
+            std::mutex              m_mutex;  // m_generation and m_stop, taken once per tick to wake the pool
+            std::condition_variable m_wake;
+            u32                     m_generation;
+            bool                    m_stop;
+            std::thread             m_threads[RD03D_FLEET_MAX_WORKERS];
+        };
+
+        // Bytes of the memory block for 'sensors' sensors (including the slack to align it)
+        static constexpr u64 rd03d_fleet_memory(i32 sensors) { return (u64)RD03D_CACHE_LINE_SIZE + (u64)sensors * (sizeof(rd03d_sensor_t) + sizeof(i32)); }
+
+        // Sets up every sensor like setup(rd03d_t&, dt, maxMissedFrames) and starts 'workers' - 1 threads,
+        // the thread calling tick() is the remaining worker. 'memory' holds rd03d_fleet_memory(sensors) bytes
+        // and has to stay valid until teardown(). Returns false for a worker count out of range.
+        bool setup(rd03d_fleet_t& fleet, void* memory, i32 sensors, i32 workers, f32 dt = 0.05f, i32 maxMissedFrames = 10);
+
+        // Stops and joins the pool threads
+        void teardown(rd03d_fleet_t& fleet);
+
+        // Queues a frame of 'sensor' for the next tick (timestamp 0: a frame at the regular interval).
+        // Returns false (and counts the frame as rejected) when the sensor already has RD03D_FLEET_PENDING frames.
+        static inline bool push(rd03d_fleet_t& fleet, i32 sensor, const target_t targets[], i32 count, u64 timestamp = 0)
+        {
+            rd03d_sensor_t& s = fleet.m_sensors[sensor];
+            if (s.m_pendingCount == RD03D_FLEET_PENDING)
+            {
+                s.m_rejected += 1;
+                return false;
+            }
+            if (s.m_pendingCount == 0)
+                fleet.m_batch[fleet.m_batchCount++] = sensor;
+
+            rd03d_frame_t& frame = s.m_pending[s.m_pendingCount++];
+            count                = (count < MAX_TARGETS) ? count : (i32)MAX_TARGETS;
+            frame.m_timestamp    = timestamp;
+            frame.m_count        = count;
+            for (i32 i = 0; i < count; ++i)
+                frame.m_targets[i] = targets[i];
+            return true;
+        }
+
+        // Processes the pending frames of all sensors on the pool, returns the number of frames processed
+        i32 tick(rd03d_fleet_t& fleet);
+
+        static inline const rd03d_t& getSensor(const rd03d_fleet_t& fleet, i32 sensor) { return fleet.m_sensors[sensor].m_rd; }
+
+    }  // namespace nkalman
+}  // namespace ncore
+
+#endif  // __C_KALMAN_FILTER_RD03D_FLEET_H__
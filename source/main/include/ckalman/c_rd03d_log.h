@@ -0,0 +1,195 @@
+#ifndef __C_KALMAN_FILTER_RD03D_LOG_H__
+#define __C_KALMAN_FILTER_RD03D_LOG_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_rd03d.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // RD03D FRAME LOG (record / memory-mapped replay)
+        // ============================================================================
+        // Binary capture of target_t frames so that processFrame() can be re-run offline.
+        //
+        // File layout (little-endian):
+        //   log_header_t                    32 bytes
+        //   log_record_t[m_recordCount]     m_recordSize bytes each
+        //
+        // Records have a fixed size so a mapped log is indexed directly. Readers use m_recordSize as
+        // the stride: a later version may append fields to a record and older readers still work.
+        // A reader accepts every version whose m_recordSize is at least its own sizeof(log_record_t)
+        // and a multiple of its alignment, and reads the fields it knows of.
+
+        enum rd03d_log_config_t
+        {
+            RD03D_LOG_MAGIC   = 0x474C4452,  // "RDLG"
+            RD03D_LOG_VERSION = 1
+        };
+
+        struct log_header_t
+        {
+            u32 m_magic;        // RD03D_LOG_MAGIC
+            u16 m_version;      // RD03D_LOG_VERSION of the writer
+            u16 m_recordSize;   // sizeof(log_record_t) of the writer
+            u64 m_recordCount;  // number of records, written when the recorder is closed
+            u64 m_reserved[2];
+        };
+
+        struct log_target_t
+        {
+            u8  m_id;
+            u8  m_detected;
+            u16 m_reserved;
+            f32 m_distance;  // meters
+            f32 m_angle;     // degrees
+            f32 m_speed;     // m/s
+        };
+
+        struct log_record_t
+        {
+            u64          m_timestamp;  // microseconds, caller defined epoch
+            u16          m_sensorId;   // which sensor (rd03d_t) the frame belongs to
+            u8           m_count;      // number of valid entries in m_targets
+            u8           m_reserved;
+            u32          m_reserved2;
+            log_target_t m_targets[MAX_TARGETS];
+        };
+
+        static_assert(sizeof(log_header_t) == 32, "log_header_t layout changed");
+        static_assert(sizeof(log_record_t) == 64, "log_record_t layout changed");
+
+        // ----------------------------------------------------------------------------
+        // In-memory encoding
+        // ----------------------------------------------------------------------------
+
+        static inline void encode(log_record_t& r, u64 timestamp, u16 sensorId, const target_t targets[], i32 count)
+        {
+            count         = (count < MAX_TARGETS) ? count : (i32)MAX_TARGETS;
+            r.m_timestamp = timestamp;
+            r.m_sensorId  = sensorId;
+            r.m_count     = (u8)count;
+            r.m_reserved  = 0;
+            r.m_reserved2 = 0;
+            for (i32 i = 0; i < MAX_TARGETS; ++i)
+            {
+                log_target_t& t = r.m_targets[i];
+                if (i < count)
+                {
+                    t.m_id       = targets[i].m_id;
+                    t.m_detected = targets[i].m_detected ? 1 : 0;
+                    t.m_distance = targets[i].m_distance;
+                    t.m_angle    = targets[i].m_angle;
+                    t.m_speed    = targets[i].m_speed;
+                }
+                else
+                {
+                    t.m_id       = 0;
+                    t.m_detected = 0;
+                    t.m_distance = 0.0f;
+                    t.m_angle    = 0.0f;
+                    t.m_speed    = 0.0f;
+                }
+                t.m_reserved = 0;
+            }
+        }
+
+        // Returns the number of targets written to 'targets'
+        static inline i32 decode(const log_record_t& r, target_t targets[MAX_TARGETS])
+        {
+            const i32 count = (r.m_count < MAX_TARGETS) ? r.m_count : (i32)MAX_TARGETS;
+            for (i32 i = 0; i < count; ++i)
+            {
+                targets[i].m_id       = r.m_targets[i].m_id;
+                targets[i].m_detected = r.m_targets[i].m_detected != 0;
+                targets[i].m_distance = r.m_targets[i].m_distance;
+                targets[i].m_angle    = r.m_targets[i].m_angle;
+                targets[i].m_speed    = r.m_targets[i].m_speed;
+            }
+            return count;
+        }
+
+        // Read-only view of a complete log in memory (e.g. a mapped file)
+        struct log_view_t
+        {
+            const u8* m_records;      // first record
+            u64       m_recordCount;  // number of complete records
+            u32       m_recordSize;   // stride between records
+        };
+
+        static inline const log_record_t& record(const log_view_t& view, u64 index) { return *(const log_record_t*)(view.m_records + index * view.m_recordSize); }
+
+        // Validates the header and sets up 'view'. Returns false for a foreign file, records smaller than
+        // log_record_t or a truncated header. A record count of zero (recorder not closed) is derived from the data size.
+        bool open(log_view_t& view, const void* data, u64 size);
+
+        // ----------------------------------------------------------------------------
+        // Recorder (buffered appends to a file)
+        // ----------------------------------------------------------------------------
+
+        enum
+        {
+            RD03D_LOG_BUFFER_RECORDS = 64
+        };
+
+        struct log_recorder_t
+        {
+            void*        m_file;         // FILE*
+            u64          m_recordCount;  // records written to the file
+            i32          m_buffered;     // records waiting in m_buffer
+            bool         m_failed;       // a write failed, close() returns false
+            log_record_t m_buffer[RD03D_LOG_BUFFER_RECORDS];
+        };
+
+        // Creates (truncates) the log file at 'path' and writes its header
+        bool open(log_recorder_t& rec, const char* path);
+
+        // Appends one frame, the record is written to the file once the buffer is full or on close()
+        bool record(log_recorder_t& rec, u64 timestamp, u16 sensorId, const target_t targets[], i32 count);
+
+        // Flushes the buffered records and writes the final record count into the header. Returns false
+        // when any write since open() failed, the header then counts the records that were written.
+        bool close(log_recorder_t& rec);
+
+        // ----------------------------------------------------------------------------
+        // Memory-mapped file and replay
+        // ----------------------------------------------------------------------------
+
+        struct log_file_t
+        {
+            const void* m_data;
+            u64         m_size;
+            void*       m_handle;   // platform mapping handle
+            void*       m_handle2;  // platform file handle
+        };
+
+        // Maps the whole file read-only, returns false when it can not be opened or mapped
+        bool map(log_file_t& file, const char* path);
+        void unmap(log_file_t& file);
+
+        struct replay_stats_t
+        {
+            u64 m_frames;           // frames pushed through processFrame()
+            f64 m_seconds;          // wall-clock time of the replay
+            f64 m_framesPerSecond;  // m_frames / m_seconds
+        };
+
+        // Replays every record of 'sensorId' through 'rd' as fast as possible
+        replay_stats_t replay(const log_view_t& view, rd03d_t& rd, u16 sensorId);
+
+        // Replays every record into trackers[m_sensorId] (records with m_sensorId >= sensorCount are
+        // skipped) on 'threadCount' threads. Sensors are sharded by m_sensorId % threadCount, so every
+        // tracker is only touched by one thread and sees its frames in log order. Every thread walks the
+        // whole log and skips the records of the other shards: the log is read threadCount times, which
+        // pays off while processFrame() costs more than reading a record (a mapped log stays in the page
+        // cache after the first pass).
+        replay_stats_t replay(const log_view_t& view, rd03d_t* trackers, i32 sensorCount, i32 threadCount);
+
+    }  // namespace nkalman
+}  // namespace ncore
+
+#endif  // __C_KALMAN_FILTER_RD03D_LOG_H__
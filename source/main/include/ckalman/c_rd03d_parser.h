@@ -0,0 +1,77 @@
+#ifndef __C_KALMAN_FILTER_RD03D_PARSER_H__
+#define __C_KALMAN_FILTER_RD03D_PARSER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_rd03d.h"
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // RD03D UART FRAME PARSER (streaming, zero-copy)
+        // ============================================================================
+        // Decodes the RD03D report frames straight out of a caller-owned ring buffer, e.g. the buffer
+        // a UART receive interrupt writes into. Frame layout (30 bytes, multi-target mode):
+        //
+        //   AA FF 03 00 | target 1 (8 bytes) | target 2 | target 3 | 55 CC
+        //
+        // Each target is four little-endian u16 fields: x (mm), y (mm), speed (cm/s) and the distance
+        // resolution (mm). x, y and speed are signed-magnitude: bit 15 set means positive, the low
+        // 15 bits hold the magnitude. A target slot of all zero bytes means no target.
+        //
+        // The parser only keeps a read position. Ring positions are free-running u32 counters, the
+        // byte at position 'i' lives at buffer[i & (capacity - 1)], so the capacity must be a power of
+        // two. The writer publishes its position and passes it to next()/parse(); the parser never
+        // reads past it and never writes to the buffer. Bytes that do not start a valid frame (wrong
+        // header or footer) are skipped one at a time until the stream is in sync again.
+
+        enum rd03d_protocol_t
+        {
+            RD03D_FRAME_SIZE  = 30,
+            RD03D_TARGET_SIZE = 8,
+            RD03D_HEADER_SIZE = 4
+        };
+
+        struct rd03d_parser_t
+        {
+            const u8* m_buffer;   // caller-owned ring buffer
+            u32       m_mask;     // capacity - 1
+            u32       m_read;     // free-running read position
+            u32       m_frames;   // number of frames decoded
+            u32       m_skipped;  // number of bytes skipped while resynchronizing
+        };
+
+        // 'capacity' must be a power of two, 'start' is the writer's current position
+        static inline void setup(rd03d_parser_t& p, const u8* buffer, u32 capacity, u32 start = 0)
+        {
+            p.m_buffer  = buffer;
+            p.m_mask    = capacity - 1;
+            p.m_read    = start;
+            p.m_frames  = 0;
+            p.m_skipped = 0;
+        }
+
+        // Signed-magnitude u16 field as sent by the sensor (bit 15 set = positive)
+        static inline s32 rd03d_decode_field(u32 raw)
+        {
+            const s32 magnitude = (s32)(raw & 0x7FFF);
+            return (raw & 0x8000) ? magnitude : -magnitude;
+        }
+
+        // Decodes the next complete frame in [m_read, write) into targets[0..MAX_TARGETS-1] (m_id 1..3,
+        // undetected slots have m_detected == false). Returns false when no complete frame is available,
+        // the read position then stays at the start of the partial frame.
+        bool next(rd03d_parser_t& p, u32 write, target_t targets[MAX_TARGETS]);
+
+        // Decodes every complete frame in [m_read, write) and runs processFrame() on each of them.
+        // Returns the number of frames processed.
+        i32 parse(rd03d_parser_t& p, u32 write, rd03d_t& rd);
+
+    }  // namespace nkalman
+}  // namespace ncore
+
+#endif  // __C_KALMAN_FILTER_RD03D_PARSER_H__
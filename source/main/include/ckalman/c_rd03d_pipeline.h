@@ -0,0 +1,264 @@
+#ifndef __C_KALMAN_FILTER_RD03D_PIPELINE_H__
+#define __C_KALMAN_FILTER_RD03D_PIPELINE_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_rd03d.h"
+
+#include <atomic>
+#include <string.h>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // RD03D PIPELINE (ingest thread -> filter thread -> any number of readers)
+        // ============================================================================
+        // Three kinds of threads share one sensor without locks:
+        //
+        //   ingest (UART)  --push()-->  frame queue  --process()-->  rd03d_t  --publish-->  snapshot  <--read()--  readers
+        //
+        // - The frame queue is a single-producer single-consumer ring. push() and pop() are wait-free:
+        //   a full queue rejects the frame (counted in m_rejected) instead of waiting for the filter.
+        // - process() runs on the filter thread. It drains the queue through processFrame() and then
+        //   publishes the positions and velocities of the tracks once.
+        // - The snapshot is a seqlock: the filter thread never waits for a reader. A reader that overlaps
+        //   a publish sees the sequence change and retries, so it can not observe a torn state.
+        //
+        // The structures hold cache-line aligned members (producer and consumer counters on separate
+        // lines), allocate them statically or with an allocator that honours alignof().
+
+        enum rd03d_pipeline_config_t
+        {
+            RD03D_QUEUE_FRAMES    = 64,                       // frame queue capacity (power of two)
+            RD03D_SNAPSHOT_WORDS  = 4 + 5 * MAX_TARGETS,      // frame, timestamp and 5 words per track
+            RD03D_CACHE_LINE_SIZE = 64
+        };
+
+        struct rd03d_frame_t
+        {
+            u64      m_timestamp;  // microseconds, 0 for frames at the regular interval
+            i32      m_count;
+            target_t m_targets[MAX_TARGETS];
+        };
+
+        struct rd03d_frame_queue_t
+        {
+            alignas(RD03D_CACHE_LINE_SIZE) std::atomic<u32> m_write;  // free-running, written by the producer
+            u32                                              m_readCache;  // producer's last seen m_read
+            std::atomic<u32>                                 m_rejected;   // frames rejected because the queue was full
+            alignas(RD03D_CACHE_LINE_SIZE) std::atomic<u32> m_read;       // free-running, written by the consumer
+            alignas(RD03D_CACHE_LINE_SIZE) rd03d_frame_t    m_frames[RD03D_QUEUE_FRAMES];
+        };
+
+        // Published state of one track
+        struct rd03d_track_state_t
+        {
+            bool m_active;
+            f32  m_x, m_y;    // position in meters
+            f32  m_vx, m_vy;  // velocity in m/s
+        };
+
+        struct rd03d_state_t
+        {
+            u64                 m_frame;      // number of frames processed
+            u64                 m_timestamp;  // timestamp of the last frame
+            rd03d_track_state_t m_tracks[MAX_TARGETS];
+        };
+
+        struct rd03d_snapshot_t
+        {
+            alignas(RD03D_CACHE_LINE_SIZE) std::atomic<u32> m_sequence;  // odd while a publish is in progress
+            std::atomic<u32>                                 m_words[RD03D_SNAPSHOT_WORDS];
+        };
+
+        struct rd03d_pipeline_t
+        {
+            rd03d_frame_queue_t m_queue;
+            rd03d_snapshot_t    m_snapshot;
+            rd03d_t             m_rd;      // only touched by the filter thread
+            u64                 m_frames;  // frames processed, filter thread
+        };
+
+        // ----------------------------------------------------------------------------
+        // Frame queue (single producer, single consumer)
+        // ----------------------------------------------------------------------------
+
+        static inline void setup(rd03d_frame_queue_t& q)
+        {
+            q.m_write.store(0, std::memory_order_relaxed);
+            q.m_readCache = 0;
+            q.m_rejected.store(0, std::memory_order_relaxed);
+            q.m_read.store(0, std::memory_order_relaxed);
+        }
+
+        // Producer: returns false (and counts the frame as rejected) when the queue is full
+        static inline bool push(rd03d_frame_queue_t& q, const target_t targets[], i32 count, u64 timestamp)
+        {
+            const u32 write = q.m_write.load(std::memory_order_relaxed);
+            if (write - q.m_readCache == RD03D_QUEUE_FRAMES)
+            {
+                q.m_readCache = q.m_read.load(std::memory_order_acquire);
+                if (write - q.m_readCache == RD03D_QUEUE_FRAMES)
+                {
+                    q.m_rejected.store(q.m_rejected.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            rd03d_frame_t& frame = q.m_frames[write & (RD03D_QUEUE_FRAMES - 1)];
+            count                = (count < MAX_TARGETS) ? count : (i32)MAX_TARGETS;
+            frame.m_timestamp    = timestamp;
+            frame.m_count        = count;
+            for (i32 i = 0; i < count; ++i)
+                frame.m_targets[i] = targets[i];
+            q.m_write.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer: returns false when the queue is empty
+        static inline bool pop(rd03d_frame_queue_t& q, rd03d_frame_t& frame)
+        {
+            const u32 read = q.m_read.load(std::memory_order_relaxed);
+            if (read == q.m_write.load(std::memory_order_acquire))
+                return false;
+            frame = q.m_frames[read & (RD03D_QUEUE_FRAMES - 1)];
+            q.m_read.store(read + 1, std::memory_order_release);
+            return true;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Snapshot (seqlock, single writer)
+        // ----------------------------------------------------------------------------
+        // The payload is kept in relaxed atomic words, so a reader racing the writer reads stale or
+        // mixed words (and retries) but never has a data race.
+
+        namespace npipeline
+        {
+            static inline u32 bits(f32 v)
+            {
+                u32 u;
+                memcpy(&u, &v, sizeof(u));
+                return u;
+            }
+
+            static inline f32 value(u32 u)
+            {
+                f32 v;
+                memcpy(&v, &u, sizeof(v));
+                return v;
+            }
+        }  // namespace npipeline
+
+        static inline void publish(rd03d_snapshot_t& s, const rd03d_state_t& state)
+        {
+            const u32 sequence = s.m_sequence.load(std::memory_order_relaxed);
+            s.m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            u32 words[RD03D_SNAPSHOT_WORDS];
+            words[0] = (u32)state.m_frame;
+            words[1] = (u32)(state.m_frame >> 32);
+            words[2] = (u32)state.m_timestamp;
+            words[3] = (u32)(state.m_timestamp >> 32);
+            for (i32 t = 0; t < MAX_TARGETS; ++t)
+            {
+                u32* w = words + 4 + 5 * t;
+                w[0]   = state.m_tracks[t].m_active ? 1 : 0;
+                w[1]   = npipeline::bits(state.m_tracks[t].m_x);
+                w[2]   = npipeline::bits(state.m_tracks[t].m_y);
+                w[3]   = npipeline::bits(state.m_tracks[t].m_vx);
+                w[4]   = npipeline::bits(state.m_tracks[t].m_vy);
+            }
+            for (i32 i = 0; i < RD03D_SNAPSHOT_WORDS; ++i)
+                s.m_words[i].store(words[i], std::memory_order_relaxed);
+
+            s.m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        // One attempt, returns false when it overlapped a publish ('state' is then undefined)
+        static inline bool tryRead(const rd03d_snapshot_t& s, rd03d_state_t& state)
+        {
+            const u32 before = s.m_sequence.load(std::memory_order_acquire);
+            if (before & 1)
+                return false;
+
+            u32 words[RD03D_SNAPSHOT_WORDS];
+            for (i32 i = 0; i < RD03D_SNAPSHOT_WORDS; ++i)
+                words[i] = s.m_words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.m_sequence.load(std::memory_order_relaxed) != before)
+                return false;
+
+            state.m_frame     = (u64)words[0] | ((u64)words[1] << 32);
+            state.m_timestamp = (u64)words[2] | ((u64)words[3] << 32);
+            for (i32 t = 0; t < MAX_TARGETS; ++t)
+            {
+                const u32* w               = words + 4 + 5 * t;
+                state.m_tracks[t].m_active = w[0] != 0;
+                state.m_tracks[t].m_x      = npipeline::value(w[1]);
+                state.m_tracks[t].m_y      = npipeline::value(w[2]);
+                state.m_tracks[t].m_vx     = npipeline::value(w[3]);
+                state.m_tracks[t].m_vy     = npipeline::value(w[4]);
+            }
+            return true;
+        }
+
+        // Retries until a consistent state is read, only ever waits for a publish in progress.
+        // Returns the number of retries.
+        static inline i32 read(const rd03d_snapshot_t& s, rd03d_state_t& state)
+        {
+            i32 retries = 0;
+            while (!tryRead(s, state))
+                ++retries;
+            return retries;
+        }
+
+        static inline void setup(rd03d_snapshot_t& s)
+        {
+            s.m_sequence.store(0, std::memory_order_relaxed);
+            rd03d_state_t empty;
+            memset(&empty, 0, sizeof(empty));
+            publish(s, empty);
+        }
+
+        // Positions and velocities of the tracks of 'rd'
+        static inline void getState(const rd03d_t& rd, u64 frame, u64 timestamp, rd03d_state_t& state)
+        {
+            state.m_frame     = frame;
+            state.m_timestamp = timestamp;
+            for (i32 t = 0; t < MAX_TARGETS; ++t)
+            {
+                state.m_tracks[t].m_active = rd.m_targetActive[t];
+                state.m_tracks[t].m_x      = rd.m_roomFilters[t].x.data[0][0];
+                state.m_tracks[t].m_y      = rd.m_roomFilters[t].x.data[1][0];
+                state.m_tracks[t].m_vx     = rd.m_roomFilters[t].x.data[2][0];
+                state.m_tracks[t].m_vy     = rd.m_roomFilters[t].x.data[3][0];
+            }
+        }
+
+        // ----------------------------------------------------------------------------
+        // Pipeline
+        // ----------------------------------------------------------------------------
+
+        // Same arguments as setup(rd03d_t&), call before any of the threads start
+        void setup(rd03d_pipeline_t& p, f32 dt = 0.05f, i32 maxMissedFrames = 10);
+
+        // Ingest thread, see push(rd03d_frame_queue_t&, ...)
+        static inline bool push(rd03d_pipeline_t& p, const target_t targets[], i32 count, u64 timestamp = 0) { return push(p.m_queue, targets, count, timestamp); }
+
+        // Filter thread: runs processFrame() on every queued frame (the timestamped overload for frames
+        // with a timestamp) and publishes the result once. Returns the number of frames processed.
+        i32 process(rd03d_pipeline_t& p);
+
+        // Reader threads
+        static inline i32 read(const rd03d_pipeline_t& p, rd03d_state_t& state) { return read(p.m_snapshot, state); }
+
+    }  // namespace nkalman
+}  // namespace ncore
+
+#endif  // __C_KALMAN_FILTER_RD03D_PIPELINE_H__
@@ -0,0 +1,441 @@
+#ifndef __C_KALMAN_FILTER_RD03D_ZONES_H__
+#define __C_KALMAN_FILTER_RD03D_ZONES_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "ckalman/c_rd03d.h"
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        // ============================================================================
+        // RD03D ZONES (enter / leave events of the filtered tracks)
+        // ============================================================================
+        // Automation zones (the desk, the door, the couch) are rectangles and polygons in the x/y plane of
+        // the sensor. compile() indexes them in a uniform grid over their common bounding box, about four
+        // cells per zone, every cell listing the zones whose bounding box overlaps it. update() looks at
+        // the zones listed in the cell of each track and at the zones the track is currently inside of,
+        // so a frame costs the same for 10 or 10000 zones as long as only a few of them are near a track.
+        //
+        // Hysteresis from the track covariance: with d the distance of the track position to the zone
+        // boundary (positive inside) and sigma the standard deviation of the position along the boundary
+        // normal (n^T P n), a track
+        //   enters a zone when   d >  margin + k sigma
+        //   leaves a zone when   d < -(margin + k sigma)
+        // and otherwise keeps its state. A new track (large P) has to be well inside before it enters,
+        // a converged track sitting on an edge does not toggle the zone with every frame of sensor noise.
+        // A zone narrower than twice that band can not be entered.
+        //
+        // The map is read-only after compile() and can be shared by any number of sensors, each with its
+        // own zone_state_t. Events are returned in track order, per track leaves before enters.
+
+        enum rd03d_zone_config_t
+        {
+            RD03D_ZONE_MAX_INSIDE = 8  // zones a track can be inside of at the same time
+        };
+
+        enum zone_event_type_t
+        {
+            ZONE_ENTER = 1,
+            ZONE_LEAVE = 2
+        };
+
+        struct zone_event_t
+        {
+            u32               m_zone;   // id given to addRectangle() / addPolygon()
+            i32               m_track;  // track slot of the rd03d_t (target id - 1)
+            zone_event_type_t m_type;
+        };
+
+        // Up to ZONES zones with VERTICES polygon vertices in total. The grid has at most CELLS cells and
+        // ENTRIES (zone, cell) pairs, compile() makes the cells larger when the lists do not fit.
+        template <i32 ZONES, i32 VERTICES = 8 * ZONES, i32 CELLS = 4 * ZONES, i32 ENTRIES = CELLS + 8 * ZONES>
+        struct zone_map_t
+        {
+            static_assert(ZONES <= 65535, "zone indices are 16 bit");
+
+            // Zones: the bounding box, for a polygon the vertices [m_first, m_first + m_count) as well
+            u32 m_id[ZONES];
+            f32 m_margin[ZONES];
+            f32 m_minX[ZONES];
+            f32 m_minY[ZONES];
+            f32 m_maxX[ZONES];
+            f32 m_maxY[ZONES];
+            i32 m_first[ZONES];
+            i32 m_count[ZONES];  // 0 for a rectangle (the bounding box is the zone)
+            f32 m_vx[VERTICES];
+            f32 m_vy[VERTICES];
+            i32 m_zoneCount;
+            i32 m_vertexCount;
+            f32 m_sigmas;  // k of the hysteresis band
+
+            // Grid: the zones of cell c are m_cellZones[m_cellStart[c] .. m_cellStart[c + 1])
+            f32 m_originX;
+            f32 m_originY;
+            f32 m_invCellX;
+            f32 m_invCellY;
+            i32 m_cellsX;  // 0 until compile()
+            i32 m_cellsY;
+            i32 m_cellStart[CELLS + 1];
+            u16 m_cellZones[ENTRIES];
+        };
+
+        // Per sensor: the zones every track is inside of (indices into the map)
+        struct zone_state_t
+        {
+            u16 m_inside[MAX_TARGETS][RD03D_ZONE_MAX_INSIDE];
+            i32 m_insideCount[MAX_TARGETS];
+        };
+
+        // 'sigmas' is k of the hysteresis band margin + k sigma
+        template <i32 Z, i32 V, i32 C, i32 E>
+        static inline void initialize(zone_map_t<Z, V, C, E>& map, f32 sigmas = 1.0f)
+        {
+            map.m_zoneCount    = 0;
+            map.m_vertexCount  = 0;
+            map.m_sigmas       = sigmas;
+            map.m_cellsX       = 0;
+            map.m_cellsY       = 0;
+            map.m_cellStart[0] = 0;
+        }
+
+        // Call again whenever the map is compiled again, the zone indices may have changed
+        static inline void initialize(zone_state_t& state)
+        {
+            for (i32 t = 0; t < MAX_TARGETS; ++t)
+                state.m_insideCount[t] = 0;
+        }
+
+        // Axis-aligned rectangle [x0, x1] x [y0, y1] in meters, 'margin' in meters is added to the hysteresis band.
+        // Returns false when the map is full.
+        template <i32 Z, i32 V, i32 C, i32 E>
+        static inline bool addRectangle(zone_map_t<Z, V, C, E>& map, u32 id, f32 x0, f32 y0, f32 x1, f32 y1, f32 margin = 0.1f)
+        {
+            if (map.m_zoneCount == Z)
+                return false;
+            const i32 z     = map.m_zoneCount++;
+            map.m_id[z]     = id;
+            map.m_margin[z] = margin;
+            map.m_minX[z]   = (x0 < x1) ? x0 : x1;
+            map.m_minY[z]   = (y0 < y1) ? y0 : y1;
+            map.m_maxX[z]   = (x0 < x1) ? x1 : x0;
+            map.m_maxY[z]   = (y0 < y1) ? y1 : y0;
+            map.m_first[z]  = 0;
+            map.m_count[z]  = 0;
+            return true;
+        }
+
+        // Simple polygon (concave is fine, not self-intersecting) of 'count' >= 3 vertices in either order.
+        // Returns false when the map is full or the polygon has fewer than 3 vertices.
+        template <i32 Z, i32 V, i32 C, i32 E>
+        static inline bool addPolygon(zone_map_t<Z, V, C, E>& map, u32 id, const f32 x[], const f32 y[], i32 count, f32 margin = 0.1f)
+        {
+            if (map.m_zoneCount == Z || count < 3 || map.m_vertexCount + count > V)
+                return false;
+            const i32 z     = map.m_zoneCount++;
+            map.m_id[z]     = id;
+            map.m_margin[z] = margin;
+            map.m_first[z]  = map.m_vertexCount;
+            map.m_count[z]  = count;
+            map.m_minX[z]   = x[0];
+            map.m_minY[z]   = y[0];
+            map.m_maxX[z]   = x[0];
+            map.m_maxY[z]   = y[0];
+            for (i32 i = 0; i < count; ++i)
+            {
+                map.m_vx[map.m_vertexCount + i] = x[i];
+                map.m_vy[map.m_vertexCount + i] = y[i];
+                map.m_minX[z]                   = (x[i] < map.m_minX[z]) ? x[i] : map.m_minX[z];
+                map.m_minY[z]                   = (y[i] < map.m_minY[z]) ? y[i] : map.m_minY[z];
+                map.m_maxX[z]                   = (x[i] > map.m_maxX[z]) ? x[i] : map.m_maxX[z];
+                map.m_maxY[z]                   = (y[i] > map.m_maxY[z]) ? y[i] : map.m_maxY[z];
+            }
+            map.m_vertexCount += count;
+            return true;
+        }
+
+        namespace nzones
+        {
+            // Cells [x0, x1] x [y0, y1] overlapped by the bounding box of zone z
+            template <typename MAP>
+            static inline void cellRange(const MAP& map, i32 z, i32& x0, i32& y0, i32& x1, i32& y1)
+            {
+                x0 = (i32)((map.m_minX[z] - map.m_originX) * map.m_invCellX);
+                y0 = (i32)((map.m_minY[z] - map.m_originY) * map.m_invCellY);
+                x1 = (i32)((map.m_maxX[z] - map.m_originX) * map.m_invCellX);
+                y1 = (i32)((map.m_maxY[z] - map.m_originY) * map.m_invCellY);
+                x0 = (x0 < 0) ? 0 : ((x0 >= map.m_cellsX) ? map.m_cellsX - 1 : x0);
+                y0 = (y0 < 0) ? 0 : ((y0 >= map.m_cellsY) ? map.m_cellsY - 1 : y0);
+                x1 = (x1 < 0) ? 0 : ((x1 >= map.m_cellsX) ? map.m_cellsX - 1 : x1);
+                y1 = (y1 < 0) ? 0 : ((y1 >= map.m_cellsY) ? map.m_cellsY - 1 : y1);
+            }
+
+            // Cell of a position, -1 outside the grid (and so outside every zone)
+            template <typename MAP>
+            static inline i32 cellOf(const MAP& map, f32 px, f32 py)
+            {
+                const f32 fx = (px - map.m_originX) * map.m_invCellX;
+                const f32 fy = (py - map.m_originY) * map.m_invCellY;
+                if (!(fx >= 0.0f && fy >= 0.0f && fx < (f32)map.m_cellsX && fy < (f32)map.m_cellsY))
+                    return -1;
+                return (i32)fy * map.m_cellsX + (i32)fx;
+            }
+
+            // Signed distance of (px, py) to the boundary of zone z, positive inside. 'variance' is the
+            // position variance along the normal of the nearest boundary point, n^T P n with P = | pxx pxy |
+            //                                                                                    | pxy pyy |
+            template <typename MAP>
+            static inline f32 signedDistance(const MAP& map, i32 z, f32 px, f32 py, f32 pxx, f32 pxy, f32 pyy, f32& variance)
+            {
+                if (map.m_count[z] == 0)
+                {
+                    const f32 left = px - map.m_minX[z], right = map.m_maxX[z] - px;
+                    const f32 down = py - map.m_minY[z], up = map.m_maxY[z] - py;
+                    if (left >= 0.0f && right >= 0.0f && down >= 0.0f && up >= 0.0f)
+                    {
+                        const f32 dx = (left < right) ? left : right;
+                        const f32 dy = (down < up) ? down : up;
+                        variance     = (dx < dy) ? pxx : pyy;
+                        return (dx < dy) ? dx : dy;
+                    }
+                    const f32 ex = (left < 0.0f) ? left : ((right < 0.0f) ? -right : 0.0f);
+                    const f32 ey = (down < 0.0f) ? down : ((up < 0.0f) ? -up : 0.0f);
+                    const f32 d2 = ex * ex + ey * ey;
+                    variance     = (ex * ex * pxx + 2.0f * ex * ey * pxy + ey * ey * pyy) / d2;
+                    return -sqrtf(d2);
+                }
+
+                // Crossing number for inside / outside, the nearest point over all edges for the distance
+                const f32* vx     = map.m_vx + map.m_first[z];
+                const f32* vy     = map.m_vy + map.m_first[z];
+                const i32  n      = map.m_count[z];
+                bool       inside = false;
+                f32        best   = 3.4e38f;
+                f32        nx     = 0.0f, ny = 0.0f;
+                for (i32 i = 0, j = n - 1; i < n; j = i++)
+                {
+                    const f32 ax = vx[j], ay = vy[j];
+                    const f32 ex = vx[i] - ax, ey = vy[i] - ay;
+                    if ((ay > py) != (vy[i] > py) && px < ax + (py - ay) * ex / ey)
+                        inside = !inside;
+
+                    const f32 len2 = ex * ex + ey * ey;
+                    f32       t    = (len2 > 0.0f) ? ((px - ax) * ex + (py - ay) * ey) / len2 : 0.0f;
+                    t              = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+                    const f32 dx   = px - (ax + t * ex);
+                    const f32 dy   = py - (ay + t * ey);
+                    const f32 d2   = dx * dx + dy * dy;
+                    if (d2 < best)
+                    {
+                        best = d2;
+                        nx   = dx;
+                        ny   = dy;
+                    }
+                }
+                variance = (best > 0.0f) ? (nx * nx * pxx + 2.0f * nx * ny * pxy + ny * ny * pyy) / best : ((pxx > pyy) ? pxx : pyy);
+                return inside ? sqrtf(best) : -sqrtf(best);
+            }
+
+            // +1 inside beyond the hysteresis band, -1 outside beyond it, 0 within the band
+            template <typename MAP>
+            static inline i32 classify(const MAP& map, i32 z, f32 px, f32 py, f32 pxx, f32 pxy, f32 pyy)
+            {
+                f32       variance;
+                const f32 d    = signedDistance(map, z, px, py, pxx, pxy, pyy, variance);
+                const f32 band = map.m_margin[z] + map.m_sigmas * sqrtf(variance);
+                return (d > band) ? 1 : ((d < -band) ? -1 : 0);
+            }
+
+            // Leaves of the zones 'track' is inside of and enters of the zones listed in its cell. A state
+            // change is only made when its event fits in 'events', the others follow in the next update.
+            template <typename MAP>
+            static inline i32 evaluate(const MAP& map, zone_state_t& state, i32 track, f32 px, f32 py, f32 pxx, f32 pxy, f32 pyy, zone_event_t events[], i32 count, i32 maxEvents)
+            {
+                u16* inside = state.m_inside[track];
+                i32& n      = state.m_insideCount[track];
+                for (i32 i = 0; i < n && count < maxEvents;)
+                {
+                    const i32 z = inside[i];
+                    if (classify(map, z, px, py, pxx, pxy, pyy) < 0)
+                    {
+                        zone_event_t& e = events[count++];
+                        e.m_zone        = map.m_id[z];
+                        e.m_track       = track;
+                        e.m_type        = ZONE_LEAVE;
+                        inside[i]       = inside[--n];
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+
+                const i32 cell = cellOf(map, px, py);
+                if (cell < 0)
+                    return count;
+                for (i32 e = map.m_cellStart[cell]; e < map.m_cellStart[cell + 1] && count < maxEvents && n < RD03D_ZONE_MAX_INSIDE; ++e)
+                {
+                    const i32 z = map.m_cellZones[e];
+                    if (px <= map.m_minX[z] || px >= map.m_maxX[z] || py <= map.m_minY[z] || py >= map.m_maxY[z])
+                        continue;  // outside the bounding box, so not inside the zone
+
+                    bool known = false;
+                    for (i32 i = 0; i < n; ++i)
+                        known = known || (inside[i] == z);
+                    if (known || classify(map, z, px, py, pxx, pxy, pyy) <= 0)
+                        continue;
+
+                    zone_event_t& ev = events[count++];
+                    ev.m_zone        = map.m_id[z];
+                    ev.m_track       = track;
+                    ev.m_type        = ZONE_ENTER;
+                    inside[n++]      = (u16)z;
+                }
+                return count;
+            }
+
+            // The track is gone: leaves of every zone it was inside of
+            template <typename MAP>
+            static inline i32 leaveAll(const MAP& map, zone_state_t& state, i32 track, zone_event_t events[], i32 count, i32 maxEvents)
+            {
+                i32& n = state.m_insideCount[track];
+                while (n > 0 && count < maxEvents)
+                {
+                    zone_event_t& e = events[count++];
+                    e.m_zone        = map.m_id[state.m_inside[track][--n]];
+                    e.m_track       = track;
+                    e.m_type        = ZONE_LEAVE;
+                }
+                return count;
+            }
+        }  // namespace nzones
+
+        // Builds the grid. Returns false only when the cell lists do not fit in ENTRIES even with one cell.
+        template <i32 Z, i32 V, i32 C, i32 E>
+        static inline bool compile(zone_map_t<Z, V, C, E>& map)
+        {
+            map.m_cellsX       = 0;
+            map.m_cellsY       = 0;
+            map.m_cellStart[0] = 0;
+            if (map.m_zoneCount == 0)
+                return true;
+
+            f32 minX = map.m_minX[0], minY = map.m_minY[0], maxX = map.m_maxX[0], maxY = map.m_maxY[0];
+            for (i32 z = 1; z < map.m_zoneCount; ++z)
+            {
+                minX = (map.m_minX[z] < minX) ? map.m_minX[z] : minX;
+                minY = (map.m_minY[z] < minY) ? map.m_minY[z] : minY;
+                maxX = (map.m_maxX[z] > maxX) ? map.m_maxX[z] : maxX;
+                maxY = (map.m_maxY[z] > maxY) ? map.m_maxY[z] : maxY;
+            }
+            const f32 w = (maxX - minX > 1e-3f) ? maxX - minX : 1e-3f;
+            const f32 h = (maxY - minY > 1e-3f) ? maxY - minY : 1e-3f;
+
+            // About four square cells per zone, larger ones while the grid or its lists do not fit
+            const i32 target = (4 * map.m_zoneCount < C) ? 4 * map.m_zoneCount : C;
+            f32       size   = sqrtf(w * h / (f32)target);
+            for (;;)
+            {
+                i32 nx = (i32)ceilf(w / size), ny = (i32)ceilf(h / size);
+                nx     = (nx < 1) ? 1 : nx;
+                ny     = (ny < 1) ? 1 : ny;
+                if ((i64)nx * ny > C)
+                {
+                    size *= 1.1f;
+                    continue;
+                }
+
+                map.m_originX  = minX;
+                map.m_originY  = minY;
+                map.m_invCellX = (f32)nx / w;
+                map.m_invCellY = (f32)ny / h;
+                map.m_cellsX   = nx;
+                map.m_cellsY   = ny;
+
+                i64 entries = 0;
+                for (i32 z = 0; z < map.m_zoneCount; ++z)
+                {
+                    i32 x0, y0, x1, y1;
+                    nzones::cellRange(map, z, x0, y0, x1, y1);
+                    entries += (i64)(x1 - x0 + 1) * (y1 - y0 + 1);
+                }
+                if (entries <= E)
+                    break;
+                if (nx == 1 && ny == 1)
+                {
+                    map.m_cellsX = 0;
+                    map.m_cellsY = 0;
+                    return false;
+                }
+                size *= 1.5f;
+            }
+
+            // Counting sort of the (zone, cell) pairs: counts, running totals (the end of every list),
+            // then the zones in reverse so every list ends up in zone order and m_cellStart at its start
+            const i32 cells = map.m_cellsX * map.m_cellsY;
+            for (i32 c = 0; c <= cells; ++c)
+                map.m_cellStart[c] = 0;
+            for (i32 z = 0; z < map.m_zoneCount; ++z)
+            {
+                i32 x0, y0, x1, y1;
+                nzones::cellRange(map, z, x0, y0, x1, y1);
+                for (i32 y = y0; y <= y1; ++y)
+                    for (i32 x = x0; x <= x1; ++x)
+                        map.m_cellStart[y * map.m_cellsX + x] += 1;
+            }
+            i32 total = 0;
+            for (i32 c = 0; c < cells; ++c)
+            {
+                total += map.m_cellStart[c];
+                map.m_cellStart[c] = total;
+            }
+            map.m_cellStart[cells] = total;
+            for (i32 z = map.m_zoneCount - 1; z >= 0; --z)
+            {
+                i32 x0, y0, x1, y1;
+                nzones::cellRange(map, z, x0, y0, x1, y1);
+                for (i32 y = y0; y <= y1; ++y)
+                    for (i32 x = x0; x <= x1; ++x)
+                        map.m_cellZones[--map.m_cellStart[y * map.m_cellsX + x]] = (u16)z;
+            }
+            return true;
+        }
+
+        // Enter / leave events of the tracks of 'rd' (position and covariance of its filters) since the last
+        // update, at most 'maxEvents'. Returns the number of events written to 'events'.
+        template <i32 Z, i32 V, i32 C, i32 E>
+        static inline i32 update(const zone_map_t<Z, V, C, E>& map, zone_state_t& state, const rd03d_t& rd, zone_event_t events[], i32 maxEvents)
+        {
+            i32 count = 0;
+            for (i32 t = 0; t < MAX_TARGETS; ++t)
+            {
+                if (!rd.m_targetActive[t])
+                {
+                    count = nzones::leaveAll(map, state, t, events, count, maxEvents);
+                    continue;
+                }
+                const rd03d_filter_t& kf = rd.m_roomFilters[t];
+                count                    = nzones::evaluate(map, state, t, kf.x.data[0][0], kf.x.data[1][0], kf.P.data[0][0], kf.P.data[0][1], kf.P.data[1][1], events, count, maxEvents);
+            }
+            return count;
+        }
+
+        // True when track 'track' is inside the zone with id 'id'
+        template <i32 Z, i32 V, i32 C, i32 E>
+        static inline bool isInside(const zone_map_t<Z, V, C, E>& map, const zone_state_t& state, i32 track, u32 id)
+        {
+            for (i32 i = 0; i < state.m_insideCount[track]; ++i)
+                if (map.m_id[state.m_inside[track][i]] == id)
+                    return true;
+            return false;
+        }
+
+    }  // namespace nkalman
+}  // namespace ncore
+
+#endif  // __C_KALMAN_FILTER_RD03D_ZONES_H__
@@ -0,0 +1,240 @@
+#ifndef __C_KALMAN_SIMD_H__
+#define __C_KALMAN_SIMD_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+// Minimal f32 lane-vector abstraction used by the batched (structure-of-arrays) kernels.
+// Every vector type exposes the same static interface so a kernel can be written once
+// and instantiated for AVX2 (8 lanes), SSE2 or NEON (4 lanes) or plain scalar code (1 lane).
+//
+// Define CKALMAN_SIMD_SCALAR to force the scalar fallback on any target.
+//
+// Note: the vector ops are plain mul/add/sub/div with no fused multiply-add, so results are
+// bit-identical to the scalar code as long as the compiler does not contract a*b+c itself
+// (e.g. compile with -ffp-contract=off when bit-exactness matters).
+
+#if !defined(CKALMAN_SIMD_SCALAR)
+#    if defined(__AVX2__)
+#        include <immintrin.h>
+#        define CKALMAN_SIMD_AVX2
+#        define CKALMAN_SIMD_SSE
+#    elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        include <emmintrin.h>
+#        define CKALMAN_SIMD_SSE
+#    elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#        include <arm_neon.h>
+#        define CKALMAN_SIMD_NEON
+#    endif
+#    if defined(CKALMAN_SIMD_SSE) || defined(CKALMAN_SIMD_NEON)
+#        define CKALMAN_SIMD_WIDTH4
+#    endif
+#endif
+
+namespace ncore
+{
+    namespace nkalman
+    {
+        namespace nsimd
+        {
+            // Lane mask convention: a lane participates when its u32 mask word is ~0u and is ignored when it is 0.
+
+            struct f32x1_t
+            {
+                enum
+                {
+                    WIDTH = 1
+                };
+                typedef f32 vec_t;
+                typedef u32 mask_t;
+
+                static inline vec_t  load(const f32* p) { return *p; }
+                static inline void   store(f32* p, vec_t v) { *p = v; }
+                static inline vec_t  set1(f32 v) { return v; }
+                static inline vec_t  zero() { return 0.0f; }
+                static inline vec_t  add(vec_t a, vec_t b) { return a + b; }
+                static inline vec_t  sub(vec_t a, vec_t b) { return a - b; }
+                static inline vec_t  mul(vec_t a, vec_t b) { return a * b; }
+                static inline vec_t  div(vec_t a, vec_t b) { return a / b; }
+                static inline mask_t load_mask(const u32* p) { return *p; }
+                static inline bool   any(mask_t m) { return m != 0; }
+                static inline mask_t not_zero(vec_t v) { return (v != 0.0f) ? ~0u : 0u; }
+                static inline vec_t  select(mask_t m, vec_t a, vec_t b) { return m ? a : b; }  // m ? a : b
+                static inline void   store_masked(f32* p, vec_t v, mask_t m)
+                {
+                    if (m)
+                        *p = v;
+                }
+                static inline vec_t  abs(vec_t v) { return v < 0.0f ? -v : v; }
+                static inline mask_t less(vec_t a, vec_t b) { return (a < b) ? ~0u : 0u; }
+                static inline mask_t mask_or(mask_t a, mask_t b) { return a | b; }
+                static inline bool   all(mask_t m) { return m != 0; }
+                static inline void   store_mask(u32* p, mask_t m) { *p = m; }
+            };
+
+#if defined(CKALMAN_SIMD_SSE)
+            struct f32x4_t
+            {
+                enum
+                {
+                    WIDTH = 4
+                };
+                typedef __m128 vec_t;
+                typedef __m128 mask_t;
+
+                static inline vec_t  load(const f32* p) { return _mm_loadu_ps(p); }
+                static inline void   store(f32* p, vec_t v) { _mm_storeu_ps(p, v); }
+                static inline vec_t  set1(f32 v) { return _mm_set1_ps(v); }
+                static inline vec_t  zero() { return _mm_setzero_ps(); }
+                static inline vec_t  add(vec_t a, vec_t b) { return _mm_add_ps(a, b); }
+                static inline vec_t  sub(vec_t a, vec_t b) { return _mm_sub_ps(a, b); }
+                static inline vec_t  mul(vec_t a, vec_t b) { return _mm_mul_ps(a, b); }
+                static inline vec_t  div(vec_t a, vec_t b) { return _mm_div_ps(a, b); }
+                static inline mask_t load_mask(const u32* p) { return _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)p)); }
+                static inline bool   any(mask_t m) { return _mm_movemask_ps(m) != 0; }
+                static inline mask_t not_zero(vec_t v) { return _mm_cmpneq_ps(v, _mm_setzero_ps()); }
+                static inline vec_t  select(mask_t m, vec_t a, vec_t b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+                static inline void   store_masked(f32* p, vec_t v, mask_t m) { _mm_storeu_ps(p, select(m, v, _mm_loadu_ps(p))); }
+                static inline vec_t  abs(vec_t v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+                static inline mask_t less(vec_t a, vec_t b) { return _mm_cmplt_ps(a, b); }
+                static inline mask_t mask_or(mask_t a, mask_t b) { return _mm_or_ps(a, b); }
+                static inline bool   all(mask_t m) { return _mm_movemask_ps(m) == 0xF; }
+                static inline void   store_mask(u32* p, mask_t m) { _mm_storeu_si128((__m128i*)p, _mm_castps_si128(m)); }
+            };
+#elif defined(CKALMAN_SIMD_NEON)
+            struct f32x4_t
+            {
+                enum
+                {
+                    WIDTH = 4
+                };
+                typedef float32x4_t vec_t;
+                typedef uint32x4_t  mask_t;
+
+                static inline vec_t load(const f32* p) { return vld1q_f32(p); }
+                static inline void  store(f32* p, vec_t v) { vst1q_f32(p, v); }
+                static inline vec_t set1(f32 v) { return vdupq_n_f32(v); }
+                static inline vec_t zero() { return vdupq_n_f32(0.0f); }
+                static inline vec_t add(vec_t a, vec_t b) { return vaddq_f32(a, b); }
+                static inline vec_t sub(vec_t a, vec_t b) { return vsubq_f32(a, b); }
+                static inline vec_t mul(vec_t a, vec_t b) { return vmulq_f32(a, b); }
+                static inline vec_t div(vec_t a, vec_t b)
+                {
+#    if defined(__aarch64__) || defined(_M_ARM64)
+                    return vdivq_f32(a, b);
+#    else
+                    // ARMv7 has no vector divide: reciprocal estimate refined by two Newton-Raphson steps
+                    float32x4_t r = vrecpeq_f32(b);
+                    r             = vmulq_f32(vrecpsq_f32(b, r), r);
+                    r             = vmulq_f32(vrecpsq_f32(b, r), r);
+                    return vmulq_f32(a, r);
+#    endif
+                }
+                static inline mask_t load_mask(const u32* p) { return vld1q_u32(p); }
+                static inline bool   any(mask_t m)
+                {
+                    const uint32x2_t f = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+                    return (vget_lane_u32(f, 0) | vget_lane_u32(f, 1)) != 0;
+                }
+                static inline mask_t not_zero(vec_t v) { return vmvnq_u32(vceqq_f32(v, vdupq_n_f32(0.0f))); }
+                static inline vec_t  select(mask_t m, vec_t a, vec_t b) { return vbslq_f32(m, a, b); }
+                static inline void   store_masked(f32* p, vec_t v, mask_t m) { vst1q_f32(p, vbslq_f32(m, v, vld1q_f32(p))); }
+                static inline vec_t  abs(vec_t v) { return vabsq_f32(v); }
+                static inline mask_t less(vec_t a, vec_t b) { return vcltq_f32(a, b); }
+                static inline mask_t mask_or(mask_t a, mask_t b) { return vorrq_u32(a, b); }
+                static inline bool   all(mask_t m)
+                {
+                    const uint32x2_t f = vand_u32(vget_low_u32(m), vget_high_u32(m));
+                    return (vget_lane_u32(f, 0) & vget_lane_u32(f, 1)) == 0xFFFFFFFFu;
+                }
+                static inline void store_mask(u32* p, mask_t m) { vst1q_u32(p, m); }
+            };
+#endif
+
+#if defined(CKALMAN_SIMD_AVX2)
+            struct f32x8_t
+            {
+                enum
+                {
+                    WIDTH = 8
+                };
+                typedef __m256 vec_t;
+                typedef __m256 mask_t;
+
+                static inline vec_t  load(const f32* p) { return _mm256_loadu_ps(p); }
+                static inline void   store(f32* p, vec_t v) { _mm256_storeu_ps(p, v); }
+                static inline vec_t  set1(f32 v) { return _mm256_set1_ps(v); }
+                static inline vec_t  zero() { return _mm256_setzero_ps(); }
+                static inline vec_t  add(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+                static inline vec_t  sub(vec_t a, vec_t b) { return _mm256_sub_ps(a, b); }
+                static inline vec_t  mul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+                static inline vec_t  div(vec_t a, vec_t b) { return _mm256_div_ps(a, b); }
+                static inline mask_t load_mask(const u32* p) { return _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)p)); }
+                static inline bool   any(mask_t m) { return _mm256_movemask_ps(m) != 0; }
+                static inline mask_t not_zero(vec_t v) { return _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_NEQ_UQ); }
+                static inline vec_t  select(mask_t m, vec_t a, vec_t b) { return _mm256_blendv_ps(b, a, m); }
+                static inline void   store_masked(f32* p, vec_t v, mask_t m) { _mm256_maskstore_ps(p, _mm256_castps_si256(m), v); }
+                static inline vec_t  abs(vec_t v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+                static inline mask_t less(vec_t a, vec_t b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+                static inline mask_t mask_or(mask_t a, mask_t b) { return _mm256_or_ps(a, b); }
+                static inline bool   all(mask_t m) { return _mm256_movemask_ps(m) == 0xFF; }
+                static inline void   store_mask(u32* p, mask_t m) { _mm256_storeu_si256((__m256i*)p, _mm256_castps_si256(m)); }
+            };
+#endif
+
+            // Widest vector type available on this target
+#if defined(CKALMAN_SIMD_AVX2)
+            typedef f32x8_t f32xN_t;
+#elif defined(CKALMAN_SIMD_WIDTH4)
+            typedef f32x4_t f32xN_t;
+#else
+            typedef f32x1_t f32xN_t;
+#endif
+
+            // Picks the widest vector type whose width divides LANES
+            template <i32 LANES, i32 WIDTH>
+            struct divides_t
+            {
+                enum
+                {
+                    VALUE = (LANES % WIDTH) == 0
+                };
+            };
+
+            template <i32 LANES, bool USE8 = false, bool USE4 = false>
+            struct select_impl_t
+            {
+                typedef f32x1_t type;
+            };
+#if defined(CKALMAN_SIMD_WIDTH4)
+            template <i32 LANES>
+            struct select_impl_t<LANES, false, true>
+            {
+                typedef f32x4_t type;
+            };
+#endif
+#if defined(CKALMAN_SIMD_AVX2)
+            template <i32 LANES, bool USE4>
+            struct select_impl_t<LANES, true, USE4>
+            {
+                typedef f32x8_t type;
+            };
+#endif
+
+            template <i32 LANES>
+            struct select_t
+            {
+#if defined(CKALMAN_SIMD_AVX2)
+                typedef typename select_impl_t<LANES, divides_t<LANES, 8>::VALUE != 0, divides_t<LANES, 4>::VALUE != 0>::type type;
+#elif defined(CKALMAN_SIMD_WIDTH4)
+                typedef typename select_impl_t<LANES, false, divides_t<LANES, 4>::VALUE != 0>::type type;
+#else
+                typedef f32x1_t type;
+#endif
+            };
+
+        }  // namespace nsimd
+    }  // namespace nkalman
+}  // namespace ncore
+#endif  // __C_KALMAN_SIMD_H__
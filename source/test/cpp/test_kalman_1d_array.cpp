@@ -0,0 +1,102 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_1d_array.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+UNITTEST_SUITE_BEGIN(kalman_1d_array)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(kalman_1d_array_matches_kalman_1d)
+        {
+            const s32 count = 37;  // not a multiple of any vector width, exercises the scalar tail
+            f32       q[count], r[count], p[count], x[count], k[count], z[count];
+
+            nkalman::kalman_1d_array_t arr;
+            nkalman::setup(arr, q, r, p, x, k, nullptr, count);
+            nkalman::initialize(arr, 0.01f, 0.1f, 1.0f);
+
+            nkalman::kalman_1D_t ref[count];
+            for (s32 i = 0; i < count; ++i)
+            {
+                nkalman::initialize(ref[i], 0.01f + 0.001f * i, 0.1f + 0.01f * i, 1.0f);
+                q[i] = ref[i].q;
+                r[i] = ref[i].r;
+                nkalman::begin(ref[i], (f32)i, 2.0f);
+                nkalman::begin(arr, i, (f32)i, 2.0f);
+            }
+
+            for (s32 step = 0; step < 20; ++step)
+            {
+                for (s32 i = 0; i < count; ++i)
+                {
+                    z[i] = (f32)i + sinf((f32)(step + i));
+                    nkalman::update(ref[i], z[i]);
+                }
+                nkalman::update(arr, z);
+            }
+
+            for (s32 i = 0; i < count; ++i)
+            {
+                CHECK_CLOSE(ref[i].x, x[i], 0.00001f);
+                CHECK_CLOSE(ref[i].p, p[i], 0.00001f);
+                CHECK_CLOSE(ref[i].k, k[i], 0.00001f);
+            }
+        }
+
+        UNITTEST_TEST(kalman_1d_array_converged_channels_skip_recurrence)
+        {
+            const s32 count = 16;
+            f32       q[count], r[count], p[count], x[count], k[count], z[count];
+            u32       converged[count];
+
+            nkalman::kalman_1d_array_t arr;
+            nkalman::setup(arr, q, r, p, x, k, converged, count);
+            nkalman::initialize(arr, 0.01f, 0.1f, 1.0f);
+
+            nkalman::kalman_1D_t ref;
+            nkalman::initialize(ref, 0.01f, 0.1f, 1.0f);
+
+            for (s32 step = 0; step < 200; ++step)
+            {
+                for (s32 i = 0; i < count; ++i)
+                    z[i] = 10.0f + 0.5f * sinf((f32)step * 0.3f);
+                nkalman::update_converging(arr, z, 1e-6f);
+                nkalman::update(ref, z[0]);
+            }
+
+            for (s32 i = 0; i < count; ++i)
+            {
+                CHECK_EQUAL(~0u, converged[i]);
+                CHECK_CLOSE(ref.k, k[i], 0.0001f);
+                CHECK_CLOSE(ref.x, x[i], 0.001f);
+            }
+
+            // Once converged p and k are frozen while x keeps tracking
+            const f32 p_frozen = p[0];
+            const f32 k_frozen = k[0];
+            for (s32 i = 0; i < count; ++i)
+                z[i] = 20.0f;
+            nkalman::update_converging(arr, z, 1e-6f);
+            CHECK_EQUAL(p_frozen, p[0]);
+            CHECK_EQUAL(k_frozen, k[0]);
+            CHECK_TRUE(x[0] > 10.5f);
+
+            // Restarting a channel makes it run the full recurrence again
+            nkalman::begin(arr, 3, 0.0f, 1.0f);
+            CHECK_EQUAL(0u, converged[3]);
+            nkalman::update_converging(arr, z, 1e-6f);
+            CHECK_TRUE(k[3] > k_frozen);
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,222 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_async.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::kalman_async_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, 8> async_t;
+
+    void setup_async(async_t& af)
+    {
+        nkalman::initialize(af, 0.05f);
+        nkalman::model_constant_velocity_t::set_dt(af.m_filter.F, 0.05f);
+        af.m_filter.H.clear();
+        af.m_filter.H.data[0][0] = 1.0f;
+        af.m_filter.H.data[1][1] = 1.0f;
+        af.m_filter.Q.data[2][2] = 0.1f;
+        af.m_filter.Q.data[3][3] = 0.1f;
+        af.m_filter.R.data[0][0] = 0.25f;
+        af.m_filter.R.data[1][1] = 0.15f;
+
+        const f32 initial[4] = {0.0f, 2.0f, 0.0f, 0.0f};
+        nkalman::begin(af, 1000000, initial, 5.0f);
+    }
+
+    // Position of a target walking at (1, -0.5) m/s, 'time' in microseconds
+    void walk(u64 time, f32 z[2])
+    {
+        const f32 t = (f32)(time - 1000000) * 1e-6f;
+        z[0]        = 1.0f * t + 0.05f * sinf(t * 13.0f);
+        z[1]        = 2.0f - 0.5f * t + 0.05f * cosf(t * 7.0f);
+    }
+
+    nkalman::target_t walking_target(s32 frame)
+    {
+        const f32 x = -1.0f + 0.05f * frame;
+        const f32 y = 2.0f;
+
+        nkalman::target_t t;
+        t.m_id       = 1;
+        t.m_detected = true;
+        t.m_distance = sqrtf(x * x + y * y);
+        t.m_angle    = atan2f(x, y) * (180.0f / 3.14159265f);
+        t.m_speed    = 0.0f;
+        return t;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_async)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(async_irregular_intervals_match_predict_correct)
+        {
+            async_t af;
+            setup_async(af);
+            async_t::filter_t kf = af.m_filter;
+
+            // Measurement intervals of 10..90 ms, Q scaled to each interval
+            const u64 intervals[6] = {50000, 10000, 90000, 50000, 30000, 70000};
+            u64       time         = 1000000;
+            for (s32 i = 0; i < 6; ++i)
+            {
+                time += intervals[i];
+                f32 z[2];
+                walk(time, z);
+                CHECK_TRUE(nkalman::update(af, time, z));
+
+                const f32                     dt = (f32)intervals[i] * 1e-6f;
+                const nkalman::matrix_t<4, 4> Q  = kf.Q;
+                for (s32 r = 0; r < 4; ++r)
+                    for (s32 c = 0; c < 4; ++c)
+                        kf.Q.data[r][c] = Q.data[r][c] * (dt / 0.05f);
+                nkalman::predict(kf, dt);
+                kf.Q = Q;
+                nkalman::correct(kf, z);
+            }
+            CHECK_EQUAL(time, nkalman::getTime(af));
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_EQUAL(kf.x.data[i][0], af.m_filter.x.data[i][0]);
+
+            // Two sensors at the same time: the second measurement is a pure correction
+            f32 z[2];
+            walk(time, z);
+            CHECK_TRUE(nkalman::update(af, time, z));
+            nkalman::correct(kf, z);
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_EQUAL(kf.x.data[i][0], af.m_filter.x.data[i][0]);
+            CHECK_EQUAL(0u, af.m_outOfSequence);
+        }
+
+        UNITTEST_TEST(async_out_of_sequence_matches_in_order)
+        {
+            u64 times[20];
+            for (s32 i = 0; i < 20; ++i)
+                times[i] = 1000000 + (u64)(i + 1) * 40000 + (u64)((i * 7) % 5) * 3000;
+
+            async_t ordered;
+            setup_async(ordered);
+            for (s32 i = 0; i < 20; ++i)
+            {
+                f32 z[2];
+                walk(times[i], z);
+                nkalman::update(ordered, times[i], z);
+            }
+
+            // Every third measurement arrives two measurements late
+            async_t late;
+            setup_async(late);
+            s32 order[20];
+            for (s32 i = 0; i < 20; ++i)
+                order[i] = i;
+            for (s32 i = 2; i + 2 < 20; i += 3)
+            {
+                const s32 m  = order[i];
+                order[i]     = order[i + 1];
+                order[i + 1] = order[i + 2];
+                order[i + 2] = m;
+            }
+            for (s32 i = 0; i < 20; ++i)
+            {
+                f32 z[2];
+                walk(times[order[i]], z);
+                CHECK_TRUE(nkalman::update(late, times[order[i]], z));
+            }
+
+            CHECK_TRUE(late.m_outOfSequence > 0);
+            CHECK_EQUAL(ordered.m_time, late.m_time);
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(ordered.m_filter.x.data[i][0], late.m_filter.x.data[i][0], 1e-5f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(ordered.m_filter.P.data[i][j], late.m_filter.P.data[i][j], 1e-5f);
+            }
+        }
+
+        UNITTEST_TEST(async_predict_ahead_and_reject_too_old)
+        {
+            async_t af;
+            setup_async(af);
+
+            u64 time = 1000000;
+            for (s32 i = 0; i < 12; ++i)
+            {
+                time += 50000;
+                f32 z[2];
+                walk(time, z);
+                nkalman::update(af, time, z);
+            }
+            CHECK_EQUAL(8, af.m_count);
+
+            // Predicting ahead and then receiving the frame in between is handled as out-of-sequence
+            nkalman::predict(af, time + 100000);
+            CHECK_EQUAL(time + 100000, nkalman::getTime(af));
+            f32 z[2];
+            walk(time + 50000, z);
+            CHECK_TRUE(nkalman::update(af, time + 50000, z));
+            CHECK_EQUAL(1u, af.m_outOfSequence);
+            CHECK_EQUAL(time + 100000, nkalman::getTime(af));
+            CHECK_CLOSE(0.75f, af.m_filter.x.data[0][0], 0.1f);
+
+            // Older than the 8 entries of history
+            walk(1100000, z);
+            CHECK_FALSE(nkalman::update(af, 1100000, z));
+            CHECK_EQUAL(1u, af.m_rejected);
+        }
+
+        UNITTEST_TEST(rd03d_timestamped_frames)
+        {
+            // Exact 50 ms timestamps give the same tracks as the untimed frames
+            nkalman::rd03d_t regular, timed;
+            nkalman::setup(regular);
+            nkalman::setup(timed);
+            for (s32 f = 0; f < 40; ++f)
+            {
+                const nkalman::target_t t = walking_target(f);
+                nkalman::processFrame(regular, &t, 1);
+                nkalman::processFrame(timed, &t, 1, 5000000 + (u64)f * 50000);
+            }
+            CHECK_CLOSE(regular.m_roomFilters[0].x.data[0][0], timed.m_roomFilters[0].x.data[0][0], 0.01f);
+            CHECK_CLOSE(regular.m_roomFilters[0].x.data[2][0], timed.m_roomFilters[0].x.data[2][0], 0.05f);
+
+            // Jitter of up to 30 ms and a 300 ms gap keep tracking the 1 m/s walk
+            nkalman::rd03d_t jitter;
+            nkalman::setup(jitter);
+            for (s32 f = 0; f < 60; ++f)
+            {
+                const u64 frameTime = (u64)f * 50000 + (u64)((f * 37) % 7) * 5000;
+                if (f >= 30 && f < 36)
+                    continue;
+                const nkalman::target_t t = walking_target(f);
+                nkalman::processFrame(jitter, &t, 1, frameTime);
+            }
+            CHECK_TRUE(jitter.m_targetActive[0]);
+            CHECK_CLOSE(-1.0f + 0.05f * 59, jitter.m_roomFilters[0].x.data[0][0], 0.1f);
+            CHECK_CLOSE(1.0f, jitter.m_roomFilters[0].x.data[2][0], 0.2f);
+
+            // A stale frame does not move the track
+            const nkalman::rd03d_filter_t before = jitter.m_roomFilters[0];
+            const nkalman::target_t       stale  = walking_target(10);
+            nkalman::processFrame(jitter, &stale, 1, 100000);
+            CHECK_EQUAL(before.x.data[0][0], jitter.m_roomFilters[0].x.data[0][0]);
+
+            // and is no detection either: a track that only gets stale frames coasts and drops out
+            CHECK_EQUAL(1, (s32)jitter.m_missedFrames[0]);
+            for (s32 f = 0; f < 10; ++f)
+                nkalman::processFrame(jitter, &stale, 1, 100000);
+            CHECK_FALSE(jitter.m_targetActive[0]);
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,165 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_bank.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+#include <string.h>
+
+using namespace ncore;
+
+namespace
+{
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+    const f32 BANK_TOLERANCE = 1e-4f;  // the compiler contracts a * b + c differently in the two paths
+#else
+    const f32 BANK_TOLERANCE = 0.0f;  // bit exact
+#endif
+
+    bool same(f32 bank, f32 single)
+    {
+        if (BANK_TOLERANCE == 0.0f)
+            return memcmp(&bank, &single, sizeof(f32)) == 0;
+        return fabsf(bank - single) <= BANK_TOLERANCE * (1.0f + fabsf(single));
+    }
+
+    template <s32 N, s32 M>
+    void make_filter(nkalman::kalman_nd_t<N, M>& kf, ntest::random_t& rnd)
+    {
+        nkalman::initialize(kf);
+        for (s32 i = 0; i < N; ++i)
+            for (s32 j = 0; j < N; ++j)
+                kf.F.data[i][j] = ((i == j) ? 1.0f : 0.0f) + 0.05f * rnd.uniform(-1.0f, 1.0f);
+        for (s32 i = 0; i < M; ++i)
+            for (s32 j = 0; j < N; ++j)
+                kf.H.data[i][j] = ((i == j) ? 1.0f : 0.0f) + 0.1f * rnd.uniform(-1.0f, 1.0f);
+        for (s32 i = 0; i < N; ++i)
+            kf.Q.data[i][i] = 0.05f + 0.04f * rnd.uniform(-1.0f, 1.0f);
+        for (s32 i = 0; i < M; ++i)
+            kf.R.data[i][i] = 0.2f + 0.1f * rnd.uniform(-1.0f, 1.0f);
+
+        f32 initial[N];
+        for (s32 i = 0; i < N; ++i)
+            initial[i] = 5.0f * rnd.uniform(-1.0f, 1.0f);
+        nkalman::begin(kf, initial, 2.0f + rnd.uniform(-1.0f, 1.0f));
+    }
+
+    template <s32 N, s32 M, s32 LANES>
+    bool bank_matches_single_filters(bool forceScalar)
+    {
+        ntest::random_t rnd = {12345u};
+
+        nkalman::kalman_nd_t<N, M>              filters[LANES];
+        nkalman::kalman_bank_t<N, M, LANES>     bank;
+        nkalman::initialize(bank);
+        for (s32 l = 0; l < LANES; ++l)
+        {
+            make_filter(filters[l], rnd);
+            nkalman::set_filter(bank, l, filters[l]);
+            nkalman::set_active(bank, l, true);
+        }
+
+        for (s32 step = 0; step < 25; ++step)
+        {
+            f32 z[M][LANES];
+            for (s32 l = 0; l < LANES; ++l)
+            {
+                f32 zl[M];
+                for (s32 i = 0; i < M; ++i)
+                {
+                    zl[i]   = 5.0f * rnd.uniform(-1.0f, 1.0f);
+                    z[i][l] = zl[i];
+                }
+                nkalman::update(filters[l], zl);
+            }
+            if (forceScalar)
+                nkalman::update_scalar(bank, z);
+            else
+                nkalman::update(bank, z);
+        }
+
+        for (s32 l = 0; l < LANES; ++l)
+        {
+            nkalman::kalman_nd_t<N, M> out;
+            nkalman::get_filter(bank, l, out);
+            for (s32 i = 0; i < N; ++i)
+            {
+                if (!same(out.x.data[i][0], filters[l].x.data[i][0]))
+                    return false;
+                for (s32 j = 0; j < N; ++j)
+                    if (!same(out.P.data[i][j], filters[l].P.data[i][j]))
+                        return false;
+                for (s32 j = 0; j < M; ++j)
+                    if (!same(out.K.data[i][j], filters[l].K.data[i][j]))
+                        return false;
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_bank)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(kalman_bank_matches_single_filter_update)
+        {
+            CHECK_TRUE((bank_matches_single_filters<4, 2, 16>(false)));
+            CHECK_TRUE((bank_matches_single_filters<4, 2, 16>(true)));
+            CHECK_TRUE((bank_matches_single_filters<2, 1, 8>(false)));
+            CHECK_TRUE((bank_matches_single_filters<3, 3, 4>(false)));
+            CHECK_TRUE((bank_matches_single_filters<4, 2, 6>(false)));  // 6 lanes, not a multiple of a vector width
+        }
+
+        UNITTEST_TEST(kalman_bank_inactive_lanes_are_untouched)
+        {
+            nkalman::kalman_bank_t<4, 2, 8> bank;
+            nkalman::initialize(bank);
+
+            nkalman::kalman_nd_t<4, 2> kf;
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.H.data[1][1] = 1.0f;
+            for (s32 l = 0; l < 8; ++l)
+                nkalman::set_filter(bank, l, kf);
+
+            const f32 initial[4] = {1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(bank, 3, initial, 5.0f);
+            CHECK_TRUE(nkalman::is_active(bank, 3));
+            CHECK_FALSE(nkalman::is_active(bank, 2));
+
+            f32 z[2][8];
+            for (s32 l = 0; l < 8; ++l)
+            {
+                z[0][l] = 10.0f;
+                z[1][l] = 20.0f;
+            }
+            nkalman::update(bank, z);
+
+            // Active lane moved towards the measurement
+            CHECK_TRUE(bank.x[0][3] > 1.0f);
+            CHECK_TRUE(bank.x[1][3] > 2.0f);
+            CHECK_TRUE(bank.P[0][0][3] < 5.0f);
+
+            // Inactive lanes kept their state and covariance
+            for (s32 l = 0; l < 8; ++l)
+            {
+                if (l == 3)
+                    continue;
+                CHECK_EQUAL(0.0f, bank.x[0][l]);
+                CHECK_EQUAL(0.0f, bank.x[1][l]);
+                CHECK_EQUAL(1.0f, bank.P[0][0][l]);
+                CHECK_EQUAL(0.0f, bank.K[0][0][l]);
+            }
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,189 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_ekf.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    const f64 RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+
+    // The polar model as a user supplied measurement function: double precision, dense Jacobian
+    struct polar_dense_t : nkalman::model_dense_t
+    {
+        static void linearize(const nkalman::matrix_t<4, 1>& x, nkalman::matrix_t<2, 1>& h, nkalman::matrix_t<2, 4>& H)
+        {
+            const f64 px = x.data[0][0], py = x.data[1][0];
+            const f64 r2 = px * px + py * py;
+            const f64 r  = sqrt(r2);
+            h.data[0][0] = (f32)r;
+            h.data[1][0] = (f32)(atan2(px, py) * RAD_TO_DEG);
+            H.clear();
+            H.data[0][0] = (f32)(px / r);
+            H.data[0][1] = (f32)(py / r);
+            H.data[1][0] = (f32)(RAD_TO_DEG * py / r2);
+            H.data[1][1] = (f32)(-RAD_TO_DEG * px / r2);
+        }
+
+        static void residual(nkalman::matrix_t<2, 1>& y)
+        {
+            if (y.data[1][0] > 180.0f)
+                y.data[1][0] -= 360.0f;
+            else if (y.data[1][0] < -180.0f)
+                y.data[1][0] += 360.0f;
+        }
+    };
+
+    // Target 'scenario' at frame 'frame' (20 Hz), far from the sensor: crossing the field of view at 7 m,
+    // walking away from 5 to 8.5 m at an angle, or circling at 7.5 m
+    void trajectory(s32 scenario, s32 frame, f32& x, f32& y)
+    {
+        const f32 t = (f32)frame * 0.05f;
+        if (scenario == 0)
+        {
+            x = -3.0f + 0.3f * t;
+            y = 7.0f;
+        }
+        else if (scenario == 1)
+        {
+            x = 2.0f + 0.08f * t;
+            y = 4.6f + 0.18f * t;
+        }
+        else
+        {
+            x = 7.5f * sinf(0.05f * t);
+            y = 7.5f * cosf(0.05f * t);
+        }
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_ekf)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(ekf_polar_jacobian_matches_finite_differences)
+        {
+            const f32 positions[5][2] = {{0.0f, 2.0f}, {3.0f, 4.0f}, {-5.5f, 1.2f}, {0.7f, -6.0f}, {-0.05f, 0.3f}};
+            for (s32 p = 0; p < 5; ++p)
+            {
+                nkalman::matrix_t<4, 1> x;
+                x.data[0][0] = positions[p][0];
+                x.data[1][0] = positions[p][1];
+                x.data[2][0] = 1.0f;
+                x.data[3][0] = -1.0f;
+
+                nkalman::matrix_t<2, 1> h;
+                nkalman::matrix_t<2, 4> H;
+                nkalman::rd03d_polar_t::linearize(x, h, H);
+                CHECK_CLOSE(sqrt((f64)positions[p][0] * positions[p][0] + (f64)positions[p][1] * positions[p][1]), h.data[0][0], 1e-5);
+                CHECK_CLOSE(atan2((f64)positions[p][0], (f64)positions[p][1]) * RAD_TO_DEG, h.data[1][0], 1e-4);
+
+                // Central differences in double precision, the velocities do not change h
+                for (s32 c = 0; c < 2; ++c)
+                {
+                    const f64 e     = 1e-6;
+                    f64       px[2] = {positions[p][0], positions[p][1]};
+                    f64       mx[2] = {positions[p][0], positions[p][1]};
+                    px[c] += e;
+                    mx[c] -= e;
+                    const f64 dr = (sqrt(px[0] * px[0] + px[1] * px[1]) - sqrt(mx[0] * mx[0] + mx[1] * mx[1])) / (2.0 * e);
+                    const f64 da = (atan2(px[0], px[1]) - atan2(mx[0], mx[1])) * RAD_TO_DEG / (2.0 * e);
+                    CHECK_CLOSE(dr, H.data[0][c], 1e-4 * (1.0 + fabs(dr)));
+                    CHECK_CLOSE(da, H.data[1][c], 1e-4 * (1.0 + fabs(da)));
+                }
+                CHECK_EQUAL(0.0f, H.data[0][2]);
+                CHECK_EQUAL(0.0f, H.data[1][3]);
+            }
+
+            // Angle differences are wrapped, 179 -> -179 degrees is 2 degrees
+            nkalman::matrix_t<2, 1> y;
+            y.data[0][0] = 0.5f;
+            y.data[1][0] = -179.0f - 179.0f;
+            nkalman::rd03d_polar_t::residual(y);
+            CHECK_CLOSE(2.0f, y.data[1][0], 1e-5f);
+            CHECK_EQUAL(0.5f, y.data[0][0]);
+        }
+
+        UNITTEST_TEST(ekf_polar_matches_dense_user_function)
+        {
+            // The specialized model (2 Jacobian columns, f32) against a dense user function (double)
+            nkalman::rd03d_filter_t fast, dense;
+            nkalman::initialize(fast, nkalman::rd03d_model(0.05f));
+            fast.R.data[0][0] = 0.01f;
+            fast.R.data[1][1] = 4.0f;
+            const f32 initial[4] = {-3.0f, 7.0f, 0.0f, 0.0f};
+            nkalman::begin(fast, initial, 5.0f);
+            dense = fast;
+
+            ntest::random_t noise = {12345u};
+            for (s32 frame = 0; frame < 200; ++frame)
+            {
+                f32 x, y;
+                trajectory(0, frame, x, y);
+                const f32 z[2] = {sqrtf(x * x + y * y) + 0.1f * noise.normal(), atan2f(x, y) * 57.2957795f + 2.0f * noise.normal()};
+                nkalman::update_ekf<nkalman::rd03d_polar_t>(fast, z);
+                nkalman::update_ekf<polar_dense_t>(dense, z);
+            }
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_CLOSE(dense.x.data[i][0], fast.x.data[i][0], 1e-3f);
+            for (s32 i = 0; i < 4; ++i)
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(dense.P.data[i][j], fast.P.data[i][j], 1e-4f);
+        }
+
+        UNITTEST_TEST(ekf_polar_tracks_better_at_long_range)
+        {
+            // The same noisy range/angle frames (0.1 m, 2 degrees) through processFrame() in both modes,
+            // position RMS error after the first second. At 7 m the fixed Cartesian R is too small across
+            // the line of sight (0.24 m noise there) and too large along it.
+            for (s32 scenario = 0; scenario < 3; ++scenario)
+            {
+                nkalman::rd03d_t cartesian, polar;
+                nkalman::setup(cartesian);
+                nkalman::setup(polar, 0.05f, 10, nkalman::RD03D_MEASURE_POLAR);
+
+                ntest::random_t noise        = {(u32)(1000 + scenario)};
+                f64             sumCartesian = 0.0, sumPolar = 0.0;
+                s32             samples      = 0;
+                for (s32 frame = 0; frame < 400; ++frame)
+                {
+                    f32 x, y;
+                    trajectory(scenario, frame, x, y);
+
+                    nkalman::target_t target;
+                    target.m_id       = 1;
+                    target.m_detected = true;
+                    target.m_distance = sqrtf(x * x + y * y) + 0.1f * noise.normal();
+                    target.m_angle    = atan2f(x, y) * 57.2957795f + 2.0f * noise.normal();
+                    target.m_speed    = 0.0f;
+                    nkalman::processFrame(cartesian, &target, 1);
+                    nkalman::processFrame(polar, &target, 1);
+
+                    if (frame >= 20)
+                    {
+                        const f32 cx = cartesian.m_roomFilters[0].x.data[0][0] - x, cy = cartesian.m_roomFilters[0].x.data[1][0] - y;
+                        const f32 px = polar.m_roomFilters[0].x.data[0][0] - x, py = polar.m_roomFilters[0].x.data[1][0] - y;
+                        sumCartesian += (f64)(cx * cx + cy * cy);
+                        sumPolar += (f64)(px * px + py * py);
+                        samples += 1;
+                    }
+                }
+                const f64 rmsCartesian = sqrt(sumCartesian / samples);
+                const f64 rmsPolar     = sqrt(sumPolar / samples);
+                CHECK_TRUE(rmsPolar < 0.9 * rmsCartesian);
+                CHECK_TRUE(rmsPolar < 0.15);
+            }
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,139 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_expr.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    template <s32 R, s32 C>
+    void fill(nkalman::matrix_t<R, C>& m, f32 seed)
+    {
+        for (s32 i = 0; i < R; ++i)
+            for (s32 j = 0; j < C; ++j)
+                m.data[i][j] = seed + 0.5f * (f32)i - 0.25f * (f32)j + 0.125f * (f32)(i * j);
+    }
+
+    template <s32 R, s32 C>
+    f32 max_difference(const nkalman::matrix_t<R, C>& a, const nkalman::matrix_t<R, C>& b)
+    {
+        f32 d = 0.0f;
+        for (s32 i = 0; i < R; ++i)
+        {
+            for (s32 j = 0; j < C; ++j)
+            {
+                const f32 e = fabsf(a.data[i][j] - b.data[i][j]);
+                d           = (e > d) ? e : d;
+            }
+        }
+        return d;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_expr)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(expr_matches_method_api)
+        {
+            nkalman::matrix_t<4, 4> F, P, Q;
+            nkalman::matrix_t<2, 4> H;
+            fill(F, 1.0f);
+            fill(H, -0.5f);
+            fill(Q, 0.1f);
+            P.setIdentity();
+            P.data[0][1] = P.data[1][0] = 0.3f;
+            P.data[2][3] = P.data[3][2] = -0.2f;
+
+            // P' = F P F^T + Q
+            nkalman::matrix_t<4, 4> FP, Ft, FPFt, expected;
+            F.multiply(P, FP);
+            F.transpose(Ft);
+            FP.multiply(Ft, FPFt);
+            FPFt.add(Q, expected);
+
+            nkalman::matrix_t<4, 4> result;
+            result = F * P * nkalman::transposed(F) + Q;
+            CHECK_TRUE(max_difference(expected, result) < 1e-5f);
+
+            // Same with P marked symmetric, only the upper triangle is computed
+            expected.subtract(Q, FPFt);  // F P F^T
+            result = F * nkalman::symmetric(P) * nkalman::transposed(F);
+            CHECK_TRUE(max_difference(FPFt, result) < 1e-5f);
+            CHECK_TRUE((F * nkalman::symmetric(P) * nkalman::transposed(F)).symmetric());
+            CHECK_FALSE((F * P * nkalman::transposed(F)).symmetric());
+            CHECK_FALSE((F * nkalman::symmetric(P) * nkalman::transposed(Q)).symmetric());
+            CHECK_TRUE((H * nkalman::transposed(H)).symmetric());
+
+            // S = H P H^T + R, y = z - H x, scaled terms
+            nkalman::matrix_t<2, 2> R;
+            R.setIdentity();
+            nkalman::matrix_t<2, 4> HP;
+            H.multiply(P, HP);
+            nkalman::matrix_t<4, 2> Ht;
+            H.transpose(Ht);
+            nkalman::matrix_t<2, 2> HPHt, S;
+            HP.multiply(Ht, HPHt);
+            HPHt.add(R, S);
+            nkalman::matrix_t<2, 2> S2;
+            S2 = H * nkalman::symmetric(P) * nkalman::transposed(H) + 0.5f * R + R * 0.5f;
+            CHECK_TRUE(max_difference(S, S2) < 1e-5f);
+
+            nkalman::matrix_t<4, 1> x;
+            fill(x, 0.2f);
+            nkalman::matrix_t<2, 1> z, Hx, y, y2;
+            fill(z, 3.0f);
+            H.multiply(x, Hx);
+            z.subtract(Hx, y);
+            y2 = z - H * x;
+            CHECK_TRUE(max_difference(y, y2) < 1e-5f);
+        }
+
+        UNITTEST_TEST(expr_destination_as_operand)
+        {
+            nkalman::matrix_t<4, 4> F, P;
+            fill(F, 1.0f);
+            fill(P, 0.5f);
+            nkalman::matrix_t<4, 1> x, expected;
+            fill(x, 0.2f);
+            F.multiply(x, expected);
+
+            // x is read by every element of F x, evaluated through a temporary
+            x = F * x;
+            CHECK_TRUE(max_difference(expected, x) < 1e-5f);
+
+            // Transposing in place
+            nkalman::matrix_t<4, 4> Pt;
+            P.transpose(Pt);
+            P = nkalman::transposed(P);
+            CHECK_EQUAL(0.0f, max_difference(Pt, P));
+
+            // Element-wise use of the destination needs no temporary and gives the same result
+            nkalman::matrix_t<4, 4> twice;
+            P.add(P, twice);
+            P = P + P;
+            CHECK_EQUAL(0.0f, max_difference(twice, P));
+
+            // A symmetric result that reads its destination
+            nkalman::matrix_t<4, 4> S, SSt;
+            fill(S, 0.3f);
+            nkalman::matrix_t<4, 4> St2;
+            S.transpose(St2);
+            S.multiply(St2, SSt);
+            S = S * nkalman::transposed(S);
+            CHECK_TRUE(max_difference(SSt, S) < 1e-5f);
+            for (s32 i = 0; i < 4; ++i)
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_EQUAL(S.data[i][j], S.data[j][i]);
+        }
+    }
+}
+UNITTEST_SUITE_END
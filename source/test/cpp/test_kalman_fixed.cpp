@@ -0,0 +1,228 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_fixed.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, nkalman::q16_16_t> rd03d_q16_t;
+    typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, nkalman::q8_24_t>  rd03d_q24_t;
+
+    // Target walking a curve at ~1 m/s with +/- 5 cm measurement noise
+    void measurement(s32 step, f32 z[2])
+    {
+        const f32 t     = 0.05f * step;
+        const f32 noise = 0.05f * sinf(step * 12.9898f);
+        z[0]            = 1.0f + 0.8f * t + noise;
+        z[1]            = 3.0f + 0.5f * sinf(0.5f * t) - noise;
+    }
+
+    // Runs the f32 and the fixed-point filter side by side, returns the largest state difference
+    template <typename FIXED>
+    f32 track_difference(s32 steps)
+    {
+        nkalman::rd03d_t rd;
+        nkalman::setup(rd);
+        nkalman::rd03d_filter_t& kf = rd.m_roomFilters[0];
+
+        const f32 initial[4] = {1.0f, 3.0f, 0.0f, 0.0f};
+        nkalman::begin(kf, initial, 5.0f);
+
+        FIXED kfx;
+        nkalman::toFixed(kf, kfx);
+
+        f32 maxDiff = 0.0f;
+        for (s32 step = 0; step < steps; ++step)
+        {
+            f32 z[2];
+            measurement(step, z);
+            nkalman::update(kf, z);
+
+            typedef typename FIXED::value_t scalar_t;
+            const scalar_t                  zx[2] = {scalar_t(z[0]), scalar_t(z[1])};
+            nkalman::update(kfx, zx);
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                const f32 d = fabsf(kf.x.data[i][0] - nkalman::toFloat(kfx.x.data[i][0]));
+                maxDiff     = d > maxDiff ? d : maxDiff;
+            }
+        }
+        return maxDiff;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_fixed)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(fixed_arithmetic)
+        {
+            const nkalman::q16_16_t a(1.5f);
+            const nkalman::q16_16_t b(-2.25f);
+
+            CHECK_EQUAL(0x18000, a.raw);
+            CHECK_CLOSE(-0.75f, nkalman::toFloat(a + b), 0.00001f);
+            CHECK_CLOSE(3.75f, nkalman::toFloat(a - b), 0.00001f);
+            CHECK_CLOSE(-3.375f, nkalman::toFloat(a * b), 0.00001f);
+            CHECK_CLOSE(-1.5f, nkalman::toFloat(b / a), 0.00001f);
+            CHECK_CLOSE(2.25f, nkalman::toFloat(-b), 0.00001f);
+            CHECK_TRUE(b < a);
+            CHECK_TRUE(a == nkalman::q16_16_t(1.5f));
+
+            // Saturation instead of wrap-around
+            const nkalman::q16_16_t big(30000.0f);
+            CHECK_EQUAL(0x7FFFFFFF, (big + big).raw);
+            CHECK_EQUAL(0x7FFFFFFF, (big * big).raw);
+            CHECK_EQUAL((s32)0x80000000, (-big * big).raw);
+            CHECK_EQUAL(0x7FFFFFFF, (a / nkalman::q16_16_t(0.0f)).raw);
+            CHECK_EQUAL(0x7FFFFFFF, nkalman::q16_16_t(100000.0f).raw);
+
+            const nkalman::q8_24_t c(0.1f);
+            CHECK_CLOSE(0.01f, nkalman::toFloat(c * c), 0.0000001f);
+            CHECK_EQUAL(0x7FFFFFFF, nkalman::q8_24_t(200.0f).raw);
+        }
+
+        UNITTEST_TEST(fixed_reciprocal)
+        {
+            f32 v = 0.001f;
+            while (v < 1000.0f)
+            {
+                const nkalman::q16_16_t x(v);
+                const f32               exact = 1.0f / nkalman::toFloat(x);
+                const f32               r     = nkalman::toFloat(nkalman::reciprocal(x));
+                CHECK_CLOSE(exact, r, 1.0f / 65536.0f);
+                CHECK_CLOSE(-exact, nkalman::toFloat(nkalman::reciprocal(-x)), 1.0f / 65536.0f);
+                v *= 1.37f;
+            }
+
+            v = 0.01f;
+            while (v < 100.0f)
+            {
+                const nkalman::q8_24_t x(v);
+                const f32              exact = 1.0f / nkalman::toFloat(x);
+                if (exact < 127.0f)
+                    CHECK_CLOSE(exact, nkalman::toFloat(nkalman::reciprocal(x)), 1.0f / 16777216.0f + exact * 1.0e-6f);
+                v *= 1.37f;
+            }
+
+            // Out of range results saturate
+            CHECK_EQUAL(0x7FFFFFFF, nkalman::reciprocal(nkalman::q8_24_t::fromRaw(1)).raw);
+            CHECK_EQUAL(0x7FFFFFFF, nkalman::reciprocal(nkalman::q16_16_t(0.0f)).raw);
+        }
+
+        UNITTEST_TEST(fixed_matrix_invert)
+        {
+            nkalman::matrix_t<3, 3> a;
+            a.data[0][0] = 4.0f;
+            a.data[0][1] = 1.0f;
+            a.data[0][2] = 0.5f;
+            a.data[1][0] = 1.0f;
+            a.data[1][1] = 3.0f;
+            a.data[1][2] = 0.25f;
+            a.data[2][0] = 0.5f;
+            a.data[2][1] = 0.25f;
+            a.data[2][2] = 2.0f;
+
+            nkalman::matrix_t<3, 3> inv;
+            a.invert(inv);
+
+            nkalman::matrix_t<3, 3, nkalman::q16_16_t> ax;
+            nkalman::matrix_t<3, 3, nkalman::q16_16_t> invx;
+            nkalman::toFixed(a, ax);
+            ax.invert(invx);
+
+            nkalman::matrix_t<3, 3> invf;
+            nkalman::toFloat(invx, invf);
+            for (s32 i = 0; i < 3; ++i)
+                for (s32 j = 0; j < 3; ++j)
+                    CHECK_CLOSE(inv.data[i][j], invf.data[i][j], 0.0002f);
+
+            // A * A^-1 = I in fixed-point
+            nkalman::matrix_t<3, 3, nkalman::q16_16_t> idx;
+            ax.multiply(invx, idx);
+            for (s32 i = 0; i < 3; ++i)
+                for (s32 j = 0; j < 3; ++j)
+                    CHECK_CLOSE((i == j) ? 1.0f : 0.0f, nkalman::toFloat(idx.data[i][j]), 0.0002f);
+        }
+
+        UNITTEST_TEST(fixed_kalman_1d_matches_f32)
+        {
+            nkalman::kalman_1D_t                       kf;
+            nkalman::kalman_1D_of_t<nkalman::q16_16_t> kfx;
+            nkalman::initialize(kf);
+            nkalman::initialize(kfx);
+            nkalman::begin(kf, 20.0f);
+            nkalman::begin(kfx, nkalman::q16_16_t(20.0f));
+
+            f32 maxDiff = 0.0f;
+            for (s32 step = 0; step < 500; ++step)
+            {
+                const f32 z = 21.0f + 0.5f * sinf(step * 0.1f) + 0.2f * sinf(step * 7.31f);
+                const f32 x = nkalman::update(kf, z);
+                const f32 d = fabsf(x - nkalman::toFloat(nkalman::update(kfx, nkalman::q16_16_t(z))));
+                maxDiff     = d > maxDiff ? d : maxDiff;
+            }
+            CHECK_TRUE(maxDiff < 0.001f);
+            CHECK_CLOSE(kf.k, nkalman::toFloat(kfx.k), 0.001f);
+        }
+
+        UNITTEST_TEST(fixed_kalman_nd_q16_16_matches_f32)
+        {
+            const f32 maxDiff = track_difference<rd03d_q16_t>(400);
+            CHECK_TRUE(maxDiff < 0.001f);
+        }
+
+        UNITTEST_TEST(fixed_kalman_nd_q8_24_matches_f32)
+        {
+            // 8 more fractional bits, an order of magnitude closer to the f32 result
+            const f32 maxDiff = track_difference<rd03d_q24_t>(400);
+            CHECK_TRUE(maxDiff < 0.00005f);
+        }
+
+        UNITTEST_TEST(fixed_kalman_nd_dense_large_measurement)
+        {
+            // M > 3 goes through the LDL^T solve
+            nkalman::kalman_nd_t<4, 4>                                                                    kf;
+            nkalman::kalman_nd_t<4, 4, nkalman::model_dense_t, nkalman::model_dense_t, nkalman::q16_16_t> kfx;
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.H.setIdentity();
+            for (s32 i = 0; i < 4; ++i)
+            {
+                kf.Q.data[i][i] = 0.01f;
+                kf.R.data[i][i] = 0.2f + 0.1f * i;
+            }
+            nkalman::toFixed(kf, kfx);
+
+            for (s32 step = 0; step < 100; ++step)
+            {
+                f32               z[4];
+                nkalman::q16_16_t zx[4];
+                for (s32 i = 0; i < 4; ++i)
+                {
+                    z[i]  = (f32)i + 0.1f * sinf(step * 0.7f + i);
+                    zx[i] = nkalman::q16_16_t(z[i]);
+                }
+                nkalman::update(kf, z);
+                nkalman::update(kfx, zx);
+            }
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(kf.x.data[i][0], nkalman::toFloat(kfx.x.data[i][0]), 0.002f);
+                CHECK_CLOSE(kf.P.data[i][i], nkalman::toFloat(kfx.P.data[i][i]), 0.002f);
+            }
+        }
+    }
+}
+UNITTEST_SUITE_END
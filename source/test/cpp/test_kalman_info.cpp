@@ -0,0 +1,152 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_info.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t> cov_filter_t;
+    typedef nkalman::kalman_info_t<4, nkalman::model_constant_velocity_t>  info_filter_t;
+
+    enum
+    {
+        SENSORS = 3
+    };
+
+    // Three sensors measuring the X/Y position with different noise, the third with correlated axes
+    void sensor_noise(s32 s, nkalman::matrix_t<2, 2>& R)
+    {
+        R.clear();
+        R.data[0][0] = 0.25f + 0.1f * s;
+        R.data[1][1] = 0.15f + 0.05f * s;
+        if (s == 2)
+        {
+            R.data[0][1] = 0.05f;
+            R.data[1][0] = 0.05f;
+        }
+    }
+
+    void position_H(nkalman::matrix_t<2, 4>& H)
+    {
+        H.clear();
+        H.data[0][0] = 1.0f;
+        H.data[1][1] = 1.0f;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_info)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(info_matches_sequential_updates)
+        {
+            const f32 initial[4] = {0.0f, 2.0f, 0.0f, 0.0f};
+
+            cov_filter_t cov;
+            nkalman::initialize(cov);
+            nkalman::model_constant_velocity_t::set_dt(cov.F, 0.05f);
+            position_H(cov.H);
+            cov.Q.data[2][2] = 0.1f;
+            cov.Q.data[3][3] = 0.1f;
+            nkalman::begin(cov, initial, 5.0f);
+
+            info_filter_t info;
+            nkalman::initialize(info);
+            info.F = cov.F;
+            info.Q = cov.Q;
+            nkalman::begin(info, initial, 5.0f);
+
+            nkalman::info_sensor_t<4, 2> sensors[SENSORS];
+            nkalman::matrix_t<2, 2>      R[SENSORS];
+            for (s32 s = 0; s < SENSORS; ++s)
+            {
+                sensor_noise(s, R[s]);
+                nkalman::setup(sensors[s], cov.H, R[s]);
+            }
+
+            for (s32 frame = 0; frame < 50; ++frame)
+            {
+                // Covariance form: one prediction, then one correction per sensor
+                nkalman::predict(cov);
+                CHECK_TRUE(nkalman::predict(info));
+
+                nkalman::info_contribution_t<4> sum;
+                nkalman::clear(sum);
+                for (s32 s = 0; s < SENSORS; ++s)
+                {
+                    const f32 z[2] = {-1.0f + 0.05f * frame + 0.02f * s, 2.0f + 0.03f * (f32)((frame + s) % 3)};
+                    cov.R          = R[s];
+                    nkalman::correct(cov, z);
+                    nkalman::contribute(sum, sensors[s], z);
+                }
+                nkalman::correct(info, sum);
+            }
+
+            nkalman::matrix_t<4, 1> x;
+            nkalman::matrix_t<4, 4> P;
+            CHECK_TRUE(nkalman::getState(info, x));
+            CHECK_TRUE(nkalman::getCovariance(info, P));
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(cov.x.data[i][0], x.data[i][0], 1e-3f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(cov.P.data[i][j], P.data[i][j], 1e-4f);
+            }
+        }
+
+        UNITTEST_TEST(info_merge_of_partial_sums)
+        {
+            nkalman::matrix_t<2, 4> H;
+            position_H(H);
+
+            nkalman::info_sensor_t<4, 2> sensors[SENSORS];
+            for (s32 s = 0; s < SENSORS; ++s)
+            {
+                nkalman::matrix_t<2, 2> R;
+                sensor_noise(s, R);
+                nkalman::setup(sensors[s], H, R);
+            }
+
+            const f32 z[SENSORS][2] = {{1.0f, 2.0f}, {1.1f, 2.1f}, {0.9f, 1.95f}};
+
+            nkalman::info_contribution_t<4> all, a, b;
+            nkalman::clear(all);
+            nkalman::clear(a);
+            nkalman::clear(b);
+            for (s32 s = 0; s < SENSORS; ++s)
+                nkalman::contribute(all, sensors[s], z[s]);
+            nkalman::contribute(a, sensors[0], z[0]);
+            nkalman::contribute(b, sensors[1], z[1]);
+            nkalman::contribute(b, sensors[2], z[2]);
+            nkalman::merge(a, b);
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(all.i.data[i][0], a.i.data[i][0], 1e-5f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(all.I.data[i][j], a.I.data[i][j], 1e-5f);
+            }
+
+            // H^T R^-1 H of a diagonal R is diag(1/r) on the measured states
+            CHECK_CLOSE(1.0f / 0.25f, sensors[0].HtRinvH.data[0][0], 1e-5f);
+            CHECK_CLOSE(1.0f / 0.15f, sensors[0].HtRinvH.data[1][1], 1e-4f);
+            CHECK_CLOSE(0.0f, sensors[0].HtRinvH.data[2][2], 1e-6f);
+
+            // Without any information Y is singular and there is no state yet
+            nkalman::kalman_info_t<4> kf;
+            nkalman::initialize(kf);
+            nkalman::matrix_t<4, 1> x;
+            CHECK_FALSE(nkalman::getState(kf, x));
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,97 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_model.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    // Built by the compiler, the static_asserts below fail to compile when any of it is not constexpr
+    constexpr nkalman::rd03d_model_t s_model = nkalman::rd03d_model(0.05f);
+
+    static_assert(s_model.F.data[0][2] == 0.05f, "F of the constant model");
+    static_assert(s_model.F.data[2][0] == 0.0f, "F of the constant model");
+    static_assert(s_model.H.data[1][1] == 1.0f, "H of the constant model");
+    static_assert(s_model.Q.data[3][3] == 0.10f, "Q of the constant model");
+    static_assert(s_model.R.data[0][0] == 0.25f, "R of the constant model");
+
+    constexpr nkalman::matrix_t<2, 2> inverse_of(f32 a, f32 b, f32 c, f32 d)
+    {
+        nkalman::matrix_t<2, 2> m = {{{a, b}, {c, d}}};
+        nkalman::matrix_t<2, 2> out = {};
+        m.invert(out);
+        return out;
+    }
+
+    constexpr nkalman::matrix_t<2, 2> s_inverse = inverse_of(4.0f, 2.0f, 2.0f, 2.0f);
+    static_assert(s_inverse.data[0][0] == 0.5f && s_inverse.data[0][1] == -0.5f && s_inverse.data[1][1] == 1.0f, "constexpr inversion");
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_model)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(model_track_matches_full_filter)
+        {
+            nkalman::rd03d_filter_t kf;
+            nkalman::initialize(kf, s_model);
+            nkalman::rd03d_track_t track;
+            nkalman::initialize(track);
+
+            const f32 initial[nkalman::STATE_DIM] = {-1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+            nkalman::begin(track, initial, 5.0f);
+
+            for (s32 frame = 0; frame < 100; ++frame)
+            {
+                const f32 z[nkalman::MEASURE_DIM] = {-1.0f + 0.05f * frame, 2.0f + 0.01f * (f32)(frame % 3)};
+                nkalman::update(kf, z);
+                nkalman::update(s_model, track, z);
+            }
+
+            for (s32 i = 0; i < nkalman::STATE_DIM; ++i)
+            {
+                CHECK_EQUAL(kf.x.data[i][0], track.x.data[i][0]);
+                for (s32 j = 0; j < nkalman::MEASURE_DIM; ++j)
+                    CHECK_EQUAL(kf.K.data[i][j], track.K.data[i][j]);
+                for (s32 j = 0; j < nkalman::STATE_DIM; ++j)
+                    CHECK_EQUAL(kf.P.data[i][j], track.P.data[i][j]);
+            }
+            CHECK_CLOSE(1.0f, track.x.data[2][0], 0.1f);
+            CHECK_TRUE(sizeof(nkalman::rd03d_track_t) < sizeof(nkalman::rd03d_filter_t) / 2);
+        }
+
+        UNITTEST_TEST(model_setup_uses_shared_model)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd, 0.1f);
+
+            const nkalman::rd03d_model_t model = nkalman::rd03d_model(0.1f);
+            for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+            {
+                for (s32 i = 0; i < nkalman::STATE_DIM; ++i)
+                {
+                    for (s32 j = 0; j < nkalman::STATE_DIM; ++j)
+                    {
+                        CHECK_EQUAL(model.F.data[i][j], rd.m_roomFilters[t].F.data[i][j]);
+                        CHECK_EQUAL(model.Q.data[i][j], rd.m_roomFilters[t].Q.data[i][j]);
+                        CHECK_EQUAL((i == j) ? 1.0f : 0.0f, rd.m_roomFilters[t].P.data[i][j]);
+                    }
+                }
+                CHECK_EQUAL(0.15f, rd.m_roomFilters[t].R.data[1][1]);
+                CHECK_EQUAL(0.0f, rd.m_roomFilters[t].R.data[0][1]);
+            }
+            CHECK_EQUAL(0.1f, rd.m_roomFilters[0].F.data[1][3]);
+        }
+    }
+}
+UNITTEST_SUITE_END
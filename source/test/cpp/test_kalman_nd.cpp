@@ -11,6 +11,32 @@
 
 using namespace ncore;
 
+namespace
+{
+    // N = 6 state observed by M = 5 partially overlapping sensors with diagonal noise
+    void setup_6x5(nkalman::kalman_nd_t<6, 5>& kf)
+    {
+        nkalman::initialize(kf);
+        kf.F.setIdentity();
+        for (s32 i = 0; i < 3; ++i)
+            kf.F.data[i][i + 3] = 0.1f;
+        kf.H.clear();
+        kf.H.data[0][0] = 1.0f;
+        kf.H.data[1][1] = 1.0f;
+        kf.H.data[2][2] = 1.0f;
+        kf.H.data[3][0] = 0.5f;
+        kf.H.data[3][1] = 0.5f;
+        kf.H.data[4][3] = 1.0f;
+        for (s32 i = 0; i < 6; ++i)
+            kf.Q.data[i][i] = (i < 3) ? 0.01f : 0.05f;
+        for (s32 i = 0; i < 5; ++i)
+            kf.R.data[i][i] = 0.1f + 0.05f * (f32)i;
+
+        const f32 initial[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        nkalman::begin(kf, initial, 4.0f);
+    }
+}  // namespace
+
 UNITTEST_SUITE_BEGIN(kalman_nd)
 {
     UNITTEST_FIXTURE(tests)
@@ -50,9 +76,297 @@ UNITTEST_SUITE_BEGIN(kalman_nd)
             CHECK_CLOSE(0.0f, kf.K.data[1][0], 0.0001f);
         }
 
+        UNITTEST_TEST(kalman_nd_fused_update_matches_generic_update)
+        {
+            nkalman::kalman_nd_t<4, 2> kf;
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.F.data[0][2] = 0.05f;
+            kf.F.data[1][3] = 0.05f;
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.H.data[1][1] = 1.0f;
+            kf.Q.data[0][0] = 0.01f;
+            kf.Q.data[1][1] = 0.01f;
+            kf.Q.data[2][2] = 0.10f;
+            kf.Q.data[3][3] = 0.10f;
+            kf.R.data[0][0] = 0.25f;
+            kf.R.data[1][1] = 0.15f;
+
+            const f32 initial[4] = {1.0f, 2.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+
+            nkalman::kalman_nd_t<4, 2> fused = kf;
+            for (s32 step = 0; step < 50; ++step)
+            {
+                const f32 z[2] = {1.0f + 0.02f * step + 0.1f * sinf((f32)step), 2.0f - 0.01f * step + 0.1f * cosf((f32)step * 1.3f)};
+                nkalman::update(kf, z);
+                nkalman::update_fused(fused, z);
+            }
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(kf.x.data[i][0], fused.x.data[i][0], 0.0001f);
+                for (s32 j = 0; j < 4; ++j)
+                {
+                    CHECK_CLOSE(kf.P.data[i][j], fused.P.data[i][j], 0.0001f);
+                    CHECK_EQUAL(fused.P.data[i][j], fused.P.data[j][i]);  // exactly symmetric
+                }
+                for (s32 j = 0; j < 2; ++j)
+                    CHECK_CLOSE(kf.K.data[i][j], fused.K.data[i][j], 0.0001f);
+            }
+        }
+
+        UNITTEST_TEST(kalman_nd_fused_update_three_measurements)
+        {
+            nkalman::kalman_nd_t<3, 3> kf;
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.F.data[0][1] = 0.1f;
+            kf.F.data[1][2] = 0.1f;
+            kf.H.setIdentity();
+            kf.H.data[2][0] = 0.5f;
+            kf.Q.data[0][0] = 0.02f;
+            kf.Q.data[1][1] = 0.03f;
+            kf.Q.data[2][2] = 0.04f;
+            kf.R.data[0][1] = 0.05f;
+            kf.R.data[1][0] = 0.05f;
+
+            const f32 initial[3] = {0.0f, 1.0f, -1.0f};
+            nkalman::begin(kf, initial, 3.0f);
+
+            nkalman::kalman_nd_t<3, 3> fused = kf;
+            for (s32 step = 0; step < 20; ++step)
+            {
+                const f32 z[3] = {0.3f * step, 1.0f - 0.1f * step, 0.5f * sinf((f32)step)};
+                nkalman::update(kf, z);
+                nkalman::update_fused(fused, z);
+            }
+
+            for (s32 i = 0; i < 3; ++i)
+            {
+                CHECK_CLOSE(kf.x.data[i][0], fused.x.data[i][0], 0.0001f);
+                for (s32 j = 0; j < 3; ++j)
+                {
+                    CHECK_CLOSE(kf.P.data[i][j], fused.P.data[i][j], 0.0001f);
+                    CHECK_CLOSE(kf.K.data[i][j], fused.K.data[i][j], 0.0001f);
+                }
+            }
+        }
+
+        UNITTEST_TEST(kalman_nd_update_with_more_than_three_measurements)
+        {
+            nkalman::kalman_nd_t<6, 5> kf;
+            setup_6x5(kf);
+            nkalman::kalman_nd_t<6, 5> fused      = kf;
+            nkalman::kalman_nd_t<6, 5> sequential = kf;
+
+            for (s32 step = 0; step < 30; ++step)
+            {
+                const f32 t    = (f32)step * 0.1f;
+                const f32 z[5] = {t, 2.0f * t, -t, 1.5f * t, 1.0f};
+                nkalman::update(kf, z);
+                nkalman::update_fused(fused, z);
+                nkalman::update_sequential(sequential, z);
+            }
+
+            // The gain must not collapse to zero and the filter must follow the measurements
+            CHECK_TRUE(kf.K.data[0][0] > 0.01f);
+            CHECK_CLOSE(2.9f, kf.x.data[0][0], 0.2f);
+            for (s32 i = 0; i < 6; ++i)
+            {
+                CHECK_CLOSE(kf.x.data[i][0], fused.x.data[i][0], 0.001f);
+                CHECK_CLOSE(kf.x.data[i][0], sequential.x.data[i][0], 0.001f);
+                for (s32 j = 0; j < 6; ++j)
+                {
+                    CHECK_CLOSE(kf.P.data[i][j], fused.P.data[i][j], 0.0001f);
+                    CHECK_CLOSE(kf.P.data[i][j], sequential.P.data[i][j], 0.0001f);
+                }
+            }
+        }
+
+        UNITTEST_TEST(kalman_nd_update_with_indefinite_innovation_covariance)
+        {
+            // A negative R entry makes S indefinite (LDL^T fails): the gain comes from the pivoting inverse
+            nkalman::kalman_nd_t<6, 5> kf;
+            setup_6x5(kf);
+            kf.R.data[4][4] = -5.0f;
+            nkalman::kalman_nd_t<6, 5> fused = kf;
 
+            // K = P_pred H^T S^-1 with P_pred = F P F^T + Q and S = H P_pred H^T + R
+            nkalman::matrix_t<6, 6> Ft, FP, P_pred;
+            kf.F.transpose(Ft);
+            kf.F.multiply(kf.P, FP);
+            FP.multiply(Ft, P_pred);
+            P_pred.add(kf.Q, P_pred);
+            nkalman::matrix_t<6, 5> Ht, PHt, K;
+            nkalman::matrix_t<5, 5> S, S_inv;
+            kf.H.transpose(Ht);
+            P_pred.multiply(Ht, PHt);
+            kf.H.multiply(PHt, S);
+            S.add(kf.R, S);
+            S.invert(S_inv);
+            PHt.multiply(S_inv, K);
 
+            const f32 z[5] = {1.0f, 2.0f, -1.0f, 1.5f, 1.0f};
+            nkalman::update(kf, z);
+            nkalman::update_fused(fused, z);
+            CHECK_TRUE(kf.K.data[3][4] < -0.1f);
+            for (s32 i = 0; i < 6; ++i)
+            {
+                for (s32 j = 0; j < 5; ++j)
+                    CHECK_CLOSE(K.data[i][j], kf.K.data[i][j], 1e-4f);
+                CHECK_CLOSE(kf.x.data[i][0], fused.x.data[i][0], 1e-3f);
+            }
+        }
+
+        UNITTEST_TEST(kalman_nd_structured_model_matches_dense_model)
+        {
+            typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > cv_filter_t;
+
+            nkalman::kalman_nd_t<4, 2> dense;
+            nkalman::initialize(dense);
+            dense.F.setIdentity();
+            dense.F.data[0][2] = 0.05f;
+            dense.F.data[1][3] = 0.07f;  // per-axis dt
+            dense.H.clear();
+            dense.H.data[0][0] = 1.0f;
+            dense.H.data[1][1] = 1.0f;
+            dense.Q.data[0][0] = 0.01f;
+            dense.Q.data[1][1] = 0.01f;
+            dense.Q.data[2][2] = 0.10f;
+            dense.Q.data[3][3] = 0.10f;
+            dense.R.data[0][0] = 0.25f;
+            dense.R.data[1][1] = 0.15f;
+
+            cv_filter_t cv;
+            nkalman::initialize(cv);
+            cv.F = dense.F;
+            cv.H = dense.H;
+            cv.Q = dense.Q;
+            cv.R = dense.R;
+
+            const f32 initial[4] = {1.0f, -1.0f, 0.0f, 0.0f};
+            nkalman::begin(dense, initial, 5.0f);
+            nkalman::begin(cv, initial, 5.0f);
+
+            for (s32 step = 0; step < 60; ++step)
+            {
+                const f32 z[2] = {1.0f + 0.04f * step + 0.05f * sinf((f32)step * 2.1f), -1.0f + 0.03f * step + 0.05f * cosf((f32)step * 1.7f)};
+                nkalman::update(dense, z);
+                nkalman::update(cv, z);
+            }
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(dense.x.data[i][0], cv.x.data[i][0], 0.0001f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(dense.P.data[i][j], cv.P.data[i][j], 0.0001f);
+                for (s32 j = 0; j < 2; ++j)
+                    CHECK_CLOSE(dense.K.data[i][j], cv.K.data[i][j], 0.0001f);
+            }
+        }
 
+        UNITTEST_TEST(kalman_nd_sequential_update_matches_update)
+        {
+            nkalman::kalman_nd_t<2, 1> kf;
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.Q.clear();
+            kf.R.setIdentity();
+
+            const f32 initial[2] = {0.0f, 0.0f};
+            nkalman::begin(kf, initial, 1.0f);
+
+            const f32 measurement[1] = {1.0f};
+            nkalman::update_sequential(kf, measurement);
+
+            CHECK_CLOSE(0.5f, kf.x.data[0][0], 0.0001f);
+            CHECK_CLOSE(0.0f, kf.x.data[1][0], 0.0001f);
+            CHECK_CLOSE(0.5f, kf.P.data[0][0], 0.0001f);
+            CHECK_CLOSE(1.0f, kf.P.data[1][1], 0.0001f);
+            CHECK_CLOSE(0.5f, kf.K.data[0][0], 0.0001f);
+        }
+
+        UNITTEST_TEST(kalman_nd_predict_correct_matches_update)
+        {
+            nkalman::kalman_nd_t<6, 5> a;
+            setup_6x5(a);
+            a.Q.data[0][3] = 0.002f;
+            a.Q.data[3][0] = 0.002f;
+            nkalman::kalman_nd_t<6, 5> b = a;
+
+            for (s32 step = 0; step < 10; ++step)
+            {
+                const f32 z[5] = {0.1f * step, 0.2f, -0.1f * step, 0.05f * step + 0.1f, 0.3f};
+                nkalman::update(a, z);
+                nkalman::predict(b);
+                nkalman::correct(b, z);
+            }
+            for (s32 i = 0; i < 6; ++i)
+            {
+                CHECK_EQUAL(a.x.data[i][0], b.x.data[i][0]);
+                for (s32 j = 0; j < 6; ++j)
+                    CHECK_EQUAL(a.P.data[i][j], b.P.data[i][j]);
+            }
+        }
+
+        UNITTEST_TEST(kalman_nd_predict_dt_rebuilds_F)
+        {
+            nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > kf;
+            nkalman::initialize(kf);
+            const f32 initial[4] = {1.0f, 2.0f, 0.5f, -1.0f};
+            nkalman::begin(kf, initial, 1.0f);
+
+            nkalman::predict(kf, 0.2f);
+            CHECK_CLOSE(1.1f, kf.x.data[0][0], 0.00001f);
+            CHECK_CLOSE(1.8f, kf.x.data[1][0], 0.00001f);
+            CHECK_CLOSE(0.2f, kf.F.data[0][2], 0.00001f);
+            CHECK_CLOSE(0.2f, kf.F.data[1][3], 0.00001f);
+            CHECK_CLOSE(0.0f, kf.F.data[0][3], 0.00001f);
+            CHECK_CLOSE(1.0f, kf.F.data[3][3], 0.00001f);
+            // P = F P F^T + Q with P = I, Q = I
+            CHECK_CLOSE(2.04f, kf.P.data[0][0], 0.00001f);
+            CHECK_CLOSE(0.2f, kf.P.data[0][2], 0.00001f);
+            CHECK_CLOSE(2.0f, kf.P.data[2][2], 0.00001f);
+        }
+
+        UNITTEST_TEST(kalman_nd_predict_steps_matches_repeated_predict)
+        {
+            nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > one;
+            nkalman::initialize(one);
+            one.Q.data[0][0] = 0.01f;
+            one.Q.data[1][1] = 0.02f;
+            one.Q.data[2][2] = 0.1f;
+            one.Q.data[3][3] = 0.2f;
+            one.Q.data[0][2] = 0.005f;  // position/velocity cross terms
+            one.Q.data[2][0] = 0.005f;
+            one.Q.data[1][3] = 0.003f;
+            one.Q.data[3][1] = 0.003f;
+            const f32 initial[4] = {1.0f, 2.0f, 0.5f, -1.0f};
+            nkalman::begin(one, initial, 2.0f);
+            one.P.data[0][2] = 0.3f;
+            one.P.data[2][0] = 0.3f;
+
+            nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > many = one;
+
+            const s32 steps = 7;
+            for (s32 i = 0; i < steps; ++i)
+                nkalman::predict(many, 0.05f);
+            nkalman::predict(one, 0.05f, steps);
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(many.x.data[i][0], one.x.data[i][0], 0.00001f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(many.P.data[i][j], one.P.data[i][j], 0.0001f);
+            }
+
+            // F is left at the single step interval
+            CHECK_CLOSE(0.05f, one.F.data[0][2], 0.00001f);
+        }
     }
 }
 UNITTEST_SUITE_END
@@ -0,0 +1,99 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_packed.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+UNITTEST_SUITE_BEGIN(kalman_packed)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(symmetric_packing_roundtrip)
+        {
+            nkalman::matrix_t<3, 3> full;
+            full.data[0][0] = 1.0f;
+            full.data[0][1] = 2.0f;
+            full.data[0][2] = 3.0f;
+            full.data[1][0] = 2.0f;
+            full.data[1][1] = 4.0f;
+            full.data[1][2] = 5.0f;
+            full.data[2][0] = 3.0f;
+            full.data[2][1] = 5.0f;
+            full.data[2][2] = 6.0f;
+
+            nkalman::symmetric_t<3> sym;
+            CHECK_EQUAL(6, (s32)nkalman::symmetric_t<3>::SIZE);
+            sym.fromMatrix(full);
+            for (s32 i = 0; i < 6; ++i)
+                CHECK_CLOSE((f32)(i + 1), sym.data[i], 0.00001f);
+
+            nkalman::matrix_t<3, 3> back;
+            sym.toMatrix(back);
+            for (s32 i = 0; i < 3; ++i)
+                for (s32 j = 0; j < 3; ++j)
+                    CHECK_CLOSE(full.data[i][j], back.data[i][j], 0.00001f);
+
+            sym.set(2, 0, 9.0f);
+            CHECK_CLOSE(9.0f, sym.get(0, 2), 0.00001f);
+        }
+
+        UNITTEST_TEST(kalman_packed_is_smaller_than_kalman_nd)
+        {
+            // 4x2 RD03D filter: P 10 instead of 16, Q 4 instead of 16, R 2 instead of 4 floats
+            CHECK_EQUAL(sizeof(nkalman::kalman_nd_t<4, 2>) - 20 * sizeof(f32), sizeof(nkalman::kalman_packed_t<4, 2>));
+            CHECK_TRUE(sizeof(nkalman::kalman_packed_t<6, 3>) < sizeof(nkalman::kalman_nd_t<6, 3>));
+        }
+
+        UNITTEST_TEST(kalman_packed_matches_kalman_nd)
+        {
+            nkalman::kalman_nd_t<4, 2>     kf;
+            nkalman::kalman_packed_t<4, 2> pk;
+            nkalman::initialize(kf);
+            nkalman::initialize(pk);
+
+            kf.F.setIdentity();
+            kf.F.data[0][2] = 0.05f;
+            kf.F.data[1][3] = 0.05f;
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            kf.H.data[1][1] = 1.0f;
+            kf.Q.data[0][0] = pk.Q.data[0] = 0.01f;
+            kf.Q.data[1][1] = pk.Q.data[1] = 0.01f;
+            kf.Q.data[2][2] = pk.Q.data[2] = 0.10f;
+            kf.Q.data[3][3] = pk.Q.data[3] = 0.10f;
+            kf.R.data[0][0] = pk.R.data[0] = 0.25f;
+            kf.R.data[1][1] = pk.R.data[1] = 0.15f;
+            pk.F = kf.F;
+            pk.H = kf.H;
+
+            const f32 initial[4] = {0.5f, 1.5f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+            nkalman::begin(pk, initial, 5.0f);
+
+            for (s32 step = 0; step < 40; ++step)
+            {
+                const f32 z[2] = {0.5f + 0.03f * step + 0.05f * sinf((f32)step), 1.5f + 0.02f * step};
+                nkalman::update(kf, z);
+                nkalman::update(pk, z);
+            }
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(kf.x.data[i][0], pk.x.data[i][0], 0.0001f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(kf.P.data[i][j], pk.P.get(i, j), 0.0001f);
+                for (s32 j = 0; j < 2; ++j)
+                    CHECK_CLOSE(kf.K.data[i][j], pk.K.data[i][j], 0.0001f);
+            }
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,139 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_smoother.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::kalman_smoother_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1>, 6> smoother_t;
+    typedef smoother_t::filter_t                                                                                  filter_t;
+
+    void setup_filter(filter_t& kf)
+    {
+        nkalman::initialize(kf);
+        nkalman::model_constant_velocity_t::set_dt(kf.F, 0.05f);
+        kf.H.clear();
+        kf.H.data[0][0] = 1.0f;
+        kf.H.data[1][1] = 1.0f;
+        kf.Q.data[0][0] = 0.001f;
+        kf.Q.data[1][1] = 0.001f;
+        kf.Q.data[2][2] = 0.01f;
+        kf.Q.data[3][3] = 0.01f;
+        kf.R.data[0][0] = 0.04f;
+        kf.R.data[1][1] = 0.04f;
+        const f32 initial[4] = {0.0f, 2.0f, 0.0f, 0.0f};
+        nkalman::begin(kf, initial, 1.0f);
+    }
+
+    // Target walking a circle of 1 m radius in 10 s, measured with 0.2 m noise
+    enum
+    {
+        FRAMES = 200
+    };
+
+    void truth(s32 frame, f32 p[2])
+    {
+        const f32 a = (f32)frame * 0.05f * (2.0f * 3.14159265f / 10.0f);
+        p[0]        = sinf(a);
+        p[1]        = 2.0f + 1.0f - cosf(a);
+    }
+
+    void make_measurements(f32 z[FRAMES][2])
+    {
+        ntest::random_t rnd = {99};
+        for (s32 i = 0; i < FRAMES; ++i)
+        {
+            truth(i, z[i]);
+            z[i][0] += 0.2f * rnd.normal();
+            z[i][1] += 0.2f * rnd.normal();
+        }
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_smoother)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(smoother_fixed_lag_matches_batch)
+        {
+            static f32 z[FRAMES][2];
+            make_measurements(z);
+
+            smoother_t sm;
+            nkalman::initialize(sm);
+            setup_filter(sm.m_filter);
+
+            // Smoothed estimate of frame 40 - 6 from the fixed-lag smoother
+            nkalman::matrix_t<4, 1> fixedLag;
+            for (s32 i = 0; i <= 40; ++i)
+            {
+                nkalman::matrix_t<4, 1> xs;
+                const bool              ready = nkalman::update(sm, z[i], xs);
+                CHECK_EQUAL(i >= 6, ready);
+                if (i == 40)
+                    fixedLag = xs;
+            }
+
+            // The same from a batch over frames 0..40
+            filter_t kf;
+            setup_filter(kf);
+            static nkalman::matrix_t<4, 1> xs[41];
+            static nkalman::matrix_t<4, 4> Ps[41];
+            nkalman::smooth(kf, z, 41, xs, Ps);
+
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_CLOSE(xs[34].data[i][0], fixedLag.data[i][0], 1e-4f);
+
+            // The newest frame of a batch is the filtered estimate itself
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_CLOSE(sm.m_filter.x.data[i][0], xs[40].data[i][0], 1e-5f);
+        }
+
+        UNITTEST_TEST(smoother_reduces_error)
+        {
+            static f32 z[FRAMES][2];
+            make_measurements(z);
+
+            filter_t kf;
+            setup_filter(kf);
+            static nkalman::matrix_t<4, 1> xs[FRAMES];
+            static nkalman::matrix_t<4, 4> Ps[FRAMES];
+            nkalman::smooth(kf, z, FRAMES, xs, Ps);
+
+            filter_t forward;
+            setup_filter(forward);
+            f64 filteredError = 0.0;
+            f64 smoothedError = 0.0;
+            for (s32 i = 0; i < FRAMES; ++i)
+            {
+                nkalman::update(forward, z[i]);
+                if (i < 20)
+                    continue;  // skip the initial convergence
+                f32 p[2];
+                truth(i, p);
+                for (s32 a = 0; a < 2; ++a)
+                {
+                    const f64 ef = forward.x.data[a][0] - p[a];
+                    const f64 es = xs[i].data[a][0] - p[a];
+                    filteredError += ef * ef;
+                    smoothedError += es * es;
+                }
+
+                // The smoothed covariance is never larger than the filtered one
+                CHECK_TRUE(Ps[i].data[0][0] <= forward.P.data[0][0] + 1e-6f);
+            }
+            CHECK_TRUE(smoothedError < 0.7 * filteredError);
+        }
+    }
+}
+UNITTEST_SUITE_END
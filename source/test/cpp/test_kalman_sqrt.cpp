@@ -0,0 +1,164 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_sqrt.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::kalman_nd_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> >   cov_filter_t;
+    typedef nkalman::kalman_sqrt_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > sqrt_filter_t;
+
+    void setup_filter(cov_filter_t& kf, f32 r, f32 q, f32 uncertainty)
+    {
+        nkalman::initialize(kf);
+        nkalman::model_constant_velocity_t::set_dt(kf.F, 0.05f);
+        kf.H.clear();
+        kf.H.data[0][0] = 1.0f;
+        kf.H.data[1][1] = 1.0f;
+        for (s32 i = 0; i < 4; ++i)
+            kf.Q.data[i][i] = q;
+        kf.R.data[0][0] = r;
+        kf.R.data[1][1] = r;
+        kf.R.data[0][1] = 0.3f * r;
+        kf.R.data[1][0] = 0.3f * r;
+        const f32 initial[4] = {0.0f, 2.0f, 0.0f, 0.0f};
+        nkalman::begin(kf, initial, uncertainty);
+    }
+
+    void measure(s32 frame, f32 noise, ntest::random_t& rnd, f32 z[2])
+    {
+        const f32 t = (f32)frame * 0.05f;
+        z[0]        = 2.0f * sinf(t * 0.1f) + noise * rnd.uniform(-0.5f, 0.5f);
+        z[1]        = 2.0f + cosf(t * 0.13f) + noise * rnd.uniform(-0.5f, 0.5f);
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_sqrt)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(sqrt_cholesky)
+        {
+            nkalman::matrix_t<3, 3> A;
+            const f32               a[3][3] = {{4.0f, 2.0f, 0.4f}, {2.0f, 5.0f, 1.0f}, {0.4f, 1.0f, 3.0f}};
+            for (s32 i = 0; i < 3; ++i)
+                for (s32 j = 0; j < 3; ++j)
+                    A.data[i][j] = a[i][j];
+
+            nkalman::matrix_t<3, 3> L;
+            CHECK_TRUE(nkalman::cholesky(A, L));
+            CHECK_CLOSE(2.0f, L.data[0][0], 1e-6f);
+            CHECK_EQUAL(0.0f, L.data[0][2]);
+            for (s32 i = 0; i < 3; ++i)
+            {
+                for (s32 j = 0; j < 3; ++j)
+                {
+                    f32 sum = 0.0f;
+                    for (s32 k = 0; k < 3; ++k)
+                        sum += L.data[i][k] * L.data[j][k];
+                    CHECK_CLOSE(a[i][j], sum, 1e-5f);
+                }
+            }
+
+            A.data[2][2] = -1.0f;
+            CHECK_FALSE(nkalman::cholesky(A, L));
+        }
+
+        UNITTEST_TEST(sqrt_matches_covariance_form)
+        {
+            cov_filter_t kf;
+            setup_filter(kf, 0.04f, 0.001f, 5.0f);
+            sqrt_filter_t sf;
+            CHECK_TRUE(nkalman::initialize(sf, kf));
+
+            ntest::random_t rnd = {3};
+            for (s32 frame = 0; frame < 500; ++frame)
+            {
+                f32 z[2];
+                measure(frame, 0.5f, rnd, z);
+                nkalman::update(kf, z);
+                nkalman::update(sf, z);
+            }
+
+            nkalman::matrix_t<4, 4> P;
+            nkalman::getCovariance(sf, P);
+            for (s32 i = 0; i < 4; ++i)
+            {
+                CHECK_CLOSE(kf.x.data[i][0], sf.x.data[i][0], 1e-4f);
+                for (s32 j = 0; j < 2; ++j)
+                    CHECK_CLOSE(kf.K.data[i][j], sf.K.data[i][j], 1e-4f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(kf.P.data[i][j], P.data[i][j], 1e-5f);
+                for (s32 j = i + 1; j < 4; ++j)
+                    CHECK_EQUAL(0.0f, sf.S.data[i][j]);
+            }
+        }
+
+        UNITTEST_TEST(sqrt_long_run_stays_positive_definite)
+        {
+            // Very precise measurements and tiny process noise: the covariance form loses symmetry
+            // and definiteness of P in f32, the factored form can not
+            const f32    r = 1e-6f;
+            cov_filter_t kf;
+            setup_filter(kf, r, 1e-9f, 100.0f);
+            sqrt_filter_t sf;
+            CHECK_TRUE(nkalman::initialize(sf, kf));
+
+            ntest::random_t rnd          = {11};
+            const s32       updates      = 1000000;
+            s32             notDefinite  = 0;
+            f32             maxAsymmetry = 0.0f;
+            for (s32 frame = 0; frame < updates; ++frame)
+            {
+                f32 z[2];
+                measure(frame, 3.4f * sqrtf(r), rnd, z);
+                nkalman::update(kf, z);
+                nkalman::update(sf, z);
+
+                for (s32 i = 0; i < 4; ++i)
+                {
+                    for (s32 j = i + 1; j < 4; ++j)
+                    {
+                        const f32 d  = kf.P.data[i][j] - kf.P.data[j][i];
+                        maxAsymmetry = (d > maxAsymmetry) ? d : ((-d > maxAsymmetry) ? -d : maxAsymmetry);
+                    }
+                }
+                if ((frame & 1023) == 0 || frame == updates - 1)
+                {
+                    nkalman::matrix_t<4, 4> P, LD;
+                    nkalman::getCovariance(sf, P);
+                    if (!P.decomposeLDLT(LD))
+                        ++notDefinite;
+                }
+            }
+
+            CHECK_EQUAL(0, notDefinite);
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_TRUE(sf.S.data[i][i] != 0.0f);
+
+            // The covariance form is no longer symmetric relative to its own diagonal
+            nkalman::matrix_t<4, 4> P;
+            nkalman::getCovariance(sf, P);
+            CHECK_TRUE(maxAsymmetry > P.data[0][0]);
+
+            // Both still track the target, the square-root filter at least as well
+            const f32 t  = (f32)(updates - 1) * 0.05f;
+            const f32 tx = 2.0f * sinf(t * 0.1f);
+            const f32 ek = fabsf(kf.x.data[0][0] - tx);
+            const f32 es = fabsf(sf.x.data[0][0] - tx);
+            CHECK_TRUE(es < 0.05f);
+            CHECK_TRUE(es <= ek + 1e-3f);
+        }
+    }
+}
+UNITTEST_SUITE_END
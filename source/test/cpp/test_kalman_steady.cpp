@@ -0,0 +1,137 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_steady.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+UNITTEST_SUITE_BEGIN(kalman_steady)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(kalman_steady_solver_matches_converged_filter)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            nkalman::rd03d_filter_t& kf = rd.m_roomFilters[0];
+
+            const f32 initial[4] = {0.0f, 1.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+
+            nkalman::matrix_t<4, 2> K;
+            nkalman::matrix_t<4, 4> P;
+            CHECK_TRUE(nkalman::solve_steady_state(kf, K, P));
+
+            for (s32 step = 0; step < 200; ++step)
+            {
+                const f32 z[2] = {0.01f * step, 1.0f};
+                nkalman::update(kf, z);
+            }
+
+            for (s32 i = 0; i < 4; ++i)
+            {
+                for (s32 j = 0; j < 2; ++j)
+                    CHECK_CLOSE(kf.K.data[i][j], K.data[i][j], 0.0001f);
+                for (s32 j = 0; j < 4; ++j)
+                    CHECK_CLOSE(kf.P.data[i][j], P.data[i][j], 0.0001f);
+            }
+        }
+
+        UNITTEST_TEST(kalman_steady_gain_only_filter_tracks_like_full_filter)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            nkalman::rd03d_filter_t full = rd.m_roomFilters[0];
+
+            nkalman::kalman_steady_t<4, 2, nkalman::model_constant_velocity_t, nkalman::model_select_t<0, 1> > ss;
+            CHECK_TRUE(nkalman::initialize(ss, full));
+
+            // Start the full filter from its steady-state covariance so both use the same gain
+            nkalman::matrix_t<4, 2> K;
+            CHECK_TRUE(nkalman::solve_steady_state(full, K, full.P));
+            full.x.clear();
+            full.K = K;
+
+            const f32 initial[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            nkalman::begin(ss, initial);
+
+            for (s32 step = 0; step < 100; ++step)
+            {
+                const f32 z[2] = {0.02f * step, 1.0f - 0.01f * step};
+                nkalman::update(full, z);
+                nkalman::update(ss, z);
+            }
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_CLOSE(full.x.data[i][0], ss.x.data[i][0], 0.001f);
+        }
+
+        UNITTEST_TEST(kalman_steady_automatic_switch)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            nkalman::rd03d_filter_t& kf    = rd.m_roomFilters[0];
+            nkalman::rd03d_filter_t  ref   = kf;
+            nkalman::convergence_t&  state = rd.m_convergence[0];
+
+            const f32 initial[4] = {0.0f, 1.0f, 0.0f, 0.0f};
+            nkalman::begin(kf, initial, 5.0f);
+            nkalman::begin(ref, initial, 5.0f);
+            nkalman::reset(state);
+            CHECK_FALSE(nkalman::isConverged(state));
+
+            s32 switchedAt = -1;
+            for (s32 step = 0; step < 300; ++step)
+            {
+                const f32 z[2] = {0.5f * sinf(0.05f * step), 1.0f + 0.01f * step};
+                const bool gainOnly = nkalman::update(kf, state, z);
+                nkalman::update(ref, z);
+                if (gainOnly && switchedAt < 0)
+                    switchedAt = step;
+            }
+
+            // The switch happens after a few dozen frames and the estimate stays on the full filter's
+            CHECK_TRUE(switchedAt > 5);
+            CHECK_TRUE(switchedAt < 200);
+            CHECK_TRUE(nkalman::isConverged(state));
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_CLOSE(ref.x.data[i][0], kf.x.data[i][0], 0.01f);
+
+            nkalman::reset(state);
+            CHECK_FALSE(nkalman::isConverged(state));
+        }
+
+        UNITTEST_TEST(kalman_steady_first_update_is_not_stable)
+        {
+            // Stack memory with a NaN gain: initialize() and begin() clear K, so the first full update
+            // compares the new gain against zero and does not count as a stable frame
+            nkalman::kalman_nd_t<2, 1> kf;
+            for (s32 i = 0; i < 2; ++i)
+                kf.K.data[i][0] = NAN;
+            nkalman::initialize(kf);
+            kf.F.setIdentity();
+            kf.H.clear();
+            kf.H.data[0][0] = 1.0f;
+            CHECK_EQUAL(0.0f, kf.K.data[0][0]);
+
+            const f32 initial[2] = {0.0f, 0.0f};
+            kf.K.data[0][0]      = NAN;
+            nkalman::begin(kf, initial, 5.0f);
+            CHECK_EQUAL(0.0f, kf.K.data[0][0]);
+
+            nkalman::convergence_t state;
+            nkalman::initialize(state, 1e-4f, 1);
+            const f32 z[1] = {1.0f};
+            CHECK_FALSE(nkalman::update(kf, state, z));
+            CHECK_FALSE(nkalman::isConverged(state));
+        }
+    }
+}
+UNITTEST_SUITE_END
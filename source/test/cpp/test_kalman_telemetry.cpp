@@ -0,0 +1,161 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_telemetry.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::kalman_nd_t<2, 2> filter_t;
+
+    // Static 2D position measured directly with variance 'r' per axis
+    void setup_static(filter_t& kf, f32 r)
+    {
+        nkalman::initialize(kf);
+        kf.F.setIdentity();
+        kf.H.setIdentity();
+        kf.Q.setIdentity();
+        kf.Q.data[0][0] = 1e-6f;
+        kf.Q.data[1][1] = 1e-6f;
+        kf.R.setIdentity();
+        kf.R.data[0][0] = r;
+        kf.R.data[1][1] = r;
+        const f32 initial[2] = {0.0f, 0.0f};
+        nkalman::begin(kf, initial, 1.0f);
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_telemetry)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(telemetry_update_matches_update)
+        {
+            filter_t a, b;
+            setup_static(a, 0.1f);
+            setup_static(b, 0.1f);
+
+            nkalman::telemetry_t t;
+            nkalman::initialize(t);
+
+            ntest::random_t rnd = {42};
+            for (s32 i = 0; i < 100; ++i)
+            {
+                const f32 z[2] = {0.5f + 0.3f * rnd.normal(), -0.2f + 0.3f * rnd.normal()};
+                nkalman::update(a, z);
+                nkalman::update(b, z, t);
+            }
+            for (s32 i = 0; i < 2; ++i)
+            {
+                CHECK_EQUAL(a.x.data[i][0], b.x.data[i][0]);
+                for (s32 j = 0; j < 2; ++j)
+                    CHECK_EQUAL(a.P.data[i][j], b.P.data[i][j]);
+            }
+        }
+
+#if defined(CKALMAN_TELEMETRY)
+        UNITTEST_TEST(telemetry_nis_of_consistent_filter)
+        {
+            // A filter whose R matches the noise has NIS ~ chi-square with M = 2 degrees of freedom
+            const f32 r = 0.04f;
+            filter_t  kf;
+            setup_static(kf, r);
+
+            nkalman::telemetry_t t;
+            nkalman::initialize(t);
+
+            ntest::random_t rnd   = {7};
+            const s32       count = 20000;
+            for (s32 i = 0; i < count; ++i)
+            {
+                const f32 z[2] = {1.0f + sqrtf(r) * rnd.normal(), 2.0f + sqrtf(r) * rnd.normal()};
+                nkalman::update(kf, z, t);
+            }
+
+            CHECK_EQUAL((nkalman::telemetry_count_t)count, t.m_updates.load());
+            CHECK_CLOSE(2.0, nkalman::getNisMean(t), 0.1);
+            CHECK_CLOSE(4.0, nkalman::getNisVariance(t), 0.5);
+            CHECK_TRUE(nkalman::getGainNormMean(t) > 0.0);
+            CHECK_TRUE(t.m_gainNormMax.load() <= 1.4143);  // K = k I with k < 1
+
+            u64 timed = 0;
+            for (s32 i = 0; i < nkalman::TELEMETRY_LATENCY_BUCKETS; ++i)
+                timed += t.m_latency[i].load();
+            CHECK_EQUAL((u64)count, timed);
+            CHECK_TRUE(nkalman::getLatencyPercentile(t, 0.5) <= nkalman::getLatencyPercentile(t, 0.99));
+
+            // R ten times too small shows up as a mean NIS far above M
+            filter_t mistuned;
+            setup_static(mistuned, r * 0.1f);
+            nkalman::initialize(t);
+            for (s32 i = 0; i < count; ++i)
+            {
+                const f32 z[2] = {1.0f + sqrtf(r) * rnd.normal(), 2.0f + sqrtf(r) * rnd.normal()};
+                nkalman::update(mistuned, z, t);
+            }
+            CHECK_TRUE(nkalman::getNisMean(t) > 10.0);
+        }
+
+        UNITTEST_TEST(telemetry_rd03d_track_events)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd, 0.05f, 5);
+
+            nkalman::target_t t;
+            t.m_id       = 2;
+            t.m_distance = 2.0f;
+            t.m_angle    = 10.0f;
+            t.m_speed    = 0.0f;
+
+            // spawn, 40 frames, 3 missed frames (coast), 20 frames, then 6 missed frames (drop)
+            for (s32 f = 0; f < 69; ++f)
+            {
+                t.m_detected = (f < 40) || (f >= 43 && f < 63);
+                nkalman::processFrame(rd, &t, 1);
+            }
+
+            CHECK_EQUAL((nkalman::telemetry_count_t)1, rd.m_telemetry.m_spawns.load());
+            CHECK_EQUAL((nkalman::telemetry_count_t)1, rd.m_telemetry.m_coasts.load());
+            CHECK_EQUAL((nkalman::telemetry_count_t)1, rd.m_telemetry.m_drops.load());
+            CHECK_EQUAL((nkalman::telemetry_count_t)60, rd.m_telemetry.m_updates.load() + rd.m_telemetry.m_steadyUpdates.load());
+            CHECK_TRUE(rd.m_telemetry.m_steadyUpdates.load() > 0);
+        }
+
+        UNITTEST_TEST(telemetry_rd03d_timestamped_corrections)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+
+            nkalman::target_t t;
+            t.m_id       = 1;
+            t.m_detected = true;
+            t.m_distance = 2.0f;
+            t.m_angle    = 10.0f;
+            t.m_speed    = 0.0f;
+
+            // 50 ms frames with 30 ms jitter and a 300 ms gap: the corrections off the regular interval
+            // count in the NIS statistics as well
+            s32 frames = 0;
+            for (s32 f = 0; f < 60; ++f)
+            {
+                if (f >= 30 && f < 36)
+                    continue;
+                nkalman::processFrame(rd, &t, 1, (u64)f * 50000 + (u64)((f * 37) % 7) * 5000);
+                ++frames;
+            }
+            CHECK_EQUAL((nkalman::telemetry_count_t)frames, rd.m_telemetry.m_updates.load() + rd.m_telemetry.m_steadyUpdates.load());
+        }
+#endif
+    }
+}
+UNITTEST_SUITE_END
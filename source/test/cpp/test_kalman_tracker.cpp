@@ -0,0 +1,186 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_kalman_tracker.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::tracker_t<8>   small_tracker_t;
+    typedef nkalman::tracker_t<256> large_tracker_t;
+
+    small_tracker_t s_small;
+    large_tracker_t s_grid;
+    large_tracker_t s_brute;
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(kalman_tracker)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(tracker_keeps_ids_when_the_sensor_swaps)
+        {
+            nkalman::setup(s_small, nkalman::rd03d_model(0.05f));
+
+            // Three targets walking in parallel 1m apart, reported in a different order every frame
+            u32 first[3] = {0, 0, 0};
+            for (s32 frame = 0; frame < 100; ++frame)
+            {
+                const f32 t = (f32)frame * 0.05f;
+                f32       z[3][2];
+                s32       target[3];
+                for (s32 i = 0; i < 3; ++i)
+                {
+                    const s32 j = (i + frame) % 3;  // rotates the order
+                    target[i]   = j;
+                    z[i][0]     = -1.0f + (f32)j + 0.02f * sinf(t * 7.0f + (f32)j);
+                    z[i][1]     = 1.0f + 0.5f * t;
+                }
+                u32 ids[3];
+                CHECK_EQUAL(3, nkalman::update(s_small, z, 3, ids));
+                for (s32 i = 0; i < 3; ++i)
+                {
+                    CHECK_TRUE(ids[i] != 0);
+                    if (frame == 0)
+                        first[target[i]] = ids[i];
+                    else
+                        CHECK_EQUAL(first[target[i]], ids[i]);
+                }
+            }
+
+            // Velocity estimated from the positions alone
+            const nkalman::rd03d_track_t* track = nkalman::find(s_small, first[1]);
+            CHECK_TRUE(track != 0);
+            CHECK_CLOSE(0.0f, track->x.data[2][0], 0.1f);
+            CHECK_CLOSE(0.5f, track->x.data[3][0], 0.1f);
+        }
+
+        UNITTEST_TEST(tracker_coasts_drops_and_reuses_slots)
+        {
+            nkalman::setup(s_small, nkalman::rd03d_model(0.05f), nkalman::TRACKER_GREEDY, 9.21f, 1.0f, 3);
+
+            f32 z[9][2];
+            u32 ids[9];
+            for (s32 i = 0; i < 9; ++i)
+            {
+                z[i][0] = 3.0f * (f32)i;
+                z[i][1] = 2.0f;
+            }
+
+            // 9 targets, 8 slots: the last one gets no track
+            CHECK_EQUAL(8, nkalman::update(s_small, z, 9, ids));
+            CHECK_EQUAL(0u, ids[8]);
+            CHECK_EQUAL(0, s_small.m_freeCount);
+
+            // Target 0 disappears: it coasts for 3 frames and is dropped in the 4th
+            for (s32 frame = 0; frame < 3; ++frame)
+                CHECK_EQUAL(8, nkalman::update(s_small, z + 1, 7, ids));
+            CHECK_EQUAL(7, nkalman::update(s_small, z + 1, 7, ids));
+            CHECK_EQUAL(1, s_small.m_freeCount);
+
+            // Its slot is reused with a new ID
+            CHECK_EQUAL(8, nkalman::update(s_small, z + 1, 8, ids));
+            CHECK_EQUAL(9u, ids[7]);
+        }
+
+        UNITTEST_TEST(tracker_auction_minimizes_total_cost)
+        {
+            // Track 0 is close to both measurements, track 1 only to measurement 0. Greedy takes the
+            // cheapest pair (0, 0) and leaves track 1 without a measurement, the auction gives it measurement 0.
+            s_small.m_gate         = 9.21f;
+            s_small.m_activeCount  = 2;
+            s_small.m_candidate[0] = 0;
+            s_small.m_candidate[1] = 2;
+            s_small.m_candidate[2] = 3;
+            const s32 track[3]       = {0, 0, 1};
+            const s32 measurement[3] = {0, 1, 0};
+            const f32 cost[3]        = {1.0f, 2.0f, 1.5f};
+            for (s32 c = 0; c < 3; ++c)
+            {
+                s_small.m_candTrack[c]       = track[c];
+                s_small.m_candMeasurement[c] = measurement[c];
+                s_small.m_candCost[c]        = cost[c];
+            }
+
+            for (s32 solver = 0; solver < 2; ++solver)
+            {
+                s_small.m_assigned[0] = -1;
+                s_small.m_assigned[1] = -1;
+                s_small.m_owner[0]    = -1;
+                s_small.m_owner[1]    = -1;
+                if (solver == 0)
+                {
+                    nkalman::ntracker::greedy(s_small);
+                    CHECK_EQUAL(0, s_small.m_assigned[0]);
+                    CHECK_EQUAL(-1, s_small.m_assigned[1]);
+                }
+                else
+                {
+                    nkalman::ntracker::auction(s_small, 2);
+                    CHECK_EQUAL(1, s_small.m_assigned[0]);
+                    CHECK_EQUAL(0, s_small.m_assigned[1]);
+                    CHECK_EQUAL(1, s_small.m_owner[0]);
+                    CHECK_EQUAL(0, s_small.m_owner[1]);
+                }
+            }
+        }
+
+        UNITTEST_TEST(tracker_grid_matches_brute_force)
+        {
+            // A cell larger than the area puts every measurement in one bucket, which is the brute force
+            // association. The grid has to find exactly the same pairs. A dense scene needs new tracks with
+            // a small uncertainty, or their gates reach most of the other targets.
+            nkalman::setup(s_grid, nkalman::rd03d_model(0.05f), nkalman::TRACKER_AUCTION, 9.21f, 0.5f, 10, 0.5f);
+            nkalman::setup(s_brute, nkalman::rd03d_model(0.05f), nkalman::TRACKER_AUCTION, 9.21f, 1000.0f, 10, 0.5f);
+
+            const s32       targets = 200;
+            f32             position[targets][2];
+            f32             velocity[targets][2];
+            ntest::random_t rnd = {5};
+            for (s32 i = 0; i < targets; ++i)
+            {
+                position[i][0] = 40.0f * rnd.uniform(-0.5f, 0.5f);
+                position[i][1] = 40.0f * rnd.uniform(-0.5f, 0.5f);
+                velocity[i][0] = 2.0f * rnd.uniform(-0.5f, 0.5f);
+                velocity[i][1] = 2.0f * rnd.uniform(-0.5f, 0.5f);
+            }
+
+            s32 mismatches = 0;
+            for (s32 frame = 0; frame < 60; ++frame)
+            {
+                f32 z[targets][2];
+                s32 count = 0;
+                for (s32 i = 0; i < targets; ++i)
+                {
+                    position[i][0] += 0.05f * velocity[i][0];
+                    position[i][1] += 0.05f * velocity[i][1];
+                    if (((frame + i) % 17) == 0)
+                        continue;  // missed detection
+                    z[count][0] = position[i][0] + 0.1f * rnd.uniform(-0.5f, 0.5f);
+                    z[count][1] = position[i][1] + 0.1f * rnd.uniform(-0.5f, 0.5f);
+                    ++count;
+                }
+
+                u32       gridIds[targets], bruteIds[targets];
+                const s32 gridActive  = nkalman::update(s_grid, z, count, gridIds);
+                const s32 bruteActive = nkalman::update(s_brute, z, count, bruteIds);
+                CHECK_EQUAL(bruteActive, gridActive);
+                for (s32 k = 0; k < count; ++k)
+                    mismatches += (gridIds[k] != bruteIds[k]) ? 1 : 0;
+            }
+            CHECK_EQUAL(0, mismatches);
+            CHECK_EQUAL(0u, s_grid.m_dropped);
+            CHECK_EQUAL(targets, s_grid.m_activeCount);
+        }
+    }
+}
+UNITTEST_SUITE_END
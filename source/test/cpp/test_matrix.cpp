@@ -94,6 +94,73 @@ UNITTEST_SUITE_BEGIN(matrix)
             CHECK_CLOSE(0.0f, ident.data[1][0], 0.0001f);
             CHECK_CLOSE(1.0f, ident.data[1][1], 0.0001f);
         }
+
+        UNITTEST_TEST(matrix_invert_larger_than_3x3)
+        {
+            nkalman::matrix_t<5, 5> a;
+            for (s32 i = 0; i < 5; ++i)
+                for (s32 j = 0; j < 5; ++j)
+                    a.data[i][j] = (i == j) ? 4.0f : 1.0f / (f32)(1 + i + 2 * j);
+            a.data[0][0] = 0.0f;  // forces a pivot swap
+
+            nkalman::matrix_t<5, 5> inv;
+            nkalman::matrix_t<5, 5> ident;
+            a.invert(inv);
+            a.multiply(inv, ident);
+            for (s32 i = 0; i < 5; ++i)
+                for (s32 j = 0; j < 5; ++j)
+                    CHECK_CLOSE((i == j) ? 1.0f : 0.0f, ident.data[i][j], 0.0001f);
+
+            nkalman::matrix_t<4, 4> singular;
+            singular.clear();
+            singular.data[0][0] = 1.0f;
+            nkalman::matrix_t<4, 4> singular_inv;
+            singular.invert(singular_inv);
+            CHECK_EQUAL(0.0f, singular_inv.data[0][0]);
+        }
+
+        UNITTEST_TEST(matrix_ldlt_decompose_and_solve)
+        {
+            // Symmetric positive definite A = B * B^T + I
+            nkalman::matrix_t<6, 6> b;
+            for (s32 i = 0; i < 6; ++i)
+                for (s32 j = 0; j < 6; ++j)
+                    b.data[i][j] = (f32)((i * 7 + j * 3) % 5) * 0.25f - 0.5f;
+            nkalman::matrix_t<6, 6> bt;
+            nkalman::matrix_t<6, 6> a;
+            b.transpose(bt);
+            b.multiply(bt, a);
+            for (s32 i = 0; i < 6; ++i)
+                a.data[i][i] += 1.0f;
+
+            nkalman::matrix_t<6, 6> ld;
+            CHECK_TRUE(a.decomposeLDLT(ld));
+
+            nkalman::matrix_t<6, 2> rhs;
+            for (s32 i = 0; i < 6; ++i)
+            {
+                rhs.data[i][0] = (f32)i;
+                rhs.data[i][1] = 1.0f - (f32)i * 0.5f;
+            }
+            nkalman::matrix_t<6, 2> x;
+            ld.solveLDLT(rhs, x);
+
+            nkalman::matrix_t<6, 2> check;
+            a.multiply(x, check);
+            for (s32 i = 0; i < 6; ++i)
+            {
+                CHECK_CLOSE(rhs.data[i][0], check.data[i][0], 0.0001f);
+                CHECK_CLOSE(rhs.data[i][1], check.data[i][1], 0.0001f);
+            }
+
+            nkalman::matrix_t<2, 2> indefinite;
+            indefinite.data[0][0] = 1.0f;
+            indefinite.data[0][1] = 2.0f;
+            indefinite.data[1][0] = 2.0f;
+            indefinite.data[1][1] = 1.0f;
+            nkalman::matrix_t<2, 2> indefinite_ld;
+            CHECK_FALSE(indefinite.decomposeLDLT(indefinite_ld));
+        }
     }
 }
 UNITTEST_SUITE_END
@@ -0,0 +1,44 @@
+#ifndef __C_KALMAN_TEST_RANDOM_H__
+#define __C_KALMAN_TEST_RANDOM_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include <cmath>
+
+namespace ncore
+{
+    namespace ntest
+    {
+        // Deterministic noise for the tests, a 32-bit LCG (Numerical Recipes constants) so that every
+        // platform and build draws the same sequence for the same seed: random_t rnd = {seed};
+        struct random_t
+        {
+            u32 m_state;
+
+            // 24 random bits
+            u32 bits()
+            {
+                m_state = m_state * 1664525u + 1013904223u;
+                return m_state >> 8;
+            }
+
+            // Uniform in [lo, hi)
+            f32 uniform(f32 lo, f32 hi) { return lo + (hi - lo) * ((f32)bits() * (1.0f / 16777216.0f)); }
+
+            // Uniform in (0, 1), never 0 so that it can go into a logarithm
+            f32 uniform() { return ((f32)bits() + 0.5f) * (1.0f / 16777216.0f); }
+
+            // Standard normal (Box-Muller), zero mean and unit variance
+            f32 normal()
+            {
+                const f32 u = uniform();
+                const f32 v = uniform();
+                return sqrtf(-2.0f * logf(u)) * cosf(6.28318531f * v);
+            }
+        };
+    }  // namespace ntest
+}  // namespace ncore
+
+#endif  // __C_KALMAN_TEST_RANDOM_H__
@@ -0,0 +1,102 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_kalman.h"
+#include "ckalman/c_rd03d.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    // Target 1 walking along +X at 1 m/s, 2 m in front of the sensor
+    nkalman::target_t walking_target(s32 frame, f32 dt)
+    {
+        const f32 x = -1.0f + 1.0f * dt * frame;
+        const f32 y = 2.0f;
+
+        nkalman::target_t t;
+        t.m_id       = 1;
+        t.m_detected = true;
+        t.m_distance = sqrtf(x * x + y * y);
+        t.m_angle    = atan2f(x, y) * (180.0f / 3.14159265f);
+        return t;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(rd03d)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(rd03d_spawn_track)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+
+            const nkalman::target_t t = walking_target(0, rd.m_dt);
+            nkalman::processFrame(rd, &t, 1);
+
+            CHECK_TRUE(rd.m_targetActive[0]);
+            CHECK_FALSE(rd.m_targetActive[1]);
+            CHECK_FALSE(rd.m_targetActive[2]);
+            CHECK_CLOSE(-1.0f, rd.m_roomFilters[0].x.data[0][0], 0.001f);
+            CHECK_CLOSE(2.0f, rd.m_roomFilters[0].x.data[1][0], 0.001f);
+        }
+
+        UNITTEST_TEST(rd03d_track_coasts_through_dropout)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd, 0.05f, 10);
+
+            s32 frame = 0;
+            for (; frame < 60; ++frame)
+            {
+                const nkalman::target_t t = walking_target(frame, rd.m_dt);
+                nkalman::processFrame(rd, &t, 1);
+            }
+            const f32 speedBefore = rd.m_roomFilters[0].x.data[2][0];
+            CHECK_CLOSE(1.0f, speedBefore, 0.1f);
+
+            // 5 frames without a detection, the track is kept
+            for (s32 i = 0; i < 5; ++i, ++frame)
+            {
+                nkalman::processFrame(rd, nullptr, 0);
+                CHECK_TRUE(rd.m_targetActive[0]);
+                CHECK_EQUAL(i + 1, rd.m_missedFrames[0]);
+            }
+
+            // Reacquired: the coasted prediction lands on the target, the velocity is not lost
+            const nkalman::target_t t = walking_target(frame, rd.m_dt);
+            nkalman::processFrame(rd, &t, 1);
+            CHECK_TRUE(rd.m_targetActive[0]);
+            CHECK_EQUAL(0, rd.m_missedFrames[0]);
+            CHECK_CLOSE(-1.0f + rd.m_dt * frame, rd.m_roomFilters[0].x.data[0][0], 0.02f);
+            CHECK_CLOSE(1.0f, rd.m_roomFilters[0].x.data[2][0], 0.1f);
+            CHECK_FALSE(nkalman::isConverged(rd.m_convergence[0]));
+        }
+
+        UNITTEST_TEST(rd03d_track_dropped_after_max_missed_frames)
+        {
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd, 0.05f, 3);
+
+            const nkalman::target_t t = walking_target(0, rd.m_dt);
+            nkalman::processFrame(rd, &t, 1);
+
+            for (s32 i = 0; i < 3; ++i)
+            {
+                nkalman::processFrame(rd, nullptr, 0);
+                CHECK_TRUE(rd.m_targetActive[0]);
+            }
+            nkalman::processFrame(rd, nullptr, 0);
+            CHECK_FALSE(rd.m_targetActive[0]);
+            CHECK_EQUAL(0, rd.m_missedFrames[0]);
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,147 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_fleet.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+#include <string.h>
+
+using namespace ncore;
+
+namespace
+{
+    enum
+    {
+        FLEET_SENSORS = 300,
+        FLEET_TICKS   = 60,
+        FLEET_WORKERS = 4
+    };
+
+    u8                     s_memory[nkalman::rd03d_fleet_memory(FLEET_SENSORS)];
+    nkalman::rd03d_fleet_t s_fleet;
+    nkalman::rd03d_t       s_serial[FLEET_SENSORS];
+
+    u32 mix(u32 a, u32 b)
+    {
+        u32 h = a * 0x9E3779B1u ^ (b * 0x85EBCA77u + 0x7F4A7C15u);
+        h ^= h >> 15;
+        h *= 0x85EBCA77u;
+        h ^= h >> 13;
+        return h;
+    }
+
+    // Frame 'frame' of 'sensor': up to three targets walking around the sensor, some not detected
+    s32 make_targets(s32 sensor, s32 frame, nkalman::target_t targets[nkalman::MAX_TARGETS])
+    {
+        const u32 h     = mix((u32)sensor, (u32)frame);
+        const s32 count = 1 + (s32)(h % 3);
+        for (s32 t = 0; t < count; ++t)
+        {
+            const f32 phase       = (f32)sensor * 0.37f + (f32)t * 2.1f + (f32)frame * 0.02f;
+            targets[t].m_id       = (u8)(t + 1);
+            targets[t].m_detected = ((h >> (8 + t)) & 7) != 0;
+            targets[t].m_distance = 2.0f + (f32)t + 0.5f * sinf(phase);
+            targets[t].m_angle    = 30.0f * cosf(phase);
+            targets[t].m_speed    = 0.0f;
+        }
+        return count;
+    }
+
+    bool same(const nkalman::rd03d_t& a, const nkalman::rd03d_t& b)
+    {
+        for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+        {
+            if (a.m_targetActive[t] != b.m_targetActive[t] || a.m_missedFrames[t] != b.m_missedFrames[t])
+                return false;
+            if (memcmp(&a.m_roomFilters[t].x, &b.m_roomFilters[t].x, sizeof(a.m_roomFilters[t].x)) != 0)
+                return false;
+            if (memcmp(&a.m_roomFilters[t].P, &b.m_roomFilters[t].P, sizeof(a.m_roomFilters[t].P)) != 0)
+                return false;
+        }
+        return true;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(rd03d_fleet)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(fleet_matches_serial_processing)
+        {
+            CHECK_TRUE(nkalman::setup(s_fleet, s_memory, FLEET_SENSORS, FLEET_WORKERS));
+            for (s32 s = 0; s < FLEET_SENSORS; ++s)
+                nkalman::setup(s_serial[s]);
+
+            // Every tick a sensor sends 0 to 3 frames, odd sensors with timestamps
+            s32 frame[FLEET_SENSORS];
+            for (s32 s = 0; s < FLEET_SENSORS; ++s)
+                frame[s] = 0;
+
+            s32 pushed = 0, processed = 0;
+            for (s32 tick = 0; tick < FLEET_TICKS; ++tick)
+            {
+                for (s32 s = 0; s < FLEET_SENSORS; ++s)
+                {
+                    const s32 frames = (s32)(mix((u32)s, (u32)(tick + 1000)) & 3);
+                    for (s32 f = 0; f < frames; ++f)
+                    {
+                        nkalman::target_t targets[nkalman::MAX_TARGETS];
+                        const s32         count     = make_targets(s, frame[s], targets);
+                        const u64         timestamp = (s & 1) ? 1000000 + (u64)frame[s] * 50000 + (u64)(mix((u32)s, (u32)frame[s]) % 8000) : 0;
+                        CHECK_TRUE(nkalman::push(s_fleet, s, targets, count, timestamp));
+                        if (timestamp != 0)
+                            nkalman::processFrame(s_serial[s], targets, count, timestamp);
+                        else
+                            nkalman::processFrame(s_serial[s], targets, count);
+                        frame[s] += 1;
+                        pushed += 1;
+                    }
+                }
+                processed += nkalman::tick(s_fleet);
+            }
+            nkalman::teardown(s_fleet);
+
+            CHECK_EQUAL(pushed, processed);
+            s32 different = 0;
+            for (s32 s = 0; s < FLEET_SENSORS; ++s)
+            {
+                different += same(nkalman::getSensor(s_fleet, s), s_serial[s]) ? 0 : 1;
+                CHECK_EQUAL((u64)frame[s], s_fleet.m_sensors[s].m_frames);
+            }
+            CHECK_EQUAL(0, different);
+            CHECK_EQUAL((u64)FLEET_TICKS, s_fleet.m_ticks);
+        }
+
+        UNITTEST_TEST(fleet_storage_and_pending_limit)
+        {
+            // Unaligned memory: the sensors still start on cache lines
+            CHECK_TRUE(nkalman::setup(s_fleet, s_memory + 8, FLEET_SENSORS - 1, 1));
+            for (s32 s = 0; s < FLEET_SENSORS - 1; ++s)
+                CHECK_EQUAL(0u, (u32)((u64)&s_fleet.m_sensors[s] & (nkalman::RD03D_CACHE_LINE_SIZE - 1)));
+            CHECK_TRUE((u8*)(s_fleet.m_batch + FLEET_SENSORS - 1) <= s_memory + sizeof(s_memory));
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            const s32         count = make_targets(7, 0, targets);
+            for (s32 f = 0; f < nkalman::RD03D_FLEET_PENDING; ++f)
+                CHECK_TRUE(nkalman::push(s_fleet, 7, targets, count));
+            CHECK_FALSE(nkalman::push(s_fleet, 7, targets, count));
+            CHECK_EQUAL(1u, s_fleet.m_sensors[7].m_rejected);
+            CHECK_EQUAL(1, s_fleet.m_batchCount);
+
+            CHECK_EQUAL((s32)nkalman::RD03D_FLEET_PENDING, nkalman::tick(s_fleet));
+            CHECK_EQUAL(0, nkalman::tick(s_fleet));
+            CHECK_TRUE(nkalman::push(s_fleet, 7, targets, count));
+            CHECK_EQUAL(1, nkalman::tick(s_fleet));
+            nkalman::teardown(s_fleet);
+
+            CHECK_FALSE(nkalman::setup(s_fleet, s_memory, FLEET_SENSORS, 0));
+            CHECK_FALSE(nkalman::setup(s_fleet, s_memory, FLEET_SENSORS, nkalman::RD03D_FLEET_MAX_WORKERS + 1));
+        }
+    }
+}
+UNITTEST_SUITE_END
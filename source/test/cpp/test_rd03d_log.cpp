@@ -0,0 +1,200 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_log.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+#include <stdio.h>
+#include <string.h>
+
+using namespace ncore;
+
+namespace
+{
+    // Frame 'frame' of sensor 'sensor': one target walking, a second one appearing every other second
+    s32 make_targets(s32 sensor, s32 frame, nkalman::target_t targets[nkalman::MAX_TARGETS])
+    {
+        const f32 x = -1.0f + 0.05f * (f32)(frame % 60) + 0.1f * sensor;
+        const f32 y = 2.0f + 0.2f * sensor;
+
+        targets[0].m_id       = 1;
+        targets[0].m_detected = true;
+        targets[0].m_distance = sqrtf(x * x + y * y);
+        targets[0].m_angle    = atan2f(x, y) * (180.0f / 3.14159265f);
+        targets[0].m_speed    = 0.5f;
+
+        targets[1].m_id       = 2;
+        targets[1].m_detected = ((frame / 20) & 1) != 0;
+        targets[1].m_distance = 3.0f;
+        targets[1].m_angle    = -20.0f + (f32)frame * 0.1f;
+        targets[1].m_speed    = -0.25f;
+        return 2;
+    }
+
+    // Capture time of frame 'frame' in microseconds: 50 ms apart with up to 20 ms of jitter
+    u64 frame_time(s32 frame) { return (u64)frame * 50000 + (u64)((frame * 7) % 5) * 5000; }
+
+    void check_same_tracks(const nkalman::rd03d_t& a, const nkalman::rd03d_t& b)
+    {
+        for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+        {
+            CHECK_EQUAL(a.m_targetActive[t], b.m_targetActive[t]);
+            for (s32 i = 0; i < nkalman::STATE_DIM; ++i)
+                CHECK_EQUAL(a.m_roomFilters[t].x.data[i][0], b.m_roomFilters[t].x.data[i][0]);
+        }
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(rd03d_log)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(rd03d_log_encode_decode)
+        {
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            const s32         count = make_targets(0, 25, targets);
+
+            nkalman::log_record_t r;
+            nkalman::encode(r, 123456789ull, 7, targets, count);
+            CHECK_EQUAL(123456789ull, r.m_timestamp);
+            CHECK_EQUAL(7, r.m_sensorId);
+            CHECK_EQUAL(2, r.m_count);
+
+            nkalman::target_t decoded[nkalman::MAX_TARGETS];
+            CHECK_EQUAL(2, nkalman::decode(r, decoded));
+            for (s32 i = 0; i < 2; ++i)
+            {
+                CHECK_EQUAL(targets[i].m_id, decoded[i].m_id);
+                CHECK_EQUAL(targets[i].m_detected, decoded[i].m_detected);
+                CHECK_EQUAL(targets[i].m_distance, decoded[i].m_distance);
+                CHECK_EQUAL(targets[i].m_angle, decoded[i].m_angle);
+                CHECK_EQUAL(targets[i].m_speed, decoded[i].m_speed);
+            }
+        }
+
+        UNITTEST_TEST(rd03d_log_open_rejects_foreign_data)
+        {
+            nkalman::log_header_t header;
+            memset(&header, 0, sizeof(header));
+            header.m_magic      = nkalman::RD03D_LOG_MAGIC;
+            header.m_version    = nkalman::RD03D_LOG_VERSION;
+            header.m_recordSize = sizeof(nkalman::log_record_t);
+
+            nkalman::log_view_t view;
+            CHECK_TRUE(nkalman::open(view, &header, sizeof(header)));
+            CHECK_EQUAL(0u, (u32)view.m_recordCount);
+            CHECK_FALSE(nkalman::open(view, &header, sizeof(header) - 1));
+
+            header.m_recordSize = sizeof(nkalman::log_record_t) - 8;
+            CHECK_FALSE(nkalman::open(view, &header, sizeof(header)));
+            header.m_recordSize = sizeof(nkalman::log_record_t) + 4;  // would misalign every other record
+            CHECK_FALSE(nkalman::open(view, &header, sizeof(header)));
+            header.m_recordSize = sizeof(nkalman::log_record_t);
+            header.m_magic      = 0x12345678;
+            CHECK_FALSE(nkalman::open(view, &header, sizeof(header)));
+        }
+
+        UNITTEST_TEST(rd03d_log_open_newer_version)
+        {
+            // A newer writer that appended 16 bytes to every record: strided by m_recordSize, known fields read
+            const s32 stride = sizeof(nkalman::log_record_t) + 16;
+            u64       data[(sizeof(nkalman::log_header_t) + 3 * stride) / sizeof(u64)];
+            memset(data, 0xEE, sizeof(data));
+
+            nkalman::log_header_t header;
+            memset(&header, 0, sizeof(header));
+            header.m_magic       = nkalman::RD03D_LOG_MAGIC;
+            header.m_version     = nkalman::RD03D_LOG_VERSION + 1;
+            header.m_recordSize  = (u16)stride;
+            header.m_recordCount = 3;
+            memcpy(data, &header, sizeof(header));
+
+            nkalman::target_t target;
+            target.m_id       = 1;
+            target.m_detected = true;
+            target.m_distance = 2.0f;
+            target.m_angle    = 10.0f;
+            target.m_speed    = 0.0f;
+            for (s32 i = 0; i < 3; ++i)
+            {
+                nkalman::log_record_t r;
+                nkalman::encode(r, (u64)i * 50000, 7, &target, 1);
+                memcpy((u8*)data + sizeof(header) + i * stride, &r, sizeof(r));
+            }
+
+            nkalman::log_view_t view;
+            CHECK_TRUE(nkalman::open(view, data, sizeof(data)));
+            CHECK_EQUAL((u64)3, view.m_recordCount);
+            CHECK_EQUAL((u32)stride, view.m_recordSize);
+            CHECK_EQUAL((u64)100000, nkalman::record(view, 2).m_timestamp);
+            CHECK_EQUAL(7, (s32)nkalman::record(view, 2).m_sensorId);
+
+            nkalman::target_t decoded[nkalman::MAX_TARGETS];
+            CHECK_EQUAL(1, nkalman::decode(nkalman::record(view, 1), decoded));
+            CHECK_EQUAL(2.0f, decoded[0].m_distance);
+        }
+
+        UNITTEST_TEST(rd03d_log_record_map_replay)
+        {
+            const char* path = "test_rd03d_log.rdlog";
+
+            // Record 4 interleaved sensors and track them live at the same time
+            const s32        sensors = 4;
+            const s32        frames  = 500;
+            nkalman::rd03d_t live[sensors];
+            for (s32 s = 0; s < sensors; ++s)
+                nkalman::setup(live[s]);
+
+            static nkalman::log_recorder_t rec;
+            CHECK_TRUE(nkalman::open(rec, path));
+            for (s32 f = 0; f < frames; ++f)
+            {
+                for (s32 s = 0; s < sensors; ++s)
+                {
+                    nkalman::target_t targets[nkalman::MAX_TARGETS];
+                    const s32         count = make_targets(s, f, targets);
+                    CHECK_TRUE(nkalman::record(rec, frame_time(f), (u16)s, targets, count));
+                    if (f != 0)
+                        nkalman::processFrame(live[s], targets, count, frame_time(f));
+                    else
+                        nkalman::processFrame(live[s], targets, count);
+                }
+            }
+            CHECK_TRUE(nkalman::close(rec));
+
+            nkalman::log_file_t file;
+            CHECK_TRUE(nkalman::map(file, path));
+            CHECK_EQUAL((u64)(sizeof(nkalman::log_header_t) + sensors * frames * sizeof(nkalman::log_record_t)), file.m_size);
+
+            nkalman::log_view_t view;
+            CHECK_TRUE(nkalman::open(view, file.m_data, file.m_size));
+            CHECK_EQUAL((u64)(sensors * frames), view.m_recordCount);
+            CHECK_EQUAL(frame_time(frames - 1), nkalman::record(view, view.m_recordCount - 1).m_timestamp);
+
+            // Single sensor replay reproduces the live tracks exactly
+            nkalman::rd03d_t replayed;
+            nkalman::setup(replayed);
+            const nkalman::replay_stats_t stats = nkalman::replay(view, replayed, 2);
+            CHECK_EQUAL((u64)frames, stats.m_frames);
+            check_same_tracks(live[2], replayed);
+
+            // Sharded replay on 3 threads reproduces all of them
+            nkalman::rd03d_t sharded[sensors];
+            for (s32 s = 0; s < sensors; ++s)
+                nkalman::setup(sharded[s]);
+            const nkalman::replay_stats_t all = nkalman::replay(view, sharded, sensors, 3);
+            CHECK_EQUAL((u64)(sensors * frames), all.m_frames);
+            for (s32 s = 0; s < sensors; ++s)
+                check_same_tracks(live[s], sharded[s]);
+
+            nkalman::unmap(file);
+            remove(path);
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,273 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_parser.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    void put_field(u8* out, s32 v)
+    {
+        const u32 raw = (v >= 0) ? (0x8000u | (u32)v) : (u32)(-v);
+        out[0]        = (u8)(raw & 0xFF);
+        out[1]        = (u8)(raw >> 8);
+    }
+
+    // One 30 byte report frame, x/y in mm and speed in cm/s per target, a target with x = y = 0 is absent
+    void make_frame(u8* out, const s32 x[3], const s32 y[3], const s32 speed[3])
+    {
+        out[0] = 0xAA;
+        out[1] = 0xFF;
+        out[2] = 0x03;
+        out[3] = 0x00;
+        for (s32 i = 0; i < 3; ++i)
+        {
+            u8* t = out + 4 + i * 8;
+            if (x[i] == 0 && y[i] == 0)
+            {
+                for (s32 b = 0; b < 8; ++b)
+                    t[b] = 0;
+                continue;
+            }
+            put_field(t, x[i]);
+            put_field(t + 2, y[i]);
+            put_field(t + 4, speed[i]);
+            put_field(t + 6, 360);
+        }
+        out[28] = 0x55;
+        out[29] = 0xCC;
+    }
+
+    // Copies 'count' bytes into the ring at free-running position 'write'
+    void ring_write(u8* ring, u32 capacity, u32 write, const u8* data, u32 count)
+    {
+        for (u32 i = 0; i < count; ++i)
+            ring[(write + i) & (capacity - 1)] = data[i];
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(rd03d_parser)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(rd03d_parser_decodes_frame)
+        {
+            u8        ring[64];
+            const s32 x[3]     = {-782, 1000, 0};
+            const s32 y[3]     = {1713, 1000, 0};
+            const s32 speed[3] = {-16, 35, 0};
+            make_frame(ring, x, y, speed);
+
+            nkalman::rd03d_parser_t p;
+            nkalman::setup(p, ring, 64);
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            CHECK_TRUE(nkalman::next(p, 30, targets));
+            CHECK_EQUAL(30u, p.m_read);
+            CHECK_EQUAL(1u, p.m_frames);
+
+            CHECK_EQUAL(1, targets[0].m_id);
+            CHECK_TRUE(targets[0].m_detected);
+            CHECK_CLOSE(sqrtf(0.782f * 0.782f + 1.713f * 1.713f), targets[0].m_distance, 0.0001f);
+            CHECK_CLOSE(atan2f(-0.782f, 1.713f) * (180.0f / 3.14159265f), targets[0].m_angle, 0.001f);
+            CHECK_CLOSE(-0.16f, targets[0].m_speed, 0.0001f);
+
+            CHECK_EQUAL(2, targets[1].m_id);
+            CHECK_TRUE(targets[1].m_detected);
+            CHECK_CLOSE(45.0f, targets[1].m_angle, 0.001f);
+            CHECK_CLOSE(0.35f, targets[1].m_speed, 0.0001f);
+
+            CHECK_EQUAL(3, targets[2].m_id);
+            CHECK_FALSE(targets[2].m_detected);
+
+            CHECK_FALSE(nkalman::next(p, 30, targets));
+        }
+
+        UNITTEST_TEST(rd03d_parser_resynchronizes)
+        {
+            u8        ring[128];
+            u8        frame[30];
+            const s32 x[3]     = {100, 0, 0};
+            const s32 y[3]     = {2000, 0, 0};
+            const s32 speed[3] = {0, 0, 0};
+            make_frame(frame, x, y, speed);
+
+            // garbage, a header with a broken footer, then a valid frame
+            u32      w          = 0;
+            const u8 garbage[5] = {0x12, 0xAA, 0xFF, 0x55, 0xCC};
+            ring_write(ring, 128, w, garbage, 5);
+            w += 5;
+            ring_write(ring, 128, w, frame, 30);
+            ring[(w + 29) & 127] = 0x00;
+            w += 30;
+            ring_write(ring, 128, w, frame, 30);
+            w += 30;
+
+            nkalman::rd03d_parser_t p;
+            nkalman::setup(p, ring, 128);
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            CHECK_TRUE(nkalman::next(p, w, targets));
+            CHECK_EQUAL(35u, p.m_skipped);
+            CHECK_EQUAL(w, p.m_read);
+            CHECK_CLOSE(2.0025f, targets[0].m_distance, 0.0001f);
+        }
+
+        UNITTEST_TEST(rd03d_parser_partial_frame_and_wrap_around)
+        {
+            u8        ring[32];
+            u8        frame[30];
+            const s32 x[3]     = {-500, 0, 300};
+            const s32 y[3]     = {1500, 0, 800};
+            const s32 speed[3] = {10, 0, -20};
+            make_frame(frame, x, y, speed);
+
+            // Start close to the end of the ring and close to the u32 wrap so the frame straddles both
+            const u32               start = 0xFFFFFFF0u;
+            nkalman::rd03d_parser_t p;
+            nkalman::setup(p, ring, 32, start);
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            ring_write(ring, 32, start, frame, 20);
+            CHECK_FALSE(nkalman::next(p, start + 20, targets));
+            CHECK_EQUAL(start, p.m_read);
+
+            ring_write(ring, 32, start + 20, frame + 20, 10);
+            CHECK_TRUE(nkalman::next(p, start + 30, targets));
+            CHECK_EQUAL(start + 30, p.m_read);
+            CHECK_EQUAL(0u, p.m_skipped);
+            CHECK_TRUE(targets[0].m_detected);
+            CHECK_FALSE(targets[1].m_detected);
+            CHECK_TRUE(targets[2].m_detected);
+            CHECK_CLOSE(-0.2f, targets[2].m_speed, 0.0001f);
+        }
+
+        UNITTEST_TEST(rd03d_parser_feeds_tracker)
+        {
+            u8                      ring[256];
+            nkalman::rd03d_parser_t p;
+            nkalman::setup(p, ring, 256);
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+
+            u32 w = 0;
+            for (s32 frame = 0; frame < 40; ++frame)
+            {
+                u8        bytes[30];
+                const s32 x[3]     = {-1000 + 50 * frame, 0, 0};
+                const s32 y[3]     = {2000, 0, 0};
+                const s32 speed[3] = {0, 0, 0};
+                make_frame(bytes, x, y, speed);
+                ring_write(ring, 256, w, bytes, 30);
+                w += 30;
+                CHECK_EQUAL(1, nkalman::parse(p, w, rd));
+            }
+            CHECK_TRUE(rd.m_targetActive[0]);
+            CHECK_FALSE(rd.m_targetActive[1]);
+            CHECK_CLOSE(-1.0f + 0.05f * 39, rd.m_roomFilters[0].x.data[0][0], 0.05f);
+            CHECK_CLOSE(1.0f, rd.m_roomFilters[0].x.data[2][0], 0.15f);
+        }
+
+        UNITTEST_TEST(rd03d_parser_fuzz_stream)
+        {
+            // ~4 MB of valid frames mixed with garbage, pushed through a small ring in random chunks
+            const s32 frameCount = 120000;
+            static u8 stream[frameCount * 41];
+            u32       size = 0;
+
+            ntest::random_t rnd    = {12345};
+            s64             sumX   = 0;
+            s32             frames = 0;
+            for (s32 f = 0; f < frameCount; ++f)
+            {
+                const u32 junk = rnd.bits() % 12;
+                for (u32 j = 0; j < junk; ++j)
+                {
+                    u8 b = (u8)rnd.bits();
+                    if (b == 0xAA)
+                        b = 0;  // garbage never starts a header, so every valid frame is found
+                    stream[size++] = b;
+                }
+
+                // Occasionally a truncated frame, which must be skipped
+                const bool truncated = (rnd.bits() % 16) == 0;
+                u8         bytes[30];
+                s32        x[3], y[3], speed[3];
+                for (s32 i = 0; i < 3; ++i)
+                {
+                    x[i]     = (s32)(rnd.bits() % 8000) - 4000;
+                    y[i]     = (s32)(rnd.bits() % 8000) + 1;
+                    speed[i] = (s32)(rnd.bits() % 400) - 200;
+                }
+                make_frame(bytes, x, y, speed);
+                if (truncated)
+                {
+                    for (s32 b = 0; b < 17; ++b)
+                        stream[size++] = bytes[b];
+                    continue;
+                }
+                for (s32 b = 0; b < 30; ++b)
+                    stream[size++] = bytes[b];
+                sumX += x[0] + x[1] + x[2];
+                ++frames;
+            }
+
+            u8                      ring[512];
+            nkalman::rd03d_parser_t p;
+            nkalman::setup(p, ring, 512);
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            s32               decoded    = 0;
+            f64               decodedSum = 0.0;
+            u32               w          = 0;
+            while (w < size)
+            {
+                u32 chunk = 1 + rnd.bits() % 200;
+                if (chunk > size - w)
+                    chunk = size - w;
+                if (chunk > 512 - (w - p.m_read))
+                    chunk = 512 - (w - p.m_read);
+                ring_write(ring, 512, w, &stream[w], chunk);
+                w += chunk;
+                while (nkalman::next(p, w, targets))
+                {
+                    ++decoded;
+                    for (s32 i = 0; i < 3; ++i)
+                        decodedSum += targets[i].m_distance * sinf(targets[i].m_angle * (3.14159265f / 180.0f)) * 1000.0f;
+                }
+            }
+
+            CHECK_EQUAL(frames, decoded);
+            CHECK_EQUAL((u32)frames, p.m_frames);
+            CHECK_CLOSE((f64)sumX, decodedSum, 0.01 * frames);
+            CHECK_TRUE((w - p.m_read) < 30u);
+
+            // Pure noise must never produce a frame
+            nkalman::setup(p, ring, 512);
+            w = 0;
+            for (s32 i = 0; i < (1 << 20); i += 256)
+            {
+                for (s32 b = 0; b < 256; ++b)
+                {
+                    u8 v = (u8)rnd.bits();
+                    if (v == 0xCC)
+                        v = 0;
+                    ring[(w + b) & 511] = v;
+                }
+                w += 256;
+                CHECK_FALSE(nkalman::next(p, w, targets));
+            }
+            CHECK_EQUAL(0u, p.m_frames);
+            CHECK_EQUAL(w - 29, p.m_read);
+        }
+    }
+}
+UNITTEST_SUITE_END
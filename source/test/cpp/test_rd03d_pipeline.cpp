@@ -0,0 +1,231 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_pipeline.h"
+
+#include "cunittest/cunittest.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using namespace ncore;
+
+namespace
+{
+    enum
+    {
+        STRESS_FRAMES  = 20000,
+        STRESS_READERS = 3
+    };
+
+    // Frame 'frame': one target walking back and forth, a second one appearing every other second
+    s32 make_targets(s32 frame, nkalman::target_t targets[nkalman::MAX_TARGETS])
+    {
+        const f32 x = -1.0f + 0.05f * (f32)(frame % 60);
+        const f32 y = 2.0f;
+
+        targets[0].m_id       = 1;
+        targets[0].m_detected = true;
+        targets[0].m_distance = sqrtf(x * x + y * y);
+        targets[0].m_angle    = atan2f(x, y) * (180.0f / 3.14159265f);
+        targets[0].m_speed    = 0.5f;
+
+        targets[1].m_id       = 2;
+        targets[1].m_detected = ((frame / 20) & 1) != 0;
+        targets[1].m_distance = 3.0f;
+        targets[1].m_angle    = -20.0f + (f32)(frame % 400) * 0.1f;
+        targets[1].m_speed    = -0.25f;
+        return 2;
+    }
+
+    // Every field of the state written by the snapshot stress test equals 'k'
+    void make_state(u64 k, nkalman::rd03d_state_t& state)
+    {
+        state.m_frame     = k;
+        state.m_timestamp = k * 3;
+        for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+        {
+            state.m_tracks[t].m_active = (k & 1) != 0;
+            state.m_tracks[t].m_x      = (f32)k;
+            state.m_tracks[t].m_y      = (f32)k;
+            state.m_tracks[t].m_vx     = (f32)k;
+            state.m_tracks[t].m_vy     = (f32)k;
+        }
+    }
+
+    bool is_consistent(const nkalman::rd03d_state_t& state)
+    {
+        const f32 k = (f32)state.m_frame;
+        if (state.m_timestamp != state.m_frame * 3)
+            return false;
+        for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+        {
+            const nkalman::rd03d_track_state_t& track = state.m_tracks[t];
+            if (track.m_active != ((state.m_frame & 1) != 0) || track.m_x != k || track.m_y != k || track.m_vx != k || track.m_vy != k)
+                return false;
+        }
+        return true;
+    }
+
+    nkalman::rd03d_pipeline_t s_pipeline;
+    nkalman::rd03d_snapshot_t s_snapshot;
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(rd03d_pipeline)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(pipeline_queue_order_and_capacity)
+        {
+            nkalman::rd03d_frame_queue_t& q = s_pipeline.m_queue;
+            nkalman::setup(q);
+
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            for (s32 i = 0; i < nkalman::RD03D_QUEUE_FRAMES; ++i)
+            {
+                const s32 count = make_targets(i, targets);
+                CHECK_TRUE(nkalman::push(q, targets, count, 1000 + i));
+            }
+            CHECK_FALSE(nkalman::push(q, targets, 2, 0));
+            CHECK_EQUAL(1u, q.m_rejected.load());
+
+            nkalman::rd03d_frame_t frame;
+            for (s32 i = 0; i < nkalman::RD03D_QUEUE_FRAMES; ++i)
+            {
+                CHECK_TRUE(nkalman::pop(q, frame));
+                CHECK_EQUAL((u64)(1000 + i), frame.m_timestamp);
+                CHECK_EQUAL(2, frame.m_count);
+            }
+            CHECK_FALSE(nkalman::pop(q, frame));
+
+            // Positions wrap around the ring
+            CHECK_TRUE(nkalman::push(q, targets, 1, 5));
+            CHECK_TRUE(nkalman::pop(q, frame));
+            CHECK_EQUAL(1, frame.m_count);
+        }
+
+        UNITTEST_TEST(pipeline_snapshot_never_torn)
+        {
+            nkalman::setup(s_snapshot);
+
+            std::atomic<bool> done(false);
+            std::atomic<u32>  torn(0);
+            std::atomic<u32>  backwards(0);
+            std::atomic<u32>  reads(0);
+            std::thread       readers[STRESS_READERS];
+            for (s32 r = 0; r < STRESS_READERS; ++r)
+            {
+                readers[r] = std::thread([&]() {
+                    u64 last = 0;
+                    u32 n    = 0;
+                    do  // at least one read, even when the writer is done before this thread runs
+                    {
+                        nkalman::rd03d_state_t state;
+                        nkalman::read(s_snapshot, state);
+                        if (!is_consistent(state))
+                            torn.fetch_add(1);
+                        if (state.m_frame < last)
+                            backwards.fetch_add(1);
+                        last = state.m_frame;
+                        ++n;
+                    } while (!done.load(std::memory_order_acquire));
+                    reads.fetch_add(n);
+                });
+            }
+
+            nkalman::rd03d_state_t state;
+            for (u64 k = 1; k <= 200000; ++k)
+            {
+                make_state(k, state);
+                nkalman::publish(s_snapshot, state);
+            }
+            done.store(true, std::memory_order_release);
+            for (s32 r = 0; r < STRESS_READERS; ++r)
+                readers[r].join();
+
+            CHECK_EQUAL(0u, torn.load());
+            CHECK_EQUAL(0u, backwards.load());
+            CHECK_TRUE(reads.load() > 0);
+            nkalman::read(s_snapshot, state);
+            CHECK_EQUAL((u64)200000, state.m_frame);
+        }
+
+        UNITTEST_TEST(pipeline_matches_serial_processing)
+        {
+            nkalman::setup(s_pipeline);
+
+            // Ingest thread: every frame is delivered, a full queue is retried
+            std::thread ingest([]() {
+                nkalman::target_t targets[nkalman::MAX_TARGETS];
+                for (s32 i = 0; i < STRESS_FRAMES; ++i)
+                {
+                    const s32 count = make_targets(i, targets);
+                    while (!nkalman::push(s_pipeline, targets, count))
+                        std::this_thread::yield();
+                }
+            });
+
+            // Readers poll the published state while the filter runs
+            std::atomic<bool> done(false);
+            std::atomic<u32>  backwards(0);
+            std::thread       readers[STRESS_READERS];
+            for (s32 r = 0; r < STRESS_READERS; ++r)
+            {
+                readers[r] = std::thread([&]() {
+                    u64 last = 0;
+                    while (!done.load(std::memory_order_acquire))
+                    {
+                        nkalman::rd03d_state_t state;
+                        nkalman::read(s_pipeline, state);
+                        if (state.m_frame < last)
+                            backwards.fetch_add(1);
+                        last = state.m_frame;
+                    }
+                });
+            }
+
+            // Filter thread (this one)
+            u64 processed = 0;
+            while (processed < STRESS_FRAMES)
+            {
+                const s32 n = nkalman::process(s_pipeline);
+                processed += (u64)n;
+                if (n == 0)
+                    std::this_thread::yield();
+            }
+            done.store(true, std::memory_order_release);
+            ingest.join();
+            for (s32 r = 0; r < STRESS_READERS; ++r)
+                readers[r].join();
+
+            CHECK_EQUAL(0u, backwards.load());
+
+            // Same result as running the frames serially
+            nkalman::rd03d_t rd;
+            nkalman::setup(rd);
+            nkalman::target_t targets[nkalman::MAX_TARGETS];
+            for (s32 i = 0; i < STRESS_FRAMES; ++i)
+            {
+                const s32 count = make_targets(i, targets);
+                nkalman::processFrame(rd, targets, count);
+            }
+
+            nkalman::rd03d_state_t state;
+            nkalman::read(s_pipeline, state);
+            CHECK_EQUAL((u64)STRESS_FRAMES, state.m_frame);
+            for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+            {
+                CHECK_EQUAL(rd.m_targetActive[t], state.m_tracks[t].m_active);
+                CHECK_EQUAL(rd.m_roomFilters[t].x.data[0][0], state.m_tracks[t].m_x);
+                CHECK_EQUAL(rd.m_roomFilters[t].x.data[1][0], state.m_tracks[t].m_y);
+                CHECK_EQUAL(rd.m_roomFilters[t].x.data[2][0], state.m_tracks[t].m_vx);
+                CHECK_EQUAL(rd.m_roomFilters[t].x.data[3][0], state.m_tracks[t].m_vy);
+            }
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,232 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_rd03d_zones.h"
+
+#include "cunittest/cunittest.h"
+#include "test_random.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    typedef nkalman::zone_map_t<256> zones_t;
+
+    zones_t               s_zones;
+    nkalman::zone_state_t s_state;
+    nkalman::rd03d_t      s_rd;
+    ntest::random_t       s_random = {1};
+
+    // Track 't' of s_rd at (x, y) with P = variance * I
+    void set_track(s32 t, f32 x, f32 y, f32 variance)
+    {
+        nkalman::rd03d_filter_t& kf = s_rd.m_roomFilters[t];
+        s_rd.m_targetActive[t]      = true;
+        kf.x.data[0][0]             = x;
+        kf.x.data[1][0]             = y;
+        kf.P.clear();
+        for (s32 i = 0; i < nkalman::STATE_DIM; ++i)
+            kf.P.data[i][i] = variance;
+    }
+
+    // Reference inside test in double precision, every zone tested
+    bool contains(const zones_t& map, s32 z, f32 px, f32 py)
+    {
+        if (map.m_count[z] == 0)
+            return px > map.m_minX[z] && px < map.m_maxX[z] && py > map.m_minY[z] && py < map.m_maxY[z];
+        bool      inside = false;
+        const s32 first  = map.m_first[z];
+        const s32 n      = map.m_count[z];
+        for (s32 i = 0, j = n - 1; i < n; j = i++)
+        {
+            const f64 xi = map.m_vx[first + i], yi = map.m_vy[first + i];
+            const f64 xj = map.m_vx[first + j], yj = map.m_vy[first + j];
+            if ((yi > py) != (yj > py) && (f64)px < xj + (py - yj) * (xi - xj) / (yi - yj))
+                inside = !inside;
+        }
+        return inside;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(rd03d_zones)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(zones_enter_leave_with_covariance_hysteresis)
+        {
+            nkalman::initialize(s_zones);
+            CHECK_TRUE(nkalman::addRectangle(s_zones, 7, 1.0f, 2.0f, 3.0f, 3.0f, 0.1f));  // desk
+            CHECK_TRUE(nkalman::compile(s_zones));
+            nkalman::initialize(s_state);
+            nkalman::setup(s_rd);
+
+            // Walking along the desk with sigma 0.1 m: the band is 0.1 + 0.1 m on either side of the edges
+            nkalman::zone_event_t events[8];
+            f32                   enteredAt = 0.0f, leftAt = 0.0f;
+            s32                   enters = 0, leaves = 0;
+            for (s32 i = 0; i <= 400; ++i)
+            {
+                const f32 x = (f32)i * 0.01f;
+                set_track(1, x, 2.5f, 0.01f);
+                const s32 n = nkalman::update(s_zones, s_state, s_rd, events, 8);
+                for (s32 e = 0; e < n; ++e)
+                {
+                    CHECK_EQUAL(7u, events[e].m_zone);
+                    CHECK_EQUAL(1, events[e].m_track);
+                    enteredAt = (events[e].m_type == nkalman::ZONE_ENTER) ? x : enteredAt;
+                    leftAt    = (events[e].m_type == nkalman::ZONE_LEAVE) ? x : leftAt;
+                    enters += (events[e].m_type == nkalman::ZONE_ENTER) ? 1 : 0;
+                    leaves += (events[e].m_type == nkalman::ZONE_LEAVE) ? 1 : 0;
+                }
+            }
+            CHECK_EQUAL(1, enters);
+            CHECK_EQUAL(1, leaves);
+            CHECK_CLOSE(1.21f, enteredAt, 0.015f);
+            CHECK_CLOSE(3.21f, leftAt, 0.015f);
+
+            // Jitter of +-0.15 m on the edge does not toggle the zone, in either state
+            for (s32 i = 0; i < 100; ++i)
+            {
+                set_track(1, 1.0f + ((i & 1) ? 0.15f : -0.15f), 2.5f, 0.01f);
+                CHECK_EQUAL(0, nkalman::update(s_zones, s_state, s_rd, events, 8));
+            }
+            set_track(1, 2.0f, 2.5f, 0.01f);
+            CHECK_EQUAL(1, nkalman::update(s_zones, s_state, s_rd, events, 8));
+            for (s32 i = 0; i < 100; ++i)
+            {
+                set_track(1, 3.0f + ((i & 1) ? 0.15f : -0.15f), 2.5f, 0.01f);
+                CHECK_EQUAL(0, nkalman::update(s_zones, s_state, s_rd, events, 8));
+            }
+            CHECK_TRUE(nkalman::isInside(s_zones, s_state, 1, 7));
+
+            // An uncertain track (sigma 1 m) in the middle of the 1 m deep desk does not enter
+            set_track(2, 2.0f, 2.5f, 1.0f);
+            CHECK_EQUAL(0, nkalman::update(s_zones, s_state, s_rd, events, 8));
+            CHECK_FALSE(nkalman::isInside(s_zones, s_state, 2, 7));
+        }
+
+        UNITTEST_TEST(zones_grid_matches_testing_every_zone)
+        {
+            // 200 rectangles, triangles and concave stars over 16 x 8 m, no hysteresis: a track is inside
+            // exactly the zones that contain its position
+            nkalman::initialize(s_zones, 0.0f);
+            s_random.m_state = 99;
+            for (s32 z = 0; z < 200; ++z)
+            {
+                const f32 cx = s_random.uniform(-8.0f, 8.0f), cy = s_random.uniform(0.0f, 8.0f), r = s_random.uniform(0.2f, 0.8f);
+                if ((z % 3) == 0)
+                {
+                    CHECK_TRUE(nkalman::addRectangle(s_zones, 100 + z, cx - r, cy - 0.5f * r, cx + r, cy + 0.5f * r, 0.0f));
+                    continue;
+                }
+                f32       x[10], y[10];
+                const s32 n = ((z % 3) == 1) ? 3 : 10;
+                for (s32 v = 0; v < n; ++v)
+                {
+                    const f32 a  = 6.28318531f * (f32)v / (f32)n;
+                    const f32 rv = (n == 10 && (v & 1)) ? 0.4f * r : r;
+                    x[v]         = cx + rv * cosf(a);
+                    y[v]         = cy + rv * sinf(a);
+                }
+                CHECK_TRUE(nkalman::addPolygon(s_zones, 100 + z, x, y, n, 0.0f));
+            }
+            CHECK_TRUE(nkalman::compile(s_zones));
+            CHECK_TRUE(s_zones.m_cellsX * s_zones.m_cellsY > 100);
+            nkalman::initialize(s_state);
+            nkalman::setup(s_rd);
+
+            nkalman::zone_event_t events[64];
+            s32                   inside[nkalman::MAX_TARGETS] = {0, 0, 0};
+            s32                   mismatches                   = 0;
+            for (s32 frame = 0; frame < 300; ++frame)
+            {
+                for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+                {
+                    // Small steps and jumps across the room
+                    const f32 x = ((frame % 7) == 0) ? s_random.uniform(-8.5f, 8.5f) : s_rd.m_roomFilters[t].x.data[0][0] + s_random.uniform(-0.3f, 0.3f);
+                    const f32 y = ((frame % 7) == 0) ? s_random.uniform(-0.5f, 8.5f) : s_rd.m_roomFilters[t].x.data[1][0] + s_random.uniform(-0.3f, 0.3f);
+                    set_track(t, x, y, 0.0f);
+                }
+                const s32 n = nkalman::update(s_zones, s_state, s_rd, events, 64);
+                for (s32 e = 0; e < n; ++e)
+                    inside[events[e].m_track] += (events[e].m_type == nkalman::ZONE_ENTER) ? 1 : -1;
+
+                for (s32 t = 0; t < nkalman::MAX_TARGETS; ++t)
+                {
+                    const f32 px = s_rd.m_roomFilters[t].x.data[0][0], py = s_rd.m_roomFilters[t].x.data[1][0];
+                    for (s32 z = 0; z < s_zones.m_zoneCount; ++z)
+                        mismatches += (contains(s_zones, z, px, py) != nkalman::isInside(s_zones, s_state, t, s_zones.m_id[z])) ? 1 : 0;
+                    CHECK_EQUAL(s_state.m_insideCount[t], inside[t]);
+                }
+            }
+            CHECK_EQUAL(0, mismatches);
+        }
+
+        UNITTEST_TEST(zones_dropped_track_and_event_limit)
+        {
+            nkalman::initialize(s_zones);
+            const f32 x[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+            const f32 y[4] = {1.0f, 1.0f, 3.0f, 3.0f};
+            CHECK_TRUE(nkalman::addRectangle(s_zones, 1, -2.0f, 0.0f, 2.0f, 4.0f));
+            CHECK_TRUE(nkalman::addPolygon(s_zones, 2, x, y, 4));
+            CHECK_TRUE(nkalman::addRectangle(s_zones, 3, -1.5f, 1.5f, 0.5f, 2.5f));
+            CHECK_FALSE(nkalman::addPolygon(s_zones, 4, x, y, 2));
+            CHECK_TRUE(nkalman::compile(s_zones));
+            nkalman::initialize(s_state);
+            nkalman::setup(s_rd);
+
+            // Inside all three, two events fit: the third enter follows with the next update
+            nkalman::zone_event_t events[4];
+            set_track(0, 0.0f, 2.0f, 0.01f);
+            CHECK_EQUAL(2, nkalman::update(s_zones, s_state, s_rd, events, 2));
+            CHECK_EQUAL(1u, events[0].m_zone);
+            CHECK_EQUAL(2u, events[1].m_zone);
+            CHECK_EQUAL(1, nkalman::update(s_zones, s_state, s_rd, events, 2));
+            CHECK_EQUAL(3u, events[0].m_zone);
+            CHECK_EQUAL(0, nkalman::update(s_zones, s_state, s_rd, events, 2));
+
+            // The track is dropped: it leaves every zone
+            s_rd.m_targetActive[0] = false;
+            CHECK_EQUAL(3, nkalman::update(s_zones, s_state, s_rd, events, 4));
+            for (s32 e = 0; e < 3; ++e)
+            {
+                CHECK_EQUAL(nkalman::ZONE_LEAVE, events[e].m_type);
+                CHECK_EQUAL(0, events[e].m_track);
+            }
+            CHECK_EQUAL(0, s_state.m_insideCount[0]);
+
+            // A track walking through the room with processFrame(): one enter and one leave of the desk
+            nkalman::initialize(s_zones);
+            CHECK_TRUE(nkalman::addRectangle(s_zones, 9, -1.0f, 2.5f, 1.0f, 3.5f));
+            CHECK_TRUE(nkalman::compile(s_zones));
+            nkalman::initialize(s_state);
+            nkalman::setup(s_rd);
+            s32 enters = 0, leaves = 0;
+            for (s32 frame = 0; frame < 200; ++frame)
+            {
+                const f32         px = -3.0f + 0.03f * (f32)frame, py = 3.0f;
+                nkalman::target_t target;
+                target.m_id       = 1;
+                target.m_detected = true;
+                target.m_distance = sqrtf(px * px + py * py);
+                target.m_angle    = atan2f(px, py) * 57.2957795f;
+                target.m_speed    = 0.0f;
+                nkalman::processFrame(s_rd, &target, 1);
+                const s32 n = nkalman::update(s_zones, s_state, s_rd, events, 4);
+                for (s32 e = 0; e < n; ++e)
+                {
+                    enters += (events[e].m_type == nkalman::ZONE_ENTER) ? 1 : 0;
+                    leaves += (events[e].m_type == nkalman::ZONE_LEAVE) ? 1 : 0;
+                }
+            }
+            CHECK_EQUAL(1, enters);
+            CHECK_EQUAL(1, leaves);
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,125 @@
+#include "ccore/c_allocator.h"
+#include "ccore/c_math.h"
+#include "ccore/c_printf.h"
+#include "ccore/c_random.h"
+
+#include "ckalman/c_rd03d.h"
+#include "ckalman/c_sincos.h"
+
+#include "cunittest/cunittest.h"
+
+#include <cmath>
+
+using namespace ncore;
+
+namespace
+{
+    enum
+    {
+        SWEEP = 4096
+    };
+
+    f32 s_angle[SWEEP];
+    f32 s_distance[SWEEP];
+    f32 s_x[SWEEP];
+    f32 s_y[SWEEP];
+
+#if defined(CKALMAN_SINCOS_LUT)
+    const f32 POLAR_TOLERANCE = 3e-4f;  // 3.8e-5 of the lookup table times the largest distance
+#else
+    const f32 POLAR_TOLERANCE = 2e-6f;
+#endif
+
+    f64 radians(f32 degrees) { return (f64)degrees * (3.14159265358979323846 / 180.0); }
+
+    // Largest error of x = sin(angle) and y = cos(angle) (unit distances) against double precision
+    f64 max_error(const f32 angle[], const f32 x[], const f32 y[], s32 count)
+    {
+        f64 worst = 0.0;
+        for (s32 i = 0; i < count; ++i)
+        {
+            const f64 es = fabs((f64)x[i] - sin(radians(angle[i])));
+            const f64 ec = fabs((f64)y[i] - cos(radians(angle[i])));
+            worst        = (es > worst) ? es : worst;
+            worst        = (ec > worst) ? ec : worst;
+        }
+        return worst;
+    }
+}  // namespace
+
+UNITTEST_SUITE_BEGIN(sincos)
+{
+    UNITTEST_FIXTURE(tests)
+    {
+        UNITTEST_TEST(sincos_polynomial_error_bound)
+        {
+            // -10000..10000 degrees in blocks of SWEEP angles, plus the quadrant boundaries exactly
+            f64 worst = 0.0;
+            for (s32 block = 0; block < 50; ++block)
+            {
+                for (s32 i = 0; i < SWEEP; ++i)
+                {
+                    s_angle[i]    = -10000.0f + 20000.0f * (f32)(block * SWEEP + i) / (f32)(50 * SWEEP);
+                    s_distance[i] = 1.0f;
+                }
+                nkalman::polarToCartesianPoly(s_distance, s_angle, SWEEP, s_x, s_y);
+                const f64 e = max_error(s_angle, s_x, s_y, SWEEP);
+                worst       = (e > worst) ? e : worst;
+            }
+            for (s32 i = 0; i < 64; ++i)
+            {
+                s_angle[i]    = -1440.0f + 45.0f * (f32)i;
+                s_distance[i] = 1.0f;
+            }
+            nkalman::polarToCartesianPoly(s_distance, s_angle, 61, s_x, s_y);  // 61: vector and scalar remainder
+            const f64 e = max_error(s_angle, s_x, s_y, 61);
+            worst       = (e > worst) ? e : worst;
+            CHECK_TRUE(worst < 1e-7);
+
+            // Exact at the axes
+            f32 s, c;
+            nkalman::nsincos::sincos<nkalman::nsimd::f32x1_t>(90.0f, s, c);
+            CHECK_EQUAL(1.0f, s);
+            CHECK_TRUE(fabsf(c) < 1e-7f);
+            nkalman::nsincos::sincos<nkalman::nsimd::f32x1_t>(-180.0f, s, c);
+            CHECK_EQUAL(-1.0f, c);
+        }
+
+        UNITTEST_TEST(sincos_lookup_table_error_bound)
+        {
+            f64 worst = 0.0;
+            for (s32 i = 0; i < 200000; ++i)
+            {
+                const f32 degrees = -1000.0f + 0.01f * (f32)i;
+                f32       s, c;
+                nkalman::nsincos::sincosLut(degrees, s, c);
+                const f64 es = fabs((f64)s - sin(radians(degrees)));
+                const f64 ec = fabs((f64)c - cos(radians(degrees)));
+                worst        = (es > worst) ? es : worst;
+                worst        = (ec > worst) ? ec : worst;
+            }
+            CHECK_TRUE(worst < 3.9e-5);
+        }
+
+        UNITTEST_TEST(sincos_targets_to_positions)
+        {
+            nkalman::target_t targets[5];
+            for (s32 i = 0; i < 5; ++i)
+            {
+                targets[i].m_id       = (u8)(i + 1);
+                targets[i].m_detected = true;
+                targets[i].m_distance = 0.5f + 1.5f * (f32)i;
+                targets[i].m_angle    = -60.0f + 27.5f * (f32)i;
+                targets[i].m_speed    = 0.0f;
+            }
+            f32 x[5], y[5];
+            nkalman::polarToCartesian(targets, 5, x, y);
+            for (s32 i = 0; i < 5; ++i)
+            {
+                CHECK_CLOSE(targets[i].m_distance * sin(radians(targets[i].m_angle)), x[i], POLAR_TOLERANCE);
+                CHECK_CLOSE(targets[i].m_distance * cos(radians(targets[i].m_angle)), y[i], POLAR_TOLERANCE);
+            }
+        }
+    }
+}
+UNITTEST_SUITE_END